@@ -45,6 +45,7 @@ public class IGI : ModuleRules
 			new string[]
 			{
 				// ... add other public dependencies that you statically link with here ...
+				"DeveloperSettings"
 			}
 			);
 			
@@ -57,6 +58,10 @@ public class IGI : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "Projects",
+                "HTTP",
+                "HTTPServer",
+                "Json",
+                "JsonUtilities",
 				"RHI",
                 "D3D12RHI"
             }
@@ -80,6 +85,7 @@ public class IGI : ModuleRules
 
         // GPT feature + dependencies
         RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "nvigi.plugin.gpt.ggml.cuda.dll"));
+        RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "nvigi.plugin.gpt.ggml.cpu.dll"));
         RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "cig_scheduler_settings.dll"));
         RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "cublas64_12.dll"));
         RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "cublasLt64_12.dll"));
@@ -90,6 +96,16 @@ public class IGI : ModuleRules
         RuntimeDependencies.Add(Path.Combine(GPTModelPath, "nemotron-4-mini-4b-instruct_q4_0.gguf"));
         RuntimeDependencies.Add(Path.Combine(GPTModelPath, "nvigi.model.config.json"));
 
+        // Embedding feature and its default model (UIGISettings::EmbedModelGUID)
+        string EmbedModelPath = Path.Combine([PluginDirectory, "ThirdParty", "nvigi_pack", "plugins", "sdk", "data", "nvigi.models", "nvigi.plugin.embed.ggml", "{5D458A64-C62E-4A9C-9086-2ADBF6B241C7}"]);
+        RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "nvigi.plugin.embed.ggml.cuda.dll"));
+        RuntimeDependencies.Add(Path.Combine(PluginsBinaryPath, "nvigi.plugin.embed.ggml.cpu.dll"));
+        RuntimeDependencies.Add(Path.Combine(EmbedModelPath, "*.gguf"));
+        RuntimeDependencies.Add(Path.Combine(EmbedModelPath, "nvigi.model.config.json"));
+
+        // Model variants considered by the startup hardware probe
+        RuntimeDependencies.Add(Path.Combine(PluginDirectory, "Config", "ModelManifest.json"));
+
         AddEngineThirdPartyPrivateStaticDependencies(Target, "DX12");
     }
 }
@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIBackgroundJobs.h"
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeExit.h"
+
+#include "IGIFrameBudget.h"
+#include "IGILog.h"
+#include "IGIModelRegistry.h"
+#include "IGIModule.h"
+#include "IGISettings.h"
+
+#include <atomic>
+
+namespace
+{
+    // How often the worker re-checks for idle capacity while jobs are pending
+    constexpr uint32 IDLE_POLL_MS{ 100 };
+}
+
+class FIGIBackgroundJobs::Impl : public FRunnable
+{
+public:
+    Impl(FIGIModule* IGIModule)
+        : IGIModulePtr(IGIModule)
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        MaxPending = Settings->MaxBackgroundJobs;
+        MaxPreemptions = Settings->MaxBackgroundJobPreemptions;
+
+        WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        Thread = FRunnableThread::Create(this, TEXT("IGIBackgroundJobs"), 0, TPri_Lowest);
+    }
+
+    virtual ~Impl()
+    {
+        bStop = true;
+        WakeEvent->Trigger();
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+        }
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+
+        TArray<FQueuedJob> Dropped;
+        {
+            FScopeLock Lock(&CS);
+            Dropped = MoveTemp(Queue);
+        }
+        CompleteCancelled(Dropped);
+    }
+
+    bool Enqueue(FIGIBackgroundJob&& Job)
+    {
+        TArray<FQueuedJob> Replaced;
+        ON_SCOPE_EXIT
+        {
+            CompleteCancelled(Replaced);
+        };
+
+        {
+            FScopeLock Lock(&CS);
+
+            if (!Job.DedupKey.IsNone())
+            {
+                Replaced = TakeJobs(Job.DedupKey);
+            }
+
+            if (Queue.Num() >= MaxPending)
+            {
+                return false;
+            }
+
+            // Background work is never more urgent than Ambient; it only runs while nothing else does
+            if (Job.Request.Priority < EIGIRequestPriority::Ambient)
+            {
+                Job.Request.Priority = EIGIRequestPriority::Ambient;
+            }
+            Queue.Add({ MoveTemp(Job), 0, FPlatformTime::Seconds() });
+        }
+
+        WakeEvent->Trigger();
+        return true;
+    }
+
+    void Cancel(FName DedupKey)
+    {
+        TArray<FQueuedJob> Cancelled;
+        {
+            FScopeLock Lock(&CS);
+            Cancelled = TakeJobs(DedupKey);
+        }
+        CompleteCancelled(Cancelled);
+    }
+
+    int32 GetNumPending() const
+    {
+        FScopeLock Lock(&CS);
+        return Queue.Num();
+    }
+
+    //~ Begin FRunnable
+    virtual uint32 Run() override
+    {
+        while (!bStop)
+        {
+            WakeEvent->Wait(IDLE_POLL_MS);
+
+            while (!bStop && IGIModulePtr->GetFrameBudget()->IsIdle())
+            {
+                FQueuedJob Queued;
+                {
+                    FScopeLock Lock(&CS);
+                    if (Queue.IsEmpty())
+                    {
+                        break;
+                    }
+                    const int32 Next = PickNext();
+                    Queued = Queue[Next];
+                    Queue.RemoveAt(Next);
+                }
+
+                RunJob(Queued);
+            }
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStop = true;
+        WakeEvent->Trigger();
+    }
+    //~ End FRunnable
+
+private:
+    struct FQueuedJob
+    {
+        FIGIBackgroundJob Job;
+        int32 Preemptions{ 0 };
+        double EnqueueTime{ 0.0 };
+    };
+
+    /** Called under CS */
+    TArray<FQueuedJob> TakeJobs(FName DedupKey)
+    {
+        TArray<FQueuedJob> Taken;
+        for (int32 Index = Queue.Num() - 1; Index >= 0; --Index)
+        {
+            if (Queue[Index].Job.DedupKey == DedupKey)
+            {
+                Taken.Add(MoveTemp(Queue[Index]));
+                Queue.RemoveAt(Index);
+            }
+        }
+        return Taken;
+    }
+
+    /** Called without CS, so a callback may enqueue again */
+    static void CompleteCancelled(TArray<FQueuedJob>& Jobs)
+    {
+        for (FQueuedJob& Queued : Jobs)
+        {
+            Queued.Job.OnComplete.ExecuteIfBound(EIGIBackgroundJobStatus::Cancelled, FString());
+        }
+        Jobs.Reset();
+    }
+
+    /** Most important after aging, oldest first within a class; Ambient lines go before Maintenance */
+    int32 PickNext() const
+    {
+        FIGIFrameBudget* FrameBudget = IGIModulePtr->GetFrameBudget();
+        int32 Best = 0;
+        EIGIRequestPriority BestPriority = FrameBudget->GetAgedPriority(Queue[0].Job.Request.Priority, Queue[0].EnqueueTime);
+        for (int32 Index = 1; Index < Queue.Num(); ++Index)
+        {
+            const EIGIRequestPriority Priority = FrameBudget->GetAgedPriority(Queue[Index].Job.Request.Priority, Queue[Index].EnqueueTime);
+            if (Priority < BestPriority)
+            {
+                Best = Index;
+                BestPriority = Priority;
+            }
+        }
+        return Best;
+    }
+
+    void RunJob(FQueuedJob& Queued)
+    {
+        FIGIBackgroundJob& Job = Queued.Job;
+        Job.Request.bPreemptible = true;
+
+        // Background jobs don't take a tier queue slot; they are cancelled as soon as anything else arrives
+        FIGIModelRegistry* Registry = IGIModulePtr->GetModelRegistry();
+        const int32 PromptLength = Job.Request.SystemPrompt.Len() + Job.Request.UserPrompt.Len() + Job.Request.AssistantPrompt.Len();
+        FIGIGPTPtr GPT = Registry->GetGPT(Registry->SelectTier(Job.Tier, PromptLength));
+        if (!GPT.IsValid() || !GPT->IsValid())
+        {
+            Job.OnComplete.ExecuteIfBound(EIGIBackgroundJobStatus::Failed, FString());
+            return;
+        }
+
+        FIGIGPTTimings Timings;
+        const FString Response = GPT->Evaluate(Job.Request, &Timings);
+
+        if (Timings.bPreempted)
+        {
+            if (++Queued.Preemptions <= MaxPreemptions)
+            {
+                // A job enqueued under the same key while this one ran has replaced it
+                FScopeLock Lock(&CS);
+                const bool bReplaced = !Job.DedupKey.IsNone() && Queue.ContainsByPredicate([&Job](const FQueuedJob& Other) { return Other.Job.DedupKey == Job.DedupKey; });
+                if (!bReplaced)
+                {
+                    Queue.Insert(MoveTemp(Queued), 0);
+                    return;
+                }
+            }
+            else
+            {
+                UE_LOG(LogIGISDK, Verbose, TEXT("IGI: dropping background job %s after %d preemptions"), *Job.DedupKey.ToString(), Queued.Preemptions);
+            }
+            Job.OnComplete.ExecuteIfBound(EIGIBackgroundJobStatus::Cancelled, FString());
+            return;
+        }
+
+        Job.OnComplete.ExecuteIfBound(EIGIBackgroundJobStatus::Completed, Response);
+    }
+
+    // Non-owning ptr
+    FIGIModule* IGIModulePtr;
+
+    mutable FCriticalSection CS;
+    TArray<FQueuedJob> Queue;
+    int32 MaxPending{ 16 };
+    int32 MaxPreemptions{ 3 };
+
+    FEvent* WakeEvent{ nullptr };
+    FRunnableThread* Thread{ nullptr };
+    std::atomic<bool> bStop{ false };
+};
+
+// ----------------------------------
+
+FIGIBackgroundJobs::FIGIBackgroundJobs(FIGIModule* IGIModule)
+{
+    Pimpl = MakePimpl<FIGIBackgroundJobs::Impl>(IGIModule);
+}
+
+FIGIBackgroundJobs::~FIGIBackgroundJobs() {}
+
+bool FIGIBackgroundJobs::Enqueue(FIGIBackgroundJob&& Job)
+{
+    return Pimpl->Enqueue(MoveTemp(Job));
+}
+
+void FIGIBackgroundJobs::Cancel(FName DedupKey)
+{
+    Pimpl->Cancel(DedupKey);
+}
+
+int32 FIGIBackgroundJobs::GetNumPending() const
+{
+    return Pimpl->GetNumPending();
+}
@@ -0,0 +1,489 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIBenchmarkCommandlet.h"
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Interfaces/IPluginManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "IGIGPT.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+#include "IGISettings.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <dxgi1_4.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+namespace
+{
+    /**
+     * This process's dedicated video memory summed over adapters. Under WDDM that includes CUDA
+     * allocations, which FPlatformMemory never sees. Sampled, so a peak between samples is missed.
+     */
+    class FVRAMUsage
+    {
+    public:
+        FVRAMUsage()
+        {
+#if PLATFORM_WINDOWS
+            TRefCountPtr<IDXGIFactory1> Factory;
+            if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(Factory.GetInitReference()))))
+            {
+                return;
+            }
+
+            TRefCountPtr<IDXGIAdapter1> Adapter;
+            for (UINT Index = 0; Factory->EnumAdapters1(Index, Adapter.GetInitReference()) != DXGI_ERROR_NOT_FOUND; ++Index)
+            {
+                TRefCountPtr<IDXGIAdapter3> Adapter3;
+                if (SUCCEEDED(Adapter->QueryInterface(IID_PPV_ARGS(Adapter3.GetInitReference()))))
+                {
+                    Adapters.Add(Adapter3);
+                }
+            }
+#endif
+        }
+
+        bool IsAvailable() const
+        {
+#if PLATFORM_WINDOWS
+            return !Adapters.IsEmpty();
+#else
+            return false;
+#endif
+        }
+
+        /** Current usage in bytes; also raises the peak */
+        uint64 Sample()
+        {
+            uint64 Usage = 0;
+#if PLATFORM_WINDOWS
+            for (const TRefCountPtr<IDXGIAdapter3>& Adapter : Adapters)
+            {
+                DXGI_QUERY_VIDEO_MEMORY_INFO Info{};
+                if (SUCCEEDED(Adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &Info)))
+                {
+                    Usage += Info.CurrentUsage;
+                }
+            }
+#endif
+            Peak = FMath::Max(Peak, Usage);
+            return Usage;
+        }
+
+        uint64 GetPeak() const { return Peak; }
+
+    private:
+#if PLATFORM_WINDOWS
+        TArray<TRefCountPtr<IDXGIAdapter3>> Adapters;
+#endif
+        uint64 Peak{ 0 };
+    };
+
+    struct FBenchmarkCase
+    {
+        FString NPC;
+        FString Question;
+        TArray<double> TimeToFirstTokenMs;
+        TArray<double> LatencyMs;
+        double DecodeMs = 0.0;
+        int64 DecodeTokens = 0;
+        double TermScore = 1.0;
+        double Agreement = 1.0;
+
+        double GetConsistency() const { return 0.5 * (TermScore + Agreement); }
+        double GetTokensPerSecond() const { return DecodeMs > 0.0 ? DecodeTokens * 1000.0 / DecodeMs : 0.0; }
+    };
+
+    // Nearest-rank percentile of an already sorted array
+    double Percentile(const TArray<double>& Sorted, double P)
+    {
+        if (Sorted.IsEmpty())
+        {
+            return 0.0;
+        }
+        const int32 Rank = FMath::Clamp(FMath::CeilToInt(P / 100.0 * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Rank];
+    }
+
+    // Lowercased words of four or more letters; short words are mostly filler and dominate overlap
+    TSet<FString> GetContentWords(const FString& Text)
+    {
+        TSet<FString> Words;
+        FString Word;
+        for (const TCHAR Char : Text + TEXT(" "))
+        {
+            if (FChar::IsAlnum(Char))
+            {
+                Word.AppendChar(FChar::ToLower(Char));
+            }
+            else
+            {
+                if (Word.Len() >= 4)
+                {
+                    Words.Add(Word);
+                }
+                Word.Reset();
+            }
+        }
+        return Words;
+    }
+
+    // Fraction of checks passed: expected terms present, forbidden terms absent
+    double ScoreTerms(const FString& Response, const TArray<FString>& Expected, const TArray<FString>& Forbidden)
+    {
+        const int32 NumChecks = Expected.Num() + Forbidden.Num();
+        if (NumChecks == 0)
+        {
+            return 1.0;
+        }
+
+        int32 NumPassed = 0;
+        for (const FString& Term : Expected)
+        {
+            NumPassed += Response.Contains(Term, ESearchCase::IgnoreCase) ? 1 : 0;
+        }
+        for (const FString& Term : Forbidden)
+        {
+            NumPassed += Response.Contains(Term, ESearchCase::IgnoreCase) ? 0 : 1;
+        }
+        return static_cast<double>(NumPassed) / NumChecks;
+    }
+
+    // Mean pairwise Jaccard similarity of the replies' content words; 1 when they all say the same thing
+    double ScoreAgreement(const TArray<FString>& Responses)
+    {
+        TArray<TSet<FString>> WordSets;
+        for (const FString& Response : Responses)
+        {
+            WordSets.Add(GetContentWords(Response));
+        }
+
+        double Sum = 0.0;
+        int32 NumPairs = 0;
+        for (int32 A = 0; A < WordSets.Num(); ++A)
+        {
+            for (int32 B = A + 1; B < WordSets.Num(); ++B)
+            {
+                const int32 Union = WordSets[A].Union(WordSets[B]).Num();
+                Sum += Union > 0 ? static_cast<double>(WordSets[A].Intersect(WordSets[B]).Num()) / Union : 1.0;
+                ++NumPairs;
+            }
+        }
+        return NumPairs > 0 ? Sum / NumPairs : 1.0;
+    }
+
+    // Higher is worse for latencies and lower is worse for rates and scores
+    bool CheckRegression(const FJsonObject& Summary, const FJsonObject& Baseline, const TCHAR* Field, bool bHigherIsWorse, double MaxRegressionPercent)
+    {
+        double Value = 0.0;
+        double BaselineValue = 0.0;
+        if (!Summary.TryGetNumberField(Field, Value) || !Baseline.TryGetNumberField(Field, BaselineValue) || BaselineValue <= 0.0)
+        {
+            return false;
+        }
+
+        const double ChangePercent = (Value - BaselineValue) / BaselineValue * 100.0;
+        const bool bRegressed = bHigherIsWorse ? ChangePercent > MaxRegressionPercent : -ChangePercent > MaxRegressionPercent;
+        UE_LOG(LogIGISDK, Display, TEXT("  %-20s %10.2f   baseline %10.2f   %+6.1f%%%s"), Field, Value, BaselineValue, ChangePercent, bRegressed ? TEXT("   REGRESSED") : TEXT(""));
+        return bRegressed;
+    }
+}
+
+UIGIBenchmarkCommandlet::UIGIBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UIGIBenchmarkCommandlet::Main(const FString& Params)
+{
+    const UIGISettings* Settings = GetDefault<UIGISettings>();
+
+    FString SuitePath = FPaths::Combine(IPluginManager::Get().FindPlugin("IGI")->GetBaseDir(), TEXT("Config/DialogueBenchmark.json"));
+    FParse::Value(*Params, TEXT("Suite="), SuitePath);
+
+    FString SuiteJson;
+    FIGIBenchmarkSuite Suite;
+    if (!FFileHelper::LoadFileToString(SuiteJson, *SuitePath) || !FJsonObjectConverter::JsonObjectStringToUStruct(SuiteJson, &Suite))
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("Usage: -run=IGIBenchmark [-Suite=<json>] [-Model=<GUID>] [-Backend=CUDA|CPU|Remote|Mock] [-ContextSize=<tokens>] [-Repeats=<n>] [-Output=<json>] [-Baseline=<json>] [-MaxRegression=<percent>]"));
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: unable to read suite %s"), *SuitePath);
+        return 1;
+    }
+
+    FIGIGPTModelDesc Desc;
+    Desc.ModelGUID = Settings->LargeTier.ModelGUID;
+    Desc.Backend = EIGIGPTBackend::CPU;
+    Desc.VRAMBudgetMB = Settings->LargeTier.VRAMBudgetMB;
+    Desc.NumThreads = Settings->LargeTier.NumThreads;
+    Desc.ContextSize = Settings->LargeTier.ContextSize;
+    FParse::Value(*Params, TEXT("Model="), Desc.ModelGUID);
+    FParse::Value(*Params, TEXT("ContextSize="), Desc.ContextSize);
+
+    FString BackendName;
+    if (FParse::Value(*Params, TEXT("Backend="), BackendName))
+    {
+        const int64 Value = StaticEnum<EIGIGPTBackend>()->GetValueByNameString(BackendName);
+        if (Value == INDEX_NONE)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: unknown backend %s"), *BackendName);
+            return 1;
+        }
+        Desc.Backend = static_cast<EIGIGPTBackend>(Value);
+    }
+
+    int32 Repeats = 3;
+    FParse::Value(*Params, TEXT("Repeats="), Repeats);
+    Repeats = FMath::Max(Repeats, 1);
+
+    // Mock never touches nvigi, so it runs on machines without the SDK or model files
+    FIGIModule& IGIModule = FIGIModule::Get();
+    const bool bNeedsCore = Desc.Backend != EIGIGPTBackend::Mock;
+    if (bNeedsCore && !IGIModule.LoadIGICore())
+    {
+        return 1;
+    }
+
+    // Weights and KV live in process RAM on CPU but in VRAM on CUDA, so each backend is measured where its model is
+    const bool bMeasureVRAM = Desc.Backend == EIGIGPTBackend::CUDA;
+    FVRAMUsage VRAM;
+    if (bMeasureVRAM && !VRAM.IsAvailable())
+    {
+        UE_LOG(LogIGISDK, Warning, TEXT("IGI benchmark: video memory usage can't be queried; VRAM is not reported"));
+    }
+
+    const uint64 UsedBeforeLoad = FPlatformMemory::GetStats().UsedPhysical;
+    const uint64 VRAMBeforeLoad = VRAM.Sample();
+    TUniquePtr<FIGIGPT> GPT = MakeUnique<FIGIGPT>(&IGIModule, Desc);
+    if (!GPT->IsValid())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: unable to load %s on %s"), *Desc.ModelGUID, *UEnum::GetValueAsString(Desc.Backend));
+        GPT.Reset();
+        if (bNeedsCore)
+        {
+            IGIModule.UnloadIGICore();
+        }
+        return 1;
+    }
+    const uint64 UsedAfterLoad = FPlatformMemory::GetStats().UsedPhysical;
+    const uint64 VRAMAfterLoad = VRAM.Sample();
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI benchmark: suite '%s' on %s (%s), %d repeats"), *Suite.Name, *Desc.ModelGUID, *UEnum::GetValueAsString(Desc.Backend), Repeats);
+
+    TArray<FBenchmarkCase> Cases;
+    for (const FIGIBenchmarkNPC& NPC : Suite.NPCs)
+    {
+        for (const FIGIBenchmarkQuestion& Question : NPC.Questions)
+        {
+            FBenchmarkCase& Case = Cases.AddDefaulted_GetRef();
+            Case.NPC = NPC.Name;
+            Case.Question = Question.Question;
+
+            TArray<FString> Forbidden = Suite.ForbiddenTerms;
+            Forbidden.Append(Question.ForbiddenTerms);
+
+            TArray<FString> Responses;
+            double TermScoreSum = 0.0;
+            for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+            {
+                // Fixed seeds keep runs comparable; different ones per repeat make agreement meaningful
+                FIGIGPTRequest Request;
+                Request.SystemPrompt = NPC.Persona;
+                Request.UserPrompt = Question.Question;
+                Request.TokensToPredict = Question.TokensToPredict;
+                Request.Sampling.Seed = Repeat + 1;
+
+                const double StartTime = FPlatformTime::Seconds();
+                FIGIGPTTimings Timings;
+                const FString Response = GPT->Evaluate(Request, &Timings);
+                VRAM.Sample();
+
+                Case.TimeToFirstTokenMs.Add(Timings.TimeToFirstTokenMs);
+                Case.LatencyMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+                if (Timings.NumTokens > 1)
+                {
+                    Case.DecodeMs += Timings.TotalMs - Timings.TimeToFirstTokenMs;
+                    Case.DecodeTokens += Timings.NumTokens - 1;
+                }
+
+                TermScoreSum += ScoreTerms(Response, Question.ExpectedTerms, Forbidden);
+                Responses.Add(Response);
+            }
+
+            Case.TermScore = TermScoreSum / Repeats;
+            Case.Agreement = ScoreAgreement(Responses);
+        }
+    }
+
+    GPT.Reset();
+    if (bNeedsCore)
+    {
+        IGIModule.UnloadIGICore();
+    }
+
+    if (Cases.IsEmpty())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: suite %s has no questions"), *SuitePath);
+        return 1;
+    }
+
+    TArray<double> TTFT;
+    TArray<double> Latency;
+    double DecodeMs = 0.0;
+    int64 DecodeTokens = 0;
+    double ConsistencySum = 0.0;
+    TArray<TSharedPtr<FJsonValue>> CaseValues;
+    for (const FBenchmarkCase& Case : Cases)
+    {
+        TTFT.Append(Case.TimeToFirstTokenMs);
+        Latency.Append(Case.LatencyMs);
+        DecodeMs += Case.DecodeMs;
+        DecodeTokens += Case.DecodeTokens;
+        ConsistencySum += Case.GetConsistency();
+
+        TArray<double> CaseLatency = Case.LatencyMs;
+        CaseLatency.Sort();
+        TArray<double> CaseTTFT = Case.TimeToFirstTokenMs;
+        CaseTTFT.Sort();
+
+        const TSharedRef<FJsonObject> CaseObject = MakeShared<FJsonObject>();
+        CaseObject->SetStringField(TEXT("npc"), Case.NPC);
+        CaseObject->SetStringField(TEXT("question"), Case.Question);
+        CaseObject->SetNumberField(TEXT("ttft_p50_ms"), Percentile(CaseTTFT, 50.0));
+        CaseObject->SetNumberField(TEXT("latency_p50_ms"), Percentile(CaseLatency, 50.0));
+        CaseObject->SetNumberField(TEXT("tokens_per_second"), Case.GetTokensPerSecond());
+        CaseObject->SetNumberField(TEXT("term_score"), Case.TermScore);
+        CaseObject->SetNumberField(TEXT("agreement"), Case.Agreement);
+        CaseObject->SetNumberField(TEXT("consistency"), Case.GetConsistency());
+        CaseValues.Add(MakeShared<FJsonValueObject>(CaseObject));
+    }
+    TTFT.Sort();
+    Latency.Sort();
+
+    // Process-wide RAM only; a CUDA model's weights live in VRAM and are reported separately below
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    const double MB = 1024.0 * 1024.0;
+
+    const TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetNumberField(TEXT("ttft_p50_ms"), Percentile(TTFT, 50.0));
+    Summary->SetNumberField(TEXT("ttft_p95_ms"), Percentile(TTFT, 95.0));
+    Summary->SetNumberField(TEXT("latency_p50_ms"), Percentile(Latency, 50.0));
+    Summary->SetNumberField(TEXT("latency_p95_ms"), Percentile(Latency, 95.0));
+    Summary->SetNumberField(TEXT("tokens_per_second"), DecodeMs > 0.0 ? DecodeTokens * 1000.0 / DecodeMs : 0.0);
+    Summary->SetNumberField(TEXT("consistency"), ConsistencySum / Cases.Num());
+    Summary->SetNumberField(TEXT("peak_memory_mb"), MemoryStats.PeakUsedPhysical / MB);
+    Summary->SetNumberField(TEXT("model_memory_mb"), UsedAfterLoad > UsedBeforeLoad ? (UsedAfterLoad - UsedBeforeLoad) / MB : 0.0);
+    if (bMeasureVRAM && VRAM.IsAvailable())
+    {
+        Summary->SetNumberField(TEXT("peak_vram_mb"), VRAM.GetPeak() / MB);
+        Summary->SetNumberField(TEXT("model_vram_mb"), VRAMAfterLoad > VRAMBeforeLoad ? (VRAMAfterLoad - VRAMBeforeLoad) / MB : 0.0);
+    }
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI benchmark: %d questions x %d repeats"), Cases.Num(), Repeats);
+    UE_LOG(LogIGISDK, Display, TEXT("  %-16s p50 %8.1f ms   p95 %8.1f ms"), TEXT("TTFT"), Summary->GetNumberField(TEXT("ttft_p50_ms")), Summary->GetNumberField(TEXT("ttft_p95_ms")));
+    UE_LOG(LogIGISDK, Display, TEXT("  %-16s p50 %8.1f ms   p95 %8.1f ms"), TEXT("Latency"), Summary->GetNumberField(TEXT("latency_p50_ms")), Summary->GetNumberField(TEXT("latency_p95_ms")));
+    UE_LOG(LogIGISDK, Display, TEXT("  %-16s %.1f tokens/s"), TEXT("Decode"), Summary->GetNumberField(TEXT("tokens_per_second")));
+    UE_LOG(LogIGISDK, Display, TEXT("  %-16s %.3f"), TEXT("Consistency"), Summary->GetNumberField(TEXT("consistency")));
+    UE_LOG(LogIGISDK, Display, TEXT("  %-16s %.0f MB peak, %.0f MB for the model"), TEXT("Memory"), Summary->GetNumberField(TEXT("peak_memory_mb")), Summary->GetNumberField(TEXT("model_memory_mb")));
+    if (Summary->HasField(TEXT("peak_vram_mb")))
+    {
+        UE_LOG(LogIGISDK, Display, TEXT("  %-16s %.0f MB peak, %.0f MB for the model"), TEXT("VRAM"), Summary->GetNumberField(TEXT("peak_vram_mb")), Summary->GetNumberField(TEXT("model_vram_mb")));
+    }
+
+    const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("suite"), Suite.Name);
+    Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+    Report->SetStringField(TEXT("model"), Desc.ModelGUID);
+    Report->SetStringField(TEXT("backend"), StaticEnum<EIGIGPTBackend>()->GetNameStringByValue(static_cast<int64>(Desc.Backend)));
+    Report->SetNumberField(TEXT("repeats"), Repeats);
+    Report->SetObjectField(TEXT("summary"), Summary);
+    Report->SetArrayField(TEXT("cases"), CaseValues);
+
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IGI/Benchmarks"), FString::Printf(TEXT("Dialogue-%s.json"), *FDateTime::Now().ToString()));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    FString ReportJson;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportJson);
+    FJsonSerializer::Serialize(Report, Writer);
+    if (!FFileHelper::SaveStringToFile(ReportJson, *OutputPath))
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: unable to write %s"), *OutputPath);
+        return 1;
+    }
+    UE_LOG(LogIGISDK, Display, TEXT("IGI benchmark: wrote %s"), *OutputPath);
+
+    FString BaselinePath;
+    if (!FParse::Value(*Params, TEXT("Baseline="), BaselinePath))
+    {
+        return 0;
+    }
+
+    FString BaselineJson;
+    TSharedPtr<FJsonObject> Baseline;
+    const TSharedPtr<FJsonObject>* BaselineSummary = nullptr;
+    if (!FFileHelper::LoadFileToString(BaselineJson, *BaselinePath)
+        || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineJson), Baseline)
+        || !Baseline.IsValid()
+        || !Baseline->TryGetObjectField(TEXT("summary"), BaselineSummary))
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: unable to read baseline %s"), *BaselinePath);
+        return 1;
+    }
+
+    float MaxRegressionPercent = 10.f;
+    FParse::Value(*Params, TEXT("MaxRegression="), MaxRegressionPercent);
+
+    // Numbers from another backend or model aren't a baseline for this run
+    FString BaselineBackend;
+    FString BaselineModel;
+    Baseline->TryGetStringField(TEXT("backend"), BaselineBackend);
+    Baseline->TryGetStringField(TEXT("model"), BaselineModel);
+    if (BaselineBackend != Report->GetStringField(TEXT("backend")) || BaselineModel != Desc.ModelGUID)
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: baseline %s ran %s on %s"), *BaselinePath, *BaselineModel, *BaselineBackend);
+        return 1;
+    }
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI benchmark: against %s, %.0f%% allowed"), *BaselinePath, MaxRegressionPercent);
+    bool bRegressed = CheckRegression(*Summary, **BaselineSummary, TEXT("consistency"), false, MaxRegressionPercent);
+
+    // Mock replies take microseconds, so their timings are noise; it gates the pipeline's output only
+    if (Desc.Backend != EIGIGPTBackend::Mock)
+    {
+        bRegressed |= CheckRegression(*Summary, **BaselineSummary, TEXT("ttft_p95_ms"), true, MaxRegressionPercent);
+        bRegressed |= CheckRegression(*Summary, **BaselineSummary, TEXT("latency_p95_ms"), true, MaxRegressionPercent);
+        bRegressed |= CheckRegression(*Summary, **BaselineSummary, TEXT("tokens_per_second"), false, MaxRegressionPercent);
+    }
+
+    // Memory is gated where the model lives: RAM for CPU, VRAM for CUDA. A remote model's memory is on the server.
+    if (Desc.Backend == EIGIGPTBackend::CPU)
+    {
+        bRegressed |= CheckRegression(*Summary, **BaselineSummary, TEXT("peak_memory_mb"), true, MaxRegressionPercent);
+    }
+    else if (Desc.Backend == EIGIGPTBackend::CUDA)
+    {
+        bRegressed |= CheckRegression(*Summary, **BaselineSummary, TEXT("peak_vram_mb"), true, MaxRegressionPercent);
+    }
+
+    if (bRegressed)
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI benchmark: regressed against %s"), *BaselinePath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "IGIBenchmarkCommandlet.generated.h"
+
+/** One golden question and the terms an in-character answer should and should not contain */
+USTRUCT()
+struct FIGIBenchmarkQuestion
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString Question;
+
+    /** Case-insensitive; each one present in the reply raises its consistency score */
+    UPROPERTY()
+    TArray<FString> ExpectedTerms;
+
+    /** Case-insensitive; each one present in the reply lowers its consistency score */
+    UPROPERTY()
+    TArray<FString> ForbiddenTerms;
+
+    UPROPERTY()
+    int32 TokensToPredict = 80;
+};
+
+USTRUCT()
+struct FIGIBenchmarkNPC
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString Name;
+
+    /** System prompt the NPC is played with */
+    UPROPERTY()
+    FString Persona;
+
+    UPROPERTY()
+    TArray<FIGIBenchmarkQuestion> Questions;
+};
+
+USTRUCT()
+struct FIGIBenchmarkSuite
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString Name;
+
+    /** Checked in every reply on top of each question's own, e.g. breaking character */
+    UPROPERTY()
+    TArray<FString> ForbiddenTerms;
+
+    UPROPERTY()
+    TArray<FIGIBenchmarkNPC> NPCs;
+};
+
+/**
+ * Runs a golden set of persona and question prompts through FIGIGPT headless and reports TTFT, decode
+ * rate, latency, peak process RAM (plus peak VRAM on CUDA) and a consistency score, as JSON for trend tracking.
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=IGIBenchmark
+ *        [-Suite=<json>] [-Model=<GUID>] [-Backend=CUDA|CPU|Remote|Mock] [-ContextSize=<tokens>]
+ *        [-Repeats=<n>] [-Output=<json>] [-Baseline=<json>] [-MaxRegression=<percent>]
+ *
+ * The suite defaults to Config/DialogueBenchmark.json in the plugin. Each question is asked Repeats times
+ * with fixed seeds; consistency combines expected/forbidden term coverage with how much the repeated
+ * replies agree. Mock runs without nvigi or model files, so it can gate the pipeline in CI. With a
+ * baseline, the commandlet fails if latency, decode rate, consistency or memory regressed by more than
+ * MaxRegression. Memory is gated where the model lives: RAM on CPU, VRAM on CUDA, and not at all on Remote or Mock.
+ */
+UCLASS()
+class UIGIBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UIGIBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
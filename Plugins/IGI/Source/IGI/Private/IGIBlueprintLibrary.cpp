@@ -5,26 +5,26 @@
 #include "IGIBlueprintLibrary.h"
 
 #include "Async/Async.h"
-#include "Async/TaskGraphInterfaces.h"
 #include "Modules/ModuleManager.h"
 
+#include "IGIEmbed.h"
 #include "IGIGPT.h"
+#include "IGIInferenceServer.h"
+#include "IGIKVCacheManager.h"
 #include "IGILog.h"
+#include "IGIModelRegistry.h"
+#include "IGIResultDispatcher.h"
 
-std::atomic<bool> UIGIGPTEvaluateAsync::IsRunning = false;
-
-UIGIGPTEvaluateAsync* UIGIGPTEvaluateAsync::GPTEvaluateAsync(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt)
+UIGIGPTEvaluateAsync* UIGIGPTEvaluateAsync::GPTEvaluateAsync(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt, EIGIModelTier Tier, const FString& SessionId, EIGIRequestPriority Priority, const TMap<FString, float>& LogitBias)
 {
-    if (IsRunning)
-    {
-        UE_LOG(LogIGISDK, Log, TEXT("%s: GPT is already running! Request was ignored."), ANSI_TO_TCHAR(__FUNCTION__));
-        return nullptr;
-    }
-
     UIGIGPTEvaluateAsync* BlueprintNode = NewObject<UIGIGPTEvaluateAsync>();
     BlueprintNode->SystemPrompt = SystemPrompt;
     BlueprintNode->UserPrompt = UserPrompt;
     BlueprintNode->AssistantPrompt = AssistantPrompt;
+    BlueprintNode->Tier = Tier;
+    BlueprintNode->SessionId = SessionId;
+    BlueprintNode->Priority = Priority;
+    BlueprintNode->LogitBias = LogitBias;
     BlueprintNode->AddToRoot();
 
     return BlueprintNode;
@@ -38,34 +38,140 @@ void UIGIGPTEvaluateAsync::Activate()
     const FString TrimmedUserPrompt = UserPrompt.TrimStartAndEnd();
     const FString TrimmedAssistantPrompt = AssistantPrompt.TrimStartAndEnd();
 
+    FIGIModule& IGIModule{ FModuleManager::GetModuleChecked<FIGIModule>(FName("IGI")) };
+    FIGIModelRegistry* Registry{ IGIModule.GetModelRegistry() };
+    const int32 PromptLength = TrimmedSystemPrompt.Len() + TrimmedUserPrompt.Len() + TrimmedAssistantPrompt.Len();
+    EIGIModelTier RoutedTier{ EIGIModelTier::Large };
+
     if (TrimmedUserPrompt.IsEmpty())
     {
         UE_LOG(LogIGISDK, Log, TEXT("%s: GPT called with empty user prompt!"), ANSI_TO_TCHAR(__FUNCTION__));
+        RemoveFromRoot();
+    }
+    else if (!Registry->TryBeginRequest(Tier, PromptLength, Priority, RoutedTier))
+    {
+        UE_LOG(LogIGISDK, Log, TEXT("%s: GPT queue for %s tier is full! Request was ignored."), ANSI_TO_TCHAR(__FUNCTION__), *UEnum::GetValueAsString(RoutedTier));
+        RemoveFromRoot();
     }
     else
     {
-        IsRunning = true;
-
-        UE_LOG(LogIGISDK, Log, TEXT("%s: sending to GPT: %s"), ANSI_TO_TCHAR(__FUNCTION__), *TrimmedUserPrompt);
+        if (IGIShouldLog(EIGILogSource::Request, ELogVerbosity::Log))
+        {
+            IGILogRequest(ELogVerbosity::Log, FString::Printf(TEXT("%s: sending to GPT (%s tier): %s"), ANSI_TO_TCHAR(__FUNCTION__), *UEnum::GetValueAsString(RoutedTier), *IGIRedactForLog(TrimmedUserPrompt)));
+        }
+
+        FIGIGPTRequest Request;
+        Request.SystemPrompt = TrimmedSystemPrompt;
+        Request.UserPrompt = TrimmedUserPrompt;
+        Request.AssistantPrompt = TrimmedAssistantPrompt;
+        Request.Priority = Priority;
+        Request.Sampling.LogitBias = LogitBias;
+
+        // The node stays rooted until its final result is delivered, and chunks are always delivered before it
+        FIGIResultDispatcher* Dispatcher{ IGIModule.GetResultDispatcher() };
+        FIGIChunkStreamRef Stream = MakeShared<FIGIChunkStream, ESPMode::ThreadSafe>([this](const FString& Chunks)
+            {
+                OnChunk.Broadcast(Chunks);
+            });
+        Request.OnChunk = [Dispatcher, Stream](const FString& Chunk)
+            {
+                Dispatcher->EnqueueChunk(Stream, Chunk);
+            };
 
-        AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [this, TrimmedSystemPrompt, TrimmedUserPrompt, TrimmedAssistantPrompt]()
+        IGIModule.GetInferenceServer()->Submit(RoutedTier, Request, SessionId, [this, Registry, RoutedTier, Dispatcher](const FString& Result, const FIGIGPTTimings&)
             {
-                FString result;
-                FIGIGPT* GPT{ FModuleManager::GetModuleChecked<FIGIModule>(FName("IGI")).GetGPT()};
-                if (GPT != nullptr)
+                if (IGIShouldLog(EIGILogSource::Request, ELogVerbosity::Log))
                 {
-                    result = GPT->Evaluate(TrimmedSystemPrompt, TrimmedUserPrompt, TrimmedAssistantPrompt);
-
-                    AsyncTask(ENamedThreads::GameThread, [this, result]()
-                        {
-                            OnResponse.Broadcast(result);
-                        });
-
-                    UE_LOG(LogIGISDK, Log, TEXT("%s: response from GPT: %s"), ANSI_TO_TCHAR(__FUNCTION__), *result);
+                    IGILogRequest(ELogVerbosity::Log, FString::Printf(TEXT("%s: response from GPT: %s"), ANSI_TO_TCHAR(__FUNCTION__), *IGIRedactForLog(Result)));
                 }
 
-                IsRunning = false;
-                this->RemoveFromRoot();
+                Registry->EndRequest(RoutedTier);
+
+                Dispatcher->Enqueue([this, Result]()
+                    {
+                        OnResponse.Broadcast(Result);
+                        SetReadyToDestroy();
+                        RemoveFromRoot();
+                    });
             });
     }
 }
+
+UIGISaveGPTSessionsAsync* UIGISaveGPTSessionsAsync::SaveGPTSessionsAsync(const FString& SlotName)
+{
+    UIGISaveGPTSessionsAsync* BlueprintNode = NewObject<UIGISaveGPTSessionsAsync>();
+    BlueprintNode->SlotName = SlotName;
+    BlueprintNode->AddToRoot();
+
+    return BlueprintNode;
+}
+
+void UIGISaveGPTSessionsAsync::Activate()
+{
+    FIGIModule& IGIModule{ FModuleManager::GetModuleChecked<FIGIModule>(FName("IGI")) };
+    FIGIResultDispatcher* Dispatcher{ IGIModule.GetResultDispatcher() };
+
+    IGIModule.GetKVCacheManager()->SaveSessions(FIGIKVCacheManager::GetSaveGameSessionsPath(SlotName), [this, Dispatcher](bool bSaved)
+        {
+            Dispatcher->Enqueue([this, bSaved]()
+                {
+                    OnSaved.Broadcast(bSaved);
+                    SetReadyToDestroy();
+                    RemoveFromRoot();
+                });
+        });
+}
+
+bool UIGIBlueprintLibrary::LoadGPTSessions(const FString& SlotName)
+{
+    FIGIModule& IGIModule{ FModuleManager::GetModuleChecked<FIGIModule>(FName("IGI")) };
+    return IGIModule.GetKVCacheManager()->LoadSessions(FIGIKVCacheManager::GetSaveGameSessionsPath(SlotName));
+}
+
+UIGIEmbedAsync* UIGIEmbedAsync::EmbedAsync(const FString& Text)
+{
+    UIGIEmbedAsync* BlueprintNode = NewObject<UIGIEmbedAsync>();
+    BlueprintNode->Text = Text;
+    BlueprintNode->AddToRoot();
+
+    return BlueprintNode;
+}
+
+void UIGIEmbedAsync::Activate()
+{
+    FIGIModule& IGIModule{ FModuleManager::GetModuleChecked<FIGIModule>(FName("IGI")) };
+    FIGIResultDispatcher* Dispatcher{ IGIModule.GetResultDispatcher() };
+
+    // The first call loads the model, so never on the game thread
+    Async(EAsyncExecution::Thread, [this, &IGIModule, Dispatcher, Input = Text.TrimStartAndEnd()]()
+        {
+            FIGIEmbedPtr Embed = IGIModule.GetEmbed();
+            TArray<float> Embedding = (Embed.IsValid() && !Input.IsEmpty()) ? Embed->Embed(Input) : TArray<float>();
+
+            Dispatcher->Enqueue([this, Embedding = MoveTemp(Embedding)]()
+                {
+                    OnEmbedding.Broadcast(Embedding);
+                    SetReadyToDestroy();
+                    RemoveFromRoot();
+                });
+        });
+}
+
+float UIGIBlueprintLibrary::EmbeddingSimilarity(const TArray<float>& A, const TArray<float>& B)
+{
+    if (A.Num() != B.Num() || A.IsEmpty())
+    {
+        return 0.f;
+    }
+
+    float Dot = 0.f;
+    float NormA = 0.f;
+    float NormB = 0.f;
+    for (int32 Index = 0; Index < A.Num(); ++Index)
+    {
+        Dot += A[Index] * B[Index];
+        NormA += A[Index] * A[Index];
+        NormB += B[Index] * B[Index];
+    }
+    return (NormA > 0.f && NormB > 0.f) ? Dot * FMath::InvSqrt(NormA * NormB) : 0.f;
+}
@@ -18,6 +18,9 @@ public:
 
     bool IsInitialized() const { return bInitialized; }
 
+    /** Plugins and adapters detected by nvigiInit */
+    const nvigi::PluginAndSystemInformation* GetSystemInformation() const { return IGIRequirements; }
+
     nvigi::Result LoadInterface(const nvigi::PluginID& Feature, const nvigi::UID& InterfaceType, nvigi::InferenceInterface** Interface, const UTF8CHAR* UTF8PathToPlugin = nullptr);
     nvigi::Result UnloadInterface(const nvigi::PluginID& Feature, nvigi::InferenceInterface* Interface);
 
@@ -0,0 +1,254 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIEmbed.h"
+
+#include "CoreMinimal.h"
+
+#include "IGIModule.h"
+#include "IGILog.h"
+#include "IGISettings.h"
+
+#include "nvigi.h"
+#include "nvigi_ai.h"
+#include "nvigi_embed.h"
+#include "nvigi_stl_helpers.h"
+#include "nvigi_struct.h"
+
+#include <condition_variable>
+#include <mutex>
+
+class FIGIEmbed::Impl
+{
+public:
+    Impl(FIGIModule* IGIModule, const FIGIEmbedModelDesc& ModelDesc)
+        : IGIModulePtr(IGIModule)
+        , Desc(ModelDesc)
+    {
+        IGIModulePtr->LoadIGIFeature(GetFeatureId(), &EmbedInterface, nullptr);
+        if (EmbedInterface == nullptr)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to load %s embed feature for model %s"), *UEnum::GetValueAsString(Desc.Backend), *Desc.ModelGUID);
+            return;
+        }
+
+        nvigi::EmbedCreationParameters params{};
+        nvigi::CommonCreationParameters common{};
+        auto ConvertedString = StringCast<UTF8CHAR>(*IGIModulePtr->GetModelsPath());
+        common.utf8PathToModels = reinterpret_cast<const char*>(ConvertedString.Get());
+        common.numThreads = Desc.NumThreads;
+        common.vramBudgetMB = Desc.VRAMBudgetMB;
+        auto ModelGUIDUTF = StringCast<UTF8CHAR>(*Desc.ModelGUID);
+        common.modelGUID = reinterpret_cast<const char*>(ModelGUIDUTF.Get());
+        nvigi::Result Result = params.chain(common);
+        if (Result != nvigi::kResultOk)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to chain common embed parameters: %s"), *GetIGIStatusString(Result));
+            return;
+        }
+
+        // The output buffer is ours to size, so the dimension has to be known before the first call
+        nvigi::EmbedCapabilitiesAndRequirements* Caps{ nullptr };
+        Result = nvigi::getCapsAndRequirements(EmbedInterface, params, &Caps);
+        if (Result != nvigi::kResultOk || Caps == nullptr || Caps->embedding_numel == 0)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to query embedding size of model %s: %s"), *Desc.ModelGUID, *GetIGIStatusString(Result));
+            return;
+        }
+        Dimension = static_cast<int32>(Caps->embedding_numel);
+
+        Result = EmbedInterface->createInstance(params, &EmbedInstance);
+        if (Result != nvigi::kResultOk)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to create %s embed instance for model %s: %s"), *UEnum::GetValueAsString(Desc.Backend), *Desc.ModelGUID, *GetIGIStatusString(Result));
+            EmbedInstance = nullptr;
+        }
+    }
+
+    virtual ~Impl()
+    {
+        if (EmbedInstance != nullptr)
+        {
+            EmbedInterface->destroyInstance(EmbedInstance);
+            EmbedInstance = nullptr;
+        }
+
+        if (IGIModulePtr && EmbedInterface)
+        {
+            IGIModulePtr->UnloadIGIFeature(GetFeatureId(), EmbedInterface);
+            IGIModulePtr = nullptr;
+        }
+    }
+
+    bool IsValid() const { return EmbedInstance != nullptr; }
+
+    const FIGIEmbedModelDesc& GetModelDesc() const { return Desc; }
+
+    int32 GetDimension() const { return Dimension; }
+
+    TArray<TArray<float>> Embed(const TArray<FString>& Texts)
+    {
+        TArray<TArray<float>> Vectors;
+        if (!IsValid() || Texts.IsEmpty())
+        {
+            return Vectors;
+        }
+
+        FScopeLock Lock(&CS);
+
+        const int32 BatchSize = FMath::Max(1, GetDefault<UIGISettings>()->EmbedMaxBatchSize);
+        Vectors.Reserve(Texts.Num());
+        for (int32 First = 0; First < Texts.Num(); First += BatchSize)
+        {
+            const int32 Count = FMath::Min(BatchSize, Texts.Num() - First);
+            if (!EmbedBatch(MakeArrayView(Texts.GetData() + First, Count), Vectors))
+            {
+                return TArray<TArray<float>>();
+            }
+        }
+        return Vectors;
+    }
+
+private:
+    /** One backend call for the whole batch; the prompts travel in a single text slot separated by the SDK's marker */
+    bool EmbedBatch(TArrayView<const FString> Texts, TArray<TArray<float>>& OutVectors)
+    {
+        FString Joined;
+        for (int32 Index = 0; Index < Texts.Num(); ++Index)
+        {
+            if (Index > 0)
+            {
+                Joined += UTF8_TO_TCHAR(nvigi::prompts_sep);
+            }
+            Joined += Texts[Index];
+        }
+
+        auto JoinedUTF = StringCast<UTF8CHAR>(*Joined);
+        nvigi::InferenceDataTextSTLHelper InputData(reinterpret_cast<const char*>(JoinedUTF.Get()));
+        TArray<nvigi::InferenceDataSlot> inSlots = {
+            { nvigi::kEmbedDataSlotInText, InputData }
+        };
+        nvigi::InferenceDataSlotArray inputs = { static_cast<size_t>(inSlots.Num()), inSlots.GetData() };
+
+        TArray<float> Output;
+        Output.SetNumZeroed(Texts.Num() * Dimension);
+        nvigi::CpuData OutputBuffer(Output.Num() * sizeof(float), Output.GetData());
+        nvigi::InferenceDataByteArray OutputData(OutputBuffer);
+        TArray<nvigi::InferenceDataSlot> outSlots = {
+            { nvigi::kEmbedDataSlotOutEmbedding, OutputData }
+        };
+        nvigi::InferenceDataSlotArray outputs = { static_cast<size_t>(outSlots.Num()), outSlots.GetData() };
+
+        struct FCallbackCtx
+        {
+            std::mutex Mutex;
+            std::condition_variable CV;
+            nvigi::InferenceExecutionState State{ nvigi::kInferenceExecutionStateDataPending };
+        };
+        FCallbackCtx CallbackCtx;
+
+        auto Callback = [](const nvigi::InferenceExecutionContext*, nvigi::InferenceExecutionState State, void* Data) -> nvigi::InferenceExecutionState
+            {
+                FCallbackCtx* Ctx = static_cast<FCallbackCtx*>(Data);
+                {
+                    std::scoped_lock Lock(Ctx->Mutex);
+                    Ctx->State = State;
+                }
+                Ctx->CV.notify_one();
+                return State;
+            };
+
+        nvigi::InferenceExecutionContext EmbedCtx{};
+        EmbedCtx.instance = EmbedInstance;
+        EmbedCtx.callback = Callback;
+        EmbedCtx.callbackUserData = &CallbackCtx;
+        EmbedCtx.inputs = &inputs;
+        EmbedCtx.outputs = &outputs;
+
+        const nvigi::Result Result = EmbedInstance->evaluate(&EmbedCtx);
+        if (Result != nvigi::kResultOk)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("Embedding %d texts failed: %s"), Texts.Num(), *GetIGIStatusString(Result));
+            return false;
+        }
+
+        {
+            std::unique_lock Lock(CallbackCtx.Mutex);
+            CallbackCtx.CV.wait(Lock, [&CallbackCtx]() { return CallbackCtx.State != nvigi::kInferenceExecutionStateDataPending; });
+        }
+        if (CallbackCtx.State != nvigi::kInferenceExecutionStateDone)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("Embedding %d texts did not complete"), Texts.Num());
+            return false;
+        }
+
+        for (int32 Index = 0; Index < Texts.Num(); ++Index)
+        {
+            TArray<float>& Vector = OutVectors.Emplace_GetRef(Output.GetData() + Index * Dimension, Dimension);
+
+            float SquaredNorm = 0.f;
+            for (float Value : Vector)
+            {
+                SquaredNorm += Value * Value;
+            }
+            const float Scale = SquaredNorm > 0.f ? FMath::InvSqrt(SquaredNorm) : 0.f;
+            for (float& Value : Vector)
+            {
+                Value *= Scale;
+            }
+        }
+        return true;
+    }
+
+    nvigi::PluginID GetFeatureId() const
+    {
+        return Desc.Backend == EIGIGPTBackend::CPU ? nvigi::plugin::embed::ggml::cpu::kId : nvigi::plugin::embed::ggml::cuda::kId;
+    }
+
+    FCriticalSection CS;
+
+    // Non-owning ptr
+    FIGIModule* IGIModulePtr;
+
+    FIGIEmbedModelDesc Desc;
+    int32 Dimension{ 0 };
+
+    nvigi::IEmbed* EmbedInterface{ nullptr };
+    nvigi::InferenceInstance* EmbedInstance{ nullptr };
+};
+
+// ----------------------------------
+
+FIGIEmbed::FIGIEmbed(FIGIModule* IGIModule, const FIGIEmbedModelDesc& ModelDesc)
+{
+    Pimpl = MakePimpl<FIGIEmbed::Impl>(IGIModule, ModelDesc);
+}
+
+FIGIEmbed::~FIGIEmbed() {}
+
+bool FIGIEmbed::IsValid() const
+{
+    return Pimpl->IsValid();
+}
+
+const FIGIEmbedModelDesc& FIGIEmbed::GetModelDesc() const
+{
+    return Pimpl->GetModelDesc();
+}
+
+int32 FIGIEmbed::GetDimension() const
+{
+    return Pimpl->GetDimension();
+}
+
+TArray<TArray<float>> FIGIEmbed::Embed(const TArray<FString>& Texts)
+{
+    return Pimpl->Embed(Texts);
+}
+
+TArray<float> FIGIEmbed::Embed(const FString& Text)
+{
+    TArray<TArray<float>> Vectors = Pimpl->Embed({ Text });
+    return Vectors.IsEmpty() ? TArray<float>() : MoveTemp(Vectors[0]);
+}
@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIFrameBudget.h"
+
+#include "CoreMinimal.h"
+
+#include "IGISettings.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace
+{
+    constexpr int32 NUM_PRIORITIES{ static_cast<int32>(EIGIRequestPriority::Maintenance) + 1 };
+
+    // Without a tick for this long (loading, commandlets) slices are granted unthrottled
+    constexpr double STALE_TICK_SECONDS{ 0.25 };
+
+    // Upper bound on a single wait so a missed notify never parks a worker for long
+    constexpr double MAX_WAIT_SECONDS{ 0.05 };
+}
+
+class FIGIFrameBudget::Impl
+{
+public:
+    Impl()
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        TargetFrameMs = Settings->TargetFrameTimeMs;
+        MinSliceMs = Settings->MinInferenceSliceMs;
+        MaxSliceMs = FMath::Max(Settings->MaxInferenceSliceMs, MinSliceMs);
+        AgingSeconds = Settings->PriorityAgingSeconds;
+        SliceBudgetMs = MaxSliceMs;
+        RemainingMs = SliceBudgetMs;
+    }
+
+    virtual ~Impl() {}
+
+    void Tick(float DeltaSeconds)
+    {
+        {
+            std::scoped_lock Lock(Mutex);
+
+            // AIMD: back off quickly when a frame runs long, recover slowly
+            const double FrameMs = DeltaSeconds * 1000.0;
+            if (FrameMs > TargetFrameMs * 1.05)
+            {
+                SliceBudgetMs = FMath::Max(MinSliceMs, SliceBudgetMs * 0.75);
+            }
+            else
+            {
+                SliceBudgetMs = FMath::Min(MaxSliceMs, SliceBudgetMs + 0.25);
+            }
+
+            RemainingMs = SliceBudgetMs;
+            LastTickTime = FPlatformTime::Seconds();
+        }
+        CV.notify_all();
+    }
+
+    void BeginRequest(EIGIRequestPriority Priority)
+    {
+        std::scoped_lock Lock(Mutex);
+        ++InFlight[static_cast<int32>(Priority)];
+    }
+
+    void EndRequest(EIGIRequestPriority Priority)
+    {
+        {
+            std::scoped_lock Lock(Mutex);
+            --InFlight[static_cast<int32>(Priority)];
+        }
+        CV.notify_all();
+    }
+
+    void AddQueued(EIGIRequestPriority Priority, double EnqueueTime)
+    {
+        std::scoped_lock Lock(Mutex);
+        Queued.Add({ Priority, EnqueueTime });
+    }
+
+    void RemoveQueued(EIGIRequestPriority Priority, double EnqueueTime)
+    {
+        std::scoped_lock Lock(Mutex);
+        const int32 Index{ Queued.IndexOfByPredicate([Priority, EnqueueTime](const FQueuedRequest& Request)
+            {
+                return Request.Priority == Priority && Request.EnqueueTime == EnqueueTime;
+            }) };
+        if (Index != INDEX_NONE)
+        {
+            Queued.RemoveAtSwap(Index);
+        }
+    }
+
+    EIGIRequestPriority GetAgedPriority(EIGIRequestPriority Priority, double EnqueueTime) const
+    {
+        // Interactive is reserved for the player's own conversation; everything else tops out one class below
+        constexpr int32 HighestAged{ static_cast<int32>(EIGIRequestPriority::ForegroundPrefetch) };
+        const int32 Base{ static_cast<int32>(Priority) };
+        if (AgingSeconds <= 0.0 || Base <= HighestAged)
+        {
+            return Priority;
+        }
+
+        const int32 Steps{ FMath::FloorToInt32((FPlatformTime::Seconds() - EnqueueTime) / AgingSeconds) };
+        return static_cast<EIGIRequestPriority>(FMath::Max(HighestAged, Base - FMath::Max(0, Steps)));
+    }
+
+    void WaitForSlice(EIGIRequestPriority Priority)
+    {
+        std::unique_lock Lock(Mutex);
+        while (!CanRun(Priority))
+        {
+            CV.wait_for(Lock, std::chrono::duration<double>(MAX_WAIT_SECONDS));
+        }
+    }
+
+    bool ShouldYield(EIGIRequestPriority Priority) const
+    {
+        std::scoped_lock Lock(Mutex);
+        return HasMoreImportant(Priority) || HasMoreImportantQueued(Priority);
+    }
+
+    bool IsIdle() const
+    {
+        std::scoped_lock Lock(Mutex);
+        for (int32 Index = 0; Index < NUM_PRIORITIES; ++Index)
+        {
+            if (InFlight[Index] > 0)
+            {
+                return false;
+            }
+        }
+        return Queued.IsEmpty();
+    }
+
+    void ConsumeSlice(double Milliseconds)
+    {
+        std::scoped_lock Lock(Mutex);
+        RemainingMs -= Milliseconds;
+    }
+
+    double GetSliceBudgetMs() const
+    {
+        std::scoped_lock Lock(Mutex);
+        return SliceBudgetMs;
+    }
+
+private:
+    bool CanRun(EIGIRequestPriority Priority) const
+    {
+        if (FPlatformTime::Seconds() - LastTickTime > STALE_TICK_SECONDS)
+        {
+            return true;
+        }
+
+        return !HasMoreImportant(Priority) && RemainingMs > 0.0;
+    }
+
+    bool HasMoreImportant(EIGIRequestPriority Priority) const
+    {
+        for (int32 Index = 0; Index < static_cast<int32>(Priority); ++Index)
+        {
+            if (InFlight[Index] > 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Queued requests only preempt; if they also held slices back, a running request could wait on one that needs its worker.
+    // They count at their aged class, the one the queue will schedule them at.
+    bool HasMoreImportantQueued(EIGIRequestPriority Priority) const
+    {
+        for (const FQueuedRequest& Request : Queued)
+        {
+            if (GetAgedPriority(Request.Priority, Request.EnqueueTime) < Priority)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct FQueuedRequest
+    {
+        EIGIRequestPriority Priority;
+        double EnqueueTime;
+    };
+
+    mutable std::mutex Mutex;
+    std::condition_variable CV;
+
+    double TargetFrameMs{ 16.6 };
+    double MinSliceMs{ 1.0 };
+    double MaxSliceMs{ 8.0 };
+    double SliceBudgetMs{ 8.0 };
+    double RemainingMs{ 8.0 };
+    double LastTickTime{ 0.0 };
+    double AgingSeconds{ 4.0 };
+
+    int32 InFlight[NUM_PRIORITIES]{};
+    TArray<FQueuedRequest> Queued;
+};
+
+// ----------------------------------
+
+FIGIFrameBudget::FIGIFrameBudget()
+{
+    Pimpl = MakePimpl<FIGIFrameBudget::Impl>();
+}
+
+FIGIFrameBudget::~FIGIFrameBudget() {}
+
+void FIGIFrameBudget::Tick(float DeltaSeconds)
+{
+    Pimpl->Tick(DeltaSeconds);
+}
+
+void FIGIFrameBudget::BeginRequest(EIGIRequestPriority Priority)
+{
+    Pimpl->BeginRequest(Priority);
+}
+
+void FIGIFrameBudget::EndRequest(EIGIRequestPriority Priority)
+{
+    Pimpl->EndRequest(Priority);
+}
+
+void FIGIFrameBudget::AddQueued(EIGIRequestPriority Priority, double EnqueueTime)
+{
+    Pimpl->AddQueued(Priority, EnqueueTime);
+}
+
+void FIGIFrameBudget::RemoveQueued(EIGIRequestPriority Priority, double EnqueueTime)
+{
+    Pimpl->RemoveQueued(Priority, EnqueueTime);
+}
+
+EIGIRequestPriority FIGIFrameBudget::GetAgedPriority(EIGIRequestPriority Priority, double EnqueueTime) const
+{
+    return Pimpl->GetAgedPriority(Priority, EnqueueTime);
+}
+
+void FIGIFrameBudget::WaitForSlice(EIGIRequestPriority Priority)
+{
+    Pimpl->WaitForSlice(Priority);
+}
+
+bool FIGIFrameBudget::ShouldYield(EIGIRequestPriority Priority) const
+{
+    return Pimpl->ShouldYield(Priority);
+}
+
+bool FIGIFrameBudget::IsIdle() const
+{
+    return Pimpl->IsIdle();
+}
+
+void FIGIFrameBudget::ConsumeSlice(double Milliseconds)
+{
+    Pimpl->ConsumeSlice(Milliseconds);
+}
+
+double FIGIFrameBudget::GetSliceBudgetMs() const
+{
+    return Pimpl->GetSliceBudgetMs();
+}
@@ -5,10 +5,18 @@
 #include "IGIGPT.h"
 
 #include "CoreMinimal.h"
+#include "HAL/FileManager.h"
 #include "ID3D12DynamicRHI.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
 
+#include "IGIFrameBudget.h"
+#include "IGIHost.h"
 #include "IGIModule.h"
 #include "IGILog.h"
+#include "IGIRemoteGPT.h"
+#include "IGISettings.h"
+#include "IGITrace.h"
 
 #include "nvigi.h"
 #include "nvigi_ai.h"
@@ -21,119 +29,300 @@
 #include "nvigi_d3d12.h"
 #pragma warning( pop )
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
 #include <mutex>
 
-namespace
-{
-    constexpr const char* const GGUF_MODEL_MINITRON{ "{8E31808B-C182-4016-9ED8-64804FF5B40D}" };
-    constexpr std::size_t VRAM_BUDGET_RECOMMENDATION{ 1024 * 24 };
-    constexpr std::size_t THREAD_NUM_RECOMMENDATION{ 1 }; // Recommended number of threads for CiG
-    constexpr std::size_t CONTEXT_SIZE_RECOMMENDATION{ 4096 };
-}
-
 class FIGIGPT::Impl
 {
 public:
-    Impl(FIGIModule* IGIModule)
+    Impl(FIGIModule* IGIModule, const FIGIGPTModelDesc& ModelDesc)
         : IGIModulePtr(IGIModule)
+        , Desc(ModelDesc)
     {
-        nvigi::Result Result = nvigi::kResultOk;
-
-        IGIModulePtr->LoadIGIFeature(nvigi::plugin::gpt::ggml::cuda::kId, &GPTInterface, nullptr);
+        Backend = ModelDesc.Backend;
 
-        nvigi::GPTCreationParameters params{};
-        params.contextSize = CONTEXT_SIZE_RECOMMENDATION;
-        nvigi::CommonCreationParameters common{};
-        auto ConvertedString = StringCast<UTF8CHAR>(*IGIModulePtr->GetModelsPath());
-        common.utf8PathToModels = reinterpret_cast<const char*>(ConvertedString.Get());
-        common.numThreads = THREAD_NUM_RECOMMENDATION;
-        common.vramBudgetMB = VRAM_BUDGET_RECOMMENDATION;
-        common.modelGUID = GGUF_MODEL_MINITRON;
-        Result = params.chain(common);
-        if (Result != nvigi::kResultOk)
+        if (Backend == EIGIGPTBackend::Remote)
         {
-            UE_LOG(LogIGISDK, Error, TEXT("Unable to chain common parameters; cannot use CiG: %s"), *GetIGIStatusString(Result));
-            GPTInstance = nullptr;
+            CreateRemote();
+            return;
         }
-
-        nvigi::D3D12Parameters d3d12Params{};
-        if (GDynamicRHI &&
-            GDynamicRHI->GetInterfaceType() == ERHIInterfaceType::D3D12)
+        if (Backend == EIGIGPTBackend::Mock)
         {
-            ID3D12DynamicRHI* RHI = static_cast<ID3D12DynamicRHI*>(GDynamicRHI);
-            if (RHI)
-            {
-                ID3D12CommandQueue* CmdQ = RHI->RHIGetCommandQueue();
-                constexpr uint32 RHI_DEVICE_INDEX = 0u;
-                ID3D12Device* D3D12Device = RHI->RHIGetDevice(RHI_DEVICE_INDEX);
-
-                if (CmdQ && D3D12Device)
-                {
-                    d3d12Params.device = D3D12Device;
-                    d3d12Params.queue = CmdQ;
-
-                    Result = params.chain(d3d12Params);
-                    if (Result != nvigi::kResultOk)
-                    {
-                        UE_LOG(LogIGISDK, Error, TEXT("Unable to chain D3D12 parameters; cannot use CiG: %s"), *GetIGIStatusString(Result));
-                        GPTInstance = nullptr;
-                    }
-                }
-                else
-                {
-                    UE_LOG(LogIGISDK, Error, TEXT("Unable to retrieve D3D12 device and command queue from UE; cannot use CiG: %s"), *GetIGIStatusString(Result));
-                    GPTInstance = nullptr;
-                }
-            }
-            else
+            // Word salad in front of a player would look like a broken model, so only commandlets get it
+            if (!IsRunningCommandlet())
             {
-                UE_LOG(LogIGISDK, Error, TEXT("Unable to retrieve RHI instance from UE; cannot use CiG: %s"), *GetIGIStatusString(Result));
-                GPTInstance = nullptr;
+                UE_LOG(LogIGISDK, Error, TEXT("Mock GPT backend requested for model %s outside a commandlet; the model stays invalid"), *ModelDesc.ModelGUID);
             }
+            return;
         }
-        else
+
+        // Out of process, the host loads the model and EvaluateOnce forwards to it
+        HostClient = IGIModulePtr->GetHostClient();
+        if (HostClient && HostClient->IsConnected())
         {
-            UE_LOG(LogIGISDK, Log, TEXT("UE not using D3D12; cannot use CiG: %s"), *GetIGIStatusString(Result));
-            GPTInstance = nullptr;
+            LoadInHost();
+            return;
         }
 
-        Result = GPTInterface->createInstance(params, &GPTInstance);
-        if (Result != nvigi::kResultOk)
+        // A host still starting up (or given up on) doesn't hold the game back: the model loads here and
+        // moves to the host on the first request after it attaches
+        if (HostClient)
         {
-            UE_LOG(LogIGISDK, Fatal, TEXT("Unable to create gpt.ggml.cuda instance: %s"), *GetIGIStatusString(Result));
-            GPTInstance = nullptr;
+            UE_LOG(LogIGISDK, Log, TEXT("Inference host not attached yet; loading GPT model %s in-process for now"), *ModelDesc.ModelGUID);
         }
+        CreateInProcess();
     }
 
     virtual ~Impl()
     {
+        if (HostClient && HostModel != 0 && HostGeneration == HostClient->GetGeneration())
+        {
+            HostClient->UnloadModel(HostModel);
+        }
+
         if (GPTInstance != nullptr)
         {
             GPTInterface->destroyInstance(GPTInstance);
             GPTInstance = nullptr;
         }
 
-        if (IGIModulePtr)
+        if (IGIModulePtr && GPTInterface)
         {
-            IGIModulePtr->UnloadIGIFeature(nvigi::plugin::gpt::ggml::cuda::kId, GPTInterface);
+            IGIModulePtr->UnloadIGIFeature(GetFeatureId(), GPTInterface);
             IGIModulePtr = nullptr;
         }
     }
 
-    FString Evaluate(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt)
+    bool IsValid() const
+    {
+        if (Remote.IsValid())
+        {
+            return RemoteState->bReachable || CanFallBack();
+        }
+        if (Backend == EIGIGPTBackend::Mock)
+        {
+            return IsRunningCommandlet();
+        }
+        return HostModel != 0 || GPTInstance != nullptr;
+    }
+
+    const FIGIGPTModelDesc& GetModelDesc() const { return Desc; }
+
+    float MeasureDecodeTokensPerSecond(int32 NumTokens)
+    {
+        FIGIGPTRequest Request;
+        Request.UserPrompt = TEXT("Describe the weather in a small town in detail.");
+        Request.TokensToPredict = NumTokens;
+
+        FIGIGPTTimings Timings;
+        Evaluate(Request, Timings);
+
+        // Decode rate only: prefill is everything up to the first token
+        const double DecodeMs = Timings.TotalMs - Timings.TimeToFirstTokenMs;
+        if (Timings.NumTokens < 2 || DecodeMs <= 0.0)
+        {
+            return 0.f;
+        }
+        return static_cast<float>((Timings.NumTokens - 1) * 1000.0 / DecodeMs);
+    }
+
+    FString Evaluate(const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings)
+    {
+        // In the host process the game has already resolved, chunked, budgeted and traced the request
+        if (IGIModulePtr->IsInferenceHost())
+        {
+            return EvaluateOnce(Request, OutTimings);
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+
+        FIGIFrameBudget* FrameBudget = IGIModulePtr->GetFrameBudget();
+        FrameBudget->BeginRequest(Request.Priority);
+
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        const int32 ChunkChars = FMath::Max(1, FMath::RoundToInt(Settings->PrefillChunkTokens * Settings->ApproxCharsPerToken));
+
+        FIGIGPTRequest FinalRequest = Request;
+        FString ScratchSessionPath;
+        double PrefillMs = 0.0;
+
+        // A warm session already holds the prefix, and the backend reuses it without chunking; prefilling
+        // shorter chunks into it would only overwrite the cached conversation with a partial prompt
+        const bool bWarmSession = !FinalRequest.SessionCachePath.IsEmpty() && IFileManager::Get().FileSize(*FinalRequest.SessionCachePath) > 0;
+
+        // A remote server keeps no session cache for chunks to hand over through, and Mock has nothing to prefill
+        if (Settings->bChunkedPrefill && !Remote.IsValid() && Backend != EIGIGPTBackend::Mock && !bWarmSession && FinalRequest.SystemPrompt.Len() > ChunkChars)
+        {
+            // Chunks hand KV state to each other through a scratch session, so the request's own session is
+            // only written once, by the final evaluation
+            const FString ScratchDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IGI"), TEXT("Scratch"));
+            IFileManager::Get().MakeDirectory(*ScratchDirectory, true);
+            ScratchSessionPath = FPaths::Combine(ScratchDirectory, FGuid::NewGuid().ToString() + TEXT(".kv"));
+
+            FIGIGPTRequest PrefillRequest = FinalRequest;
+            PrefillRequest.SessionCachePath = ScratchSessionPath;
+            PrefillMs = PrefillChunked(PrefillRequest, ChunkChars, FrameBudget);
+
+            if (FinalRequest.SessionCachePath.IsEmpty())
+            {
+                FinalRequest.SessionCachePath = ScratchSessionPath;
+            }
+            else if (!IFileManager::Get().Move(*FinalRequest.SessionCachePath, *ScratchSessionPath, true, true, false, true))
+            {
+                UE_LOG(LogIGISDK, Verbose, TEXT("Unable to hand the prefilled prefix to session %s; the final request prefills it again"), *FinalRequest.SessionCachePath);
+            }
+        }
+
+        FString Response;
+        if (Request.bPreemptible && FrameBudget->ShouldYield(Request.Priority))
+        {
+            OutTimings.bPreempted = true;
+        }
+        else
+        {
+            FrameBudget->WaitForSlice(Request.Priority);
+            Response = EvaluateOnce(FinalRequest, OutTimings);
+        }
+
+        OutTimings.TimeToFirstTokenMs += PrefillMs;
+        OutTimings.TotalMs += PrefillMs;
+
+        if (!ScratchSessionPath.IsEmpty())
+        {
+            IFileManager::Get().Delete(*ScratchSessionPath, false, true, true);
+        }
+
+        FrameBudget->EndRequest(Request.Priority);
+
+        FIGITraceRecorder* TraceRecorder = IGIModulePtr->GetTraceRecorder();
+        if (TraceRecorder->IsRecording())
+        {
+            TraceRecorder->Record(Desc, Request, OutTimings, StartTime, FPlatformTime::Seconds());
+        }
+
+        return Response;
+    }
+
+private:
+    /**
+     * Prefill every system prompt chunk but the last, growing the prefix one chunk at a time. Each call
+     * reuses the previous prefix from Request's session cache, so it only pays for the new chunk, and the
+     * instance lock is released between chunks so other requests can run. Request's session should be a
+     * scratch file: every chunk overwrites it.
+     */
+    double PrefillChunked(const FIGIGPTRequest& Request, int32 ChunkChars, FIGIFrameBudget* FrameBudget)
+    {
+        const FString& SystemPrompt = Request.SystemPrompt;
+        double TotalMs = 0.0;
+        int32 NumChunks = 0;
+
+        int32 ChunkEnd = 0;
+        while (SystemPrompt.Len() - ChunkEnd > ChunkChars)
+        {
+            // Break on whitespace so chunk boundaries stay close to token boundaries
+            int32 Next = ChunkEnd + ChunkChars;
+            int32 Space = Next;
+            while (Space > ChunkEnd && !FChar::IsWhitespace(SystemPrompt[Space]))
+            {
+                --Space;
+            }
+            ChunkEnd = Space > ChunkEnd ? Space : Next;
+
+            FIGIGPTRequest ChunkRequest;
+            ChunkRequest.SystemPrompt = SystemPrompt.Left(ChunkEnd);
+            ChunkRequest.SessionCachePath = Request.SessionCachePath;
+            ChunkRequest.Priority = Request.Priority;
+            ChunkRequest.Sampling = Request.Sampling;
+            // The backend only evaluates the prompt once it decodes, so ask for a single discarded token
+            ChunkRequest.TokensToPredict = 1;
+
+            if (Request.bPreemptible && FrameBudget->ShouldYield(Request.Priority))
+            {
+                break;
+            }
+            FrameBudget->WaitForSlice(Request.Priority);
+
+            FIGIGPTTimings ChunkTimings;
+            EvaluateOnce(ChunkRequest, ChunkTimings);
+
+            FrameBudget->ConsumeSlice(ChunkTimings.TotalMs);
+            TotalMs += ChunkTimings.TotalMs;
+            ++NumChunks;
+        }
+
+        UE_LOG(LogIGISDK, Verbose, TEXT("Prefilled %d chars in %d chunks, %.1f ms"), ChunkEnd, NumChunks, TotalMs);
+        return TotalMs;
+    }
+
+    FString EvaluateOnce(const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings)
     {
+        const FString& SystemPrompt = Request.SystemPrompt;
+        const FString& UserPrompt = Request.UserPrompt;
+        const FString& AssistantPrompt = Request.AssistantPrompt;
+
+        // Not under CS: the server runs concurrent requests, and they share its pooled connections
+        if (Remote.IsValid())
+        {
+            return EvaluateRemote(Request, OutTimings);
+        }
+        if (Backend == EIGIGPTBackend::Mock)
+        {
+            return IsRunningCommandlet() ? EvaluateMock(Request, OutTimings) : FString();
+        }
+
         FScopeLock Lock(&CS);
 
+        if (HostClient && HostClient->IsConnected())
+        {
+            // A restarted host has none of the previous one's models, and each generation gets one load attempt
+            if (HostGeneration != HostClient->GetGeneration())
+            {
+                LoadInHost();
+            }
+            if (HostModel != 0)
+            {
+                DestroyInProcess();
+                return HostClient->Evaluate(HostModel, Request, OutTimings);
+            }
+        }
+
+        if (GPTInstance == nullptr)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("GPT evaluate called without a valid instance"));
+            return FString();
+        }
+
         struct BasicCallbackCtx
         {
             std::mutex callbackMutex;
             std::condition_variable callbackCV;
             std::atomic<nvigi::InferenceExecutionState> callbackState = nvigi::kInferenceExecutionStateDataPending;
             FString gptOutput;
+            double startTime{ 0.0 };
+            double firstTokenTime{ 0.0 };
+            int32 numTokens{ 0 };
+            FIGIFrameBudget* frameBudget{ nullptr };
+            EIGIRequestPriority priority{ EIGIRequestPriority::Interactive };
+            bool preempted{ false };
+            const TFunction<void(const FString&)>* onChunk{ nullptr };
+            const TFunction<bool()>* shouldCancel{ nullptr };
         };
         BasicCallbackCtx cbkCtx;
+        if (Request.OnChunk && !Request.bPreemptible)
+        {
+            cbkCtx.onChunk = &Request.OnChunk;
+        }
+        if (Request.bPreemptible)
+        {
+            cbkCtx.frameBudget = IGIModulePtr->GetFrameBudget();
+            cbkCtx.priority = Request.Priority;
+        }
+        if (Request.ShouldCancel)
+        {
+            cbkCtx.shouldCancel = &Request.ShouldCancel;
+        }
 
         auto completionCallback = [](const nvigi::InferenceExecutionContext* ctx, nvigi::InferenceExecutionState state, void* data) -> nvigi::InferenceExecutionState
             {
@@ -157,6 +346,27 @@ public:
                 else
                 {
                     cbkCtx->gptOutput += response;
+                    if (cbkCtx->onChunk && !response.IsEmpty())
+                    {
+                        (*cbkCtx->onChunk)(response);
+                    }
+                }
+
+                if (!response.IsEmpty())
+                {
+                    if (cbkCtx->numTokens == 0)
+                    {
+                        cbkCtx->firstTokenTime = FPlatformTime::Seconds();
+                    }
+                    ++cbkCtx->numTokens;
+                }
+
+                // Token boundary: give way to a more important request
+                if (state == nvigi::kInferenceExecutionStateDataPending
+                    && ((cbkCtx->frameBudget && cbkCtx->frameBudget->ShouldYield(cbkCtx->priority)) || (cbkCtx->shouldCancel && (*cbkCtx->shouldCancel)())))
+                {
+                    state = nvigi::kInferenceExecutionStateCancel;
+                    cbkCtx->preempted = true;
                 }
 
                 cbkCtx->callbackState = state;
@@ -190,10 +400,27 @@ public:
 
         // Parameters
         nvigi::GPTRuntimeParameters runtime{};
-        runtime.seed = -1;
-        runtime.tokensToPredict = 200;
+        runtime.seed = Request.Sampling.Seed;
+        runtime.tokensToPredict = Request.TokensToPredict;
         runtime.interactive = false;
 
+        nvigi::GPTSamplerParameters sampler{};
+        sampler.temp = Request.Sampling.Temperature;
+        sampler.topP = Request.Sampling.TopP;
+        sampler.topK = Request.Sampling.TopK;
+
+        // Session cache: the backend reuses the KV state of the longest matching prompt prefix and saves it back
+        auto SessionCachePathUTF = StringCast<UTF8CHAR>(*Request.SessionCachePath);
+        if (!Request.SessionCachePath.IsEmpty())
+        {
+            sampler.persistentKVCache = true;
+            sampler.utf8PathToSessionCache = reinterpret_cast<const char*>(SessionCachePathUTF.Get());
+        }
+        if (runtime.chain(sampler) != nvigi::kResultOk)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("Unable to chain sampler parameters; using backend defaults and evaluating cold"));
+        }
+
         nvigi::InferenceExecutionContext gptCtx{};
         nvigi::InferenceInstance* instance = GPTInstance;
         gptCtx.instance = instance;
@@ -203,6 +430,7 @@ public:
         gptCtx.runtimeParameters = runtime;
 
         cbkCtx.callbackState = nvigi::kInferenceExecutionStateDataPending;
+        cbkCtx.startTime = FPlatformTime::Seconds();
 
         instance->evaluateAsync(&gptCtx);
 
@@ -214,31 +442,332 @@ public:
                 });
         }
 
+        const double EndTime = FPlatformTime::Seconds();
+        OutTimings.NumTokens = cbkCtx.numTokens;
+        OutTimings.bPreempted = cbkCtx.preempted;
+        OutTimings.TotalMs = (EndTime - cbkCtx.startTime) * 1000.0;
+        OutTimings.TimeToFirstTokenMs = cbkCtx.numTokens > 0 ? (cbkCtx.firstTokenTime - cbkCtx.startTime) * 1000.0 : OutTimings.TotalMs;
+
         FString response(cbkCtx.gptOutput);
 
         return response;
     }
 
-private:
+    /** Words of the prompt in an order fixed by the seed, streamed and cancelled like real tokens */
+    FString EvaluateMock(const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        TArray<FString> Words;
+        (Request.SystemPrompt + TEXT(" ") + Request.UserPrompt).ParseIntoArrayWS(Words);
+        FRandomStream Stream(Request.Sampling.Seed >= 0 ? Request.Sampling.Seed : static_cast<int32>(GetTypeHash(Request.UserPrompt)));
+
+        FIGIFrameBudget* FrameBudget = IGIModulePtr->GetFrameBudget();
+        FString Response;
+        for (int32 Token = 0; Token < Request.TokensToPredict && !Words.IsEmpty(); ++Token)
+        {
+            if ((Request.bPreemptible && FrameBudget->ShouldYield(Request.Priority)) || (Request.ShouldCancel && Request.ShouldCancel()))
+            {
+                OutTimings.bPreempted = true;
+                break;
+            }
+
+            const FString Chunk = (Token > 0 ? TEXT(" ") : TEXT("")) + Words[Stream.RandRange(0, Words.Num() - 1)];
+            Response += Chunk;
+            if (Request.OnChunk && !Request.bPreemptible)
+            {
+                Request.OnChunk(Chunk);
+            }
+            if (Token == 0)
+            {
+                OutTimings.TimeToFirstTokenMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+            }
+            ++OutTimings.NumTokens;
+        }
+
+        OutTimings.TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        if (OutTimings.NumTokens == 0)
+        {
+            OutTimings.TimeToFirstTokenMs = OutTimings.TotalMs;
+        }
+        return Response;
+    }
+
+    /** Constructed on the game thread, so the server is probed in the background and assumed reachable until it answers */
+    void CreateRemote()
+    {
+        Remote = MakeUnique<FIGIRemoteGPT>(IGIModulePtr, Desc);
+        Remote->CheckEndpoint([State = RemoteState](bool bReachable)
+            {
+                State->bReachable = bReachable;
+                if (!bReachable)
+                {
+                    State->RetryTime = FPlatformTime::Seconds() + GetDefault<UIGISettings>()->RemoteRetrySeconds;
+                }
+            });
+    }
+
+    FString EvaluateRemote(const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings)
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        if (FPlatformTime::Seconds() >= RemoteState->RetryTime)
+        {
+            FString Response;
+            if (Remote->Evaluate(Request, Response, OutTimings))
+            {
+                RemoteState->bReachable = true;
+                return Response;
+            }
+
+            UE_LOG(LogIGISDK, Warning, TEXT("Remote GPT backend failed; using local inference for %.0f s"), Settings->RemoteRetrySeconds);
+            RemoteState->bReachable = false;
+            RemoteState->RetryTime = FPlatformTime::Seconds() + Settings->RemoteRetrySeconds;
+
+            // Text already streamed to the caller can't be taken back, so a partial reply stands
+            if (OutTimings.NumTokens > 0 && Request.OnChunk && !Request.bPreemptible)
+            {
+                return Response;
+            }
+            OutTimings = FIGIGPTTimings();
+        }
+
+        FIGIGPT* Fallback = GetLocalFallback();
+        return Fallback ? Fallback->Pimpl->EvaluateOnce(Request, OutTimings) : FString();
+    }
+
+    /** True while a local fallback is loaded or can still be */
+    bool CanFallBack() const
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        return (LocalFallback.IsValid() && LocalFallback->IsValid())
+            || (!bFallbackFailed && !Settings->RemoteFallbackModelGUID.IsEmpty() && Settings->RemoteFallbackBackend != EIGIGPTBackend::Remote);
+    }
+
+    /** Loaded by the first request that can't reach the server, on the worker evaluating it */
+    FIGIGPT* GetLocalFallback()
+    {
+        FScopeLock Lock(&FallbackCS);
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        if (!LocalFallback.IsValid() && !bFallbackFailed && !Settings->RemoteFallbackModelGUID.IsEmpty() && Settings->RemoteFallbackBackend != EIGIGPTBackend::Remote)
+        {
+            FIGIGPTModelDesc FallbackDesc = Desc;
+            FallbackDesc.ModelGUID = Settings->RemoteFallbackModelGUID;
+            FallbackDesc.Backend = Settings->RemoteFallbackBackend;
+            FallbackDesc.NumThreads = FallbackDesc.Backend == EIGIGPTBackend::CPU ? FMath::Max(1, FPlatformMisc::NumberOfCores() - 2) : 1;
+
+            UE_LOG(LogIGISDK, Log, TEXT("Loading local fallback %s for remote GPT backend"), *FallbackDesc.ModelGUID);
+            LocalFallback = MakeUnique<FIGIGPT>(IGIModulePtr, FallbackDesc);
+            if (!LocalFallback->IsValid())
+            {
+                LocalFallback.Reset();
+                bFallbackFailed = true;
+            }
+        }
+        return LocalFallback.Get();
+    }
+
+    /** Create the nvigi instance in this process; called from the constructor */
+    void CreateInProcess()
+    {
+        nvigi::Result Result = nvigi::kResultOk;
+
+        IGIModulePtr->LoadIGIFeature(GetFeatureId(), &GPTInterface, nullptr);
+        if (GPTInterface == nullptr)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to load %s GPT feature for model %s"), *UEnum::GetValueAsString(Backend), *Desc.ModelGUID);
+            return;
+        }
+
+        nvigi::GPTCreationParameters params{};
+        params.contextSize = Desc.ContextSize;
+        nvigi::CommonCreationParameters common{};
+        auto ConvertedString = StringCast<UTF8CHAR>(*IGIModulePtr->GetModelsPath());
+        common.utf8PathToModels = reinterpret_cast<const char*>(ConvertedString.Get());
+        common.numThreads = Desc.NumThreads;
+        common.vramBudgetMB = Desc.VRAMBudgetMB;
+        auto ModelGUIDUTF = StringCast<UTF8CHAR>(*Desc.ModelGUID);
+        common.modelGUID = reinterpret_cast<const char*>(ModelGUIDUTF.Get());
+        Result = params.chain(common);
+        if (Result != nvigi::kResultOk)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to chain common parameters; cannot use CiG: %s"), *GetIGIStatusString(Result));
+            GPTInstance = nullptr;
+        }
+
+        nvigi::D3D12Parameters d3d12Params{};
+        if (Backend == EIGIGPTBackend::CPU)
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("GPT running on CPU backend; CiG not used"));
+        }
+        else if (IGIModulePtr->IsInferenceHost())
+        {
+            // The host runs with -nullrhi, so there is no game queue to share: CUDA time-slices with the
+            // game's frames, held back only by the game's frame budget (prefill slices and preemption)
+            UE_LOG(LogIGISDK, Log, TEXT("GPT running in the inference host; CiG not used"));
+        }
+        else if (GDynamicRHI &&
+            GDynamicRHI->GetInterfaceType() == ERHIInterfaceType::D3D12)
+        {
+            ID3D12DynamicRHI* RHI = static_cast<ID3D12DynamicRHI*>(GDynamicRHI);
+            if (RHI)
+            {
+                ID3D12CommandQueue* CmdQ = RHI->RHIGetCommandQueue();
+                constexpr uint32 RHI_DEVICE_INDEX = 0u;
+                ID3D12Device* D3D12Device = RHI->RHIGetDevice(RHI_DEVICE_INDEX);
+
+                if (CmdQ && D3D12Device)
+                {
+                    d3d12Params.device = D3D12Device;
+                    d3d12Params.queue = CmdQ;
+
+                    Result = params.chain(d3d12Params);
+                    if (Result != nvigi::kResultOk)
+                    {
+                        UE_LOG(LogIGISDK, Error, TEXT("Unable to chain D3D12 parameters; cannot use CiG: %s"), *GetIGIStatusString(Result));
+                        GPTInstance = nullptr;
+                    }
+                }
+                else
+                {
+                    UE_LOG(LogIGISDK, Error, TEXT("Unable to retrieve D3D12 device and command queue from UE; cannot use CiG: %s"), *GetIGIStatusString(Result));
+                    GPTInstance = nullptr;
+                }
+            }
+            else
+            {
+                UE_LOG(LogIGISDK, Error, TEXT("Unable to retrieve RHI instance from UE; cannot use CiG: %s"), *GetIGIStatusString(Result));
+                GPTInstance = nullptr;
+            }
+        }
+        else
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("UE not using D3D12; cannot use CiG: %s"), *GetIGIStatusString(Result));
+            GPTInstance = nullptr;
+        }
+
+        Result = GPTInterface->createInstance(params, &GPTInstance);
+        if (Result != nvigi::kResultOk)
+        {
+            // Not fatal: the hardware probe relies on failed instances to step down to a smaller variant
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to create %s GPT instance for model %s: %s"), *UEnum::GetValueAsString(Backend), *Desc.ModelGUID, *GetIGIStatusString(Result));
+            GPTInstance = nullptr;
+        }
+    }
+
+    /** Release the in-process instance once the host serves the model; called under CS */
+    void DestroyInProcess()
+    {
+        if (GPTInstance != nullptr)
+        {
+            GPTInterface->destroyInstance(GPTInstance);
+            GPTInstance = nullptr;
+        }
+        if (GPTInterface != nullptr)
+        {
+            IGIModulePtr->UnloadIGIFeature(GetFeatureId(), GPTInterface);
+            GPTInterface = nullptr;
+        }
+    }
+
+    void LoadInHost()
+    {
+        HostGeneration = HostClient->GetGeneration();
+        HostModel = HostClient->LoadModel(Desc);
+        if (HostModel == 0)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("Unable to load %s GPT model %s in the inference host"), *UEnum::GetValueAsString(Backend), *Desc.ModelGUID);
+        }
+    }
+
+    nvigi::PluginID GetFeatureId() const
+    {
+        return Backend == EIGIGPTBackend::CPU ? nvigi::plugin::gpt::ggml::cpu::kId : nvigi::plugin::gpt::ggml::cuda::kId;
+    }
+
     FCriticalSection CS;
 
+    EIGIGPTBackend Backend{ EIGIGPTBackend::CUDA };
+
     // Non-owning ptr
     FIGIModule* IGIModulePtr;
 
+    FIGIGPTModelDesc Desc;
+
     nvigi::IGeneralPurposeTransformer* GPTInterface{ nullptr };
     nvigi::InferenceInstance* GPTInstance{ nullptr };
+
+    // Remote backend, with a local model for when the server is unreachable (created under FallbackCS).
+    // The reachability state is shared with the endpoint probe, which may answer after this is gone.
+    struct FRemoteState
+    {
+        std::atomic<bool> bReachable{ true };
+        std::atomic<double> RetryTime{ 0.0 };
+    };
+    TUniquePtr<FIGIRemoteGPT> Remote;
+    TSharedRef<FRemoteState, ESPMode::ThreadSafe> RemoteState{ MakeShared<FRemoteState, ESPMode::ThreadSafe>() };
+    FCriticalSection FallbackCS;
+    TUniquePtr<FIGIGPT> LocalFallback;
+    std::atomic<bool> bFallbackFailed{ false };
+
+    // Out of process: non-owning ptr to the module's client, and the model's handle in the host generation that loaded it
+    FIGIHostClient* HostClient{ nullptr };
+    uint64 HostModel{ 0 };
+    uint32 HostGeneration{ 0 };
 };
 
 // ----------------------------------
 
 FIGIGPT::FIGIGPT(FIGIModule* IGIModule)
 {
-    Pimpl = MakePimpl<FIGIGPT::Impl>(IGIModule);
+    // The large tier's settings are the one place the default model and its budgets are defined
+    const FIGIModelTierSettings& LargeTier = GetDefault<UIGISettings>()->LargeTier;
+    FIGIGPTModelDesc ModelDesc;
+    ModelDesc.ModelGUID = LargeTier.ModelGUID;
+    ModelDesc.Backend = LargeTier.Backend;
+    ModelDesc.VRAMBudgetMB = LargeTier.VRAMBudgetMB;
+    ModelDesc.NumThreads = LargeTier.NumThreads;
+    ModelDesc.ContextSize = LargeTier.ContextSize;
+    Pimpl = MakePimpl<FIGIGPT::Impl>(IGIModule, ModelDesc);
+}
+
+FIGIGPT::FIGIGPT(FIGIModule* IGIModule, const FIGIGPTModelDesc& ModelDesc)
+{
+    Pimpl = MakePimpl<FIGIGPT::Impl>(IGIModule, ModelDesc);
 }
 
 FIGIGPT::~FIGIGPT() {}
 
+bool FIGIGPT::IsValid() const
+{
+    return Pimpl->IsValid();
+}
+
+const FIGIGPTModelDesc& FIGIGPT::GetModelDesc() const
+{
+    return Pimpl->GetModelDesc();
+}
+
 FString FIGIGPT::Evaluate(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt)
 {
-    return Pimpl->Evaluate(SystemPrompt, UserPrompt, AssistantPrompt);
+    FIGIGPTRequest Request;
+    Request.SystemPrompt = SystemPrompt;
+    Request.UserPrompt = UserPrompt;
+    Request.AssistantPrompt = AssistantPrompt;
+    return Evaluate(Request);
+}
+
+FString FIGIGPT::Evaluate(const FIGIGPTRequest& Request, FIGIGPTTimings* OutTimings)
+{
+    FIGIGPTTimings Timings;
+    FString Response = Pimpl->Evaluate(Request, Timings);
+    if (OutTimings)
+    {
+        *OutTimings = Timings;
+    }
+    return Response;
+}
+
+float FIGIGPT::MeasureDecodeTokensPerSecond(int32 NumTokens)
+{
+    return Pimpl->MeasureDecodeTokensPerSecond(NumTokens);
 }
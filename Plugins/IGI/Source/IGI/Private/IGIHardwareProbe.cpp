@@ -0,0 +1,329 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIHardwareProbe.h"
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include "Interfaces/IPluginManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "RHI.h"
+
+#include "IGIGPT.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+
+#include "nvigi.h"
+#include "nvigi_struct.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "nvigi_types.h"
+#include <intrin.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include "nvigi_types.h"
+#endif
+
+namespace
+{
+    const TCHAR* const PROBE_CONFIG_SECTION{ TEXT("IGI.HardwareProbe") };
+
+    void DetectSIMD(bool& bOutAVX2, bool& bOutAVX512)
+    {
+        bOutAVX2 = false;
+        bOutAVX512 = false;
+#if PLATFORM_WINDOWS
+        int Regs[4]{};
+        __cpuid(Regs, 0);
+        const int MaxLeaf = Regs[0];
+        if (MaxLeaf < 7)
+        {
+            return;
+        }
+
+        // AVX state must be enabled by the OS (OSXSAVE + XCR0 YMM bits)
+        __cpuid(Regs, 1);
+        const bool bOSXSave = (Regs[2] & (1 << 27)) != 0;
+        if (!bOSXSave)
+        {
+            return;
+        }
+        const unsigned long long XCR0 = _xgetbv(0);
+        const bool bYMMState = (XCR0 & 0x6) == 0x6;
+        const bool bZMMState = (XCR0 & 0xE6) == 0xE6;
+
+        __cpuidex(Regs, 7, 0);
+        bOutAVX2 = bYMMState && (Regs[1] & (1 << 5)) != 0;
+        bOutAVX512 = bZMMState && (Regs[1] & (1 << 16)) != 0;
+#endif
+    }
+
+    bool IsFeasible(const FIGIModelVariant& Variant, const FIGIHardwareInfo& Info)
+    {
+        // Any machine can use the server; whether it is reachable and fast enough is up to the benchmark
+        if (Variant.Backend == EIGIGPTBackend::Remote)
+        {
+            return !GetDefault<UIGISettings>()->RemoteEndpoint.IsEmpty();
+        }
+
+        if (Variant.Backend == EIGIGPTBackend::CUDA)
+        {
+            return Info.bHasNVIDIAAdapter && Info.VRAMMB >= Variant.MinVRAMMB;
+        }
+
+        return Info.TotalRAMMB >= Variant.MinRAMMB && (!Variant.bRequiresAVX2 || Info.bAVX2);
+    }
+
+    FIGIModelTierSettings ToTierSettings(const FIGIModelVariant& Variant, const FIGIModelTierSettings& Base, int32 NumCores)
+    {
+        FIGIModelTierSettings Settings = Base;
+        Settings.ModelGUID = Variant.ModelGUID;
+        Settings.Backend = Variant.Backend;
+        Settings.VRAMBudgetMB = Variant.VRAMBudgetMB;
+        Settings.ContextSize = Variant.ContextSize;
+        if (Variant.Backend == EIGIGPTBackend::CPU)
+        {
+            // Leave a couple of cores for the game and render threads
+            Settings.NumThreads = FMath::Max(1, NumCores - 2);
+        }
+        return Settings;
+    }
+
+    const FIGIModelVariant* FindVariant(const FIGIModelManifest& Manifest, const FString& Name)
+    {
+        return Manifest.Variants.FindByPredicate([&Name](const FIGIModelVariant& Variant) { return Variant.Name == Name; });
+    }
+
+    /** Feasible variants for a tier, best quality first */
+    TArray<const FIGIModelVariant*> GetCandidates(const FIGIModelManifest& Manifest, EIGIModelTier Tier, const FIGIHardwareInfo& Info)
+    {
+        TArray<const FIGIModelVariant*> Candidates;
+        for (const FIGIModelVariant& Variant : Manifest.Variants)
+        {
+            if ((Variant.Tier == Tier || Variant.Tier == EIGIModelTier::Auto) && IsFeasible(Variant, Info))
+            {
+                Candidates.Add(&Variant);
+            }
+        }
+        Candidates.StableSort([](const FIGIModelVariant& A, const FIGIModelVariant& B) { return A.Quality > B.Quality; });
+        return Candidates;
+    }
+
+    /** Decode rate of a variant, or a negative value if it failed to load */
+    float MeasureVariant(FIGIModule* IGIModule, const FIGIModelVariant& Variant, const FIGIHardwareInfo& Info)
+    {
+        FIGIGPTModelDesc ModelDesc;
+        ModelDesc.ModelGUID = Variant.ModelGUID;
+        ModelDesc.Backend = Variant.Backend;
+        ModelDesc.VRAMBudgetMB = Variant.VRAMBudgetMB;
+        ModelDesc.ContextSize = Variant.ContextSize;
+        ModelDesc.NumThreads = Variant.Backend == EIGIGPTBackend::CPU ? FMath::Max(1, Info.NumCores - 2) : 1;
+
+        FIGIGPT Candidate(IGIModule, ModelDesc);
+        if (!Candidate.IsValid())
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("IGI probe: %s failed to load, trying next variant"), *Variant.Name);
+            return -1.f;
+        }
+
+        const float TokensPerSecond = Candidate.MeasureDecodeTokensPerSecond(GetDefault<UIGISettings>()->BenchmarkTokens);
+        UE_LOG(LogIGISDK, Log, TEXT("IGI probe: %s decodes at %.1f tokens/s"), *Variant.Name, TokensPerSecond);
+        return TokensPerSecond;
+    }
+
+    /**
+     * Best feasible variant for a tier, benchmarked until one decodes fast enough. Rates land in
+     * Measured, so a variant serving both tiers is only loaded once.
+     */
+    const FIGIModelVariant* SelectVariant(FIGIModule* IGIModule, const FIGIModelManifest& Manifest, EIGIModelTier Tier, const FIGIHardwareInfo& Info, TMap<FString, float>& Measured)
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+
+        const FIGIModelVariant* Fallback = nullptr;
+        for (const FIGIModelVariant* Variant : GetCandidates(Manifest, Tier, Info))
+        {
+            float* TokensPerSecond = Measured.Find(Variant->Name);
+            if (!TokensPerSecond)
+            {
+                TokensPerSecond = &Measured.Add(Variant->Name, MeasureVariant(IGIModule, *Variant, Info));
+            }
+
+            if (*TokensPerSecond >= Settings->MinPlayableTokensPerSecond)
+            {
+                return Variant;
+            }
+
+            // Keep the best loadable variant in case nothing reaches the playable rate
+            if (!Fallback && *TokensPerSecond >= 0.f)
+            {
+                Fallback = Variant;
+            }
+        }
+
+        return Fallback;
+    }
+
+    void SetTier(FIGIHardwareSelection& Selection, EIGIModelTier Tier, const FIGIModelVariant* Variant, int32 NumCores)
+    {
+        if (!Variant)
+        {
+            return;
+        }
+
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        if (Tier == EIGIModelTier::Small)
+        {
+            Selection.SmallTier = ToTierSettings(*Variant, Settings->SmallTier, NumCores);
+            Selection.SmallVariant = Variant->Name;
+        }
+        else
+        {
+            Selection.LargeTier = ToTierSettings(*Variant, Settings->LargeTier, NumCores);
+            Selection.LargeVariant = Variant->Name;
+        }
+    }
+}
+
+FString FIGIHardwareInfo::GetFingerprint() const
+{
+    // RAM/VRAM are rounded to whole GB so driver reservations don't invalidate the cache
+    const FString Key = FString::Printf(TEXT("%s|%s|%d|%lld|%lld|%d|%d|%d"),
+        *CPUBrand, *GPUBrand, NumCores, TotalRAMMB / 1024, VRAMMB / 1024, bHasNVIDIAAdapter, bAVX2, bAVX512);
+    return FMD5::HashAnsiString(*Key);
+}
+
+FIGIHardwareInfo FIGIHardwareProbe::Measure(const nvigi::PluginAndSystemInformation* SystemInfo)
+{
+    FIGIHardwareInfo Info;
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    Info.TotalRAMMB = static_cast<int64>(MemoryStats.TotalPhysical / (1024 * 1024));
+    Info.AvailableRAMMB = static_cast<int64>(MemoryStats.AvailablePhysical / (1024 * 1024));
+    Info.NumCores = FPlatformMisc::NumberOfCores();
+    Info.CPUBrand = FPlatformMisc::GetCPUBrand().TrimStartAndEnd();
+    Info.GPUBrand = GRHIAdapterName.IsEmpty() ? FPlatformMisc::GetPrimaryGPUBrand() : GRHIAdapterName;
+    DetectSIMD(Info.bAVX2, Info.bAVX512);
+
+    // nvigi enumerates adapters during nvigiInit; prefer its numbers for NVIDIA hardware
+    if (SystemInfo != nullptr)
+    {
+        for (uint32 AdapterIndex = 0; AdapterIndex < SystemInfo->numDetectedAdapters; ++AdapterIndex)
+        {
+            const nvigi::AdapterSpec* Adapter = SystemInfo->detectedAdapters[AdapterIndex];
+            if (Adapter && Adapter->vendor == nvigi::VendorId::eNVDA)
+            {
+                Info.bHasNVIDIAAdapter = true;
+                Info.VRAMMB = FMath::Max(Info.VRAMMB, static_cast<int64>(Adapter->dedicatedMemoryInMB));
+            }
+        }
+    }
+
+    if (Info.VRAMMB == 0)
+    {
+        FTextureMemoryStats TextureMemoryStats;
+        RHIGetTextureMemoryStats(TextureMemoryStats);
+        Info.VRAMMB = TextureMemoryStats.DedicatedVideoMemory / (1024 * 1024);
+    }
+
+    return Info;
+}
+
+bool FIGIHardwareProbe::LoadManifest(const FString& Path, FIGIModelManifest& OutManifest, FString& OutHash)
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *Path))
+    {
+        UE_LOG(LogIGISDK, Warning, TEXT("IGI probe: unable to read model manifest %s"), *Path);
+        return false;
+    }
+
+    if (!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &OutManifest))
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI probe: unable to parse model manifest %s"), *Path);
+        return false;
+    }
+
+    OutHash = FMD5::HashAnsiString(*Json);
+    return true;
+}
+
+FIGIHardwareSelection FIGIHardwareProbe::Run(const nvigi::PluginAndSystemInformation* SystemInfo, TOptional<FIGIHardwareBenchmarkJob>& OutBenchmark)
+{
+    FIGIHardwareSelection Selection;
+
+    const UIGISettings* Settings = GetDefault<UIGISettings>();
+    if (!Settings->bRunHardwareProbe)
+    {
+        return Selection;
+    }
+
+    const FString BaseDir = IPluginManager::Get().FindPlugin("IGI")->GetBaseDir();
+    FIGIHardwareBenchmarkJob Job;
+    FString ManifestHash;
+    if (!LoadManifest(FPaths::Combine(BaseDir, Settings->ModelManifestPath), Job.Manifest, ManifestHash))
+    {
+        return Selection;
+    }
+
+    Job.Info = Measure(SystemInfo);
+    Job.Fingerprint = Job.Info.GetFingerprint() + TEXT("-") + ManifestHash;
+    Selection.Fingerprint = Job.Fingerprint;
+
+    const FIGIHardwareInfo& Info = Job.Info;
+    UE_LOG(LogIGISDK, Log, TEXT("IGI probe: RAM %lld/%lld MB, VRAM %lld MB, %d cores, AVX2 %d, AVX512 %d, NVIDIA %d"),
+        Info.AvailableRAMMB, Info.TotalRAMMB, Info.VRAMMB, Info.NumCores, Info.bAVX2, Info.bAVX512, Info.bHasNVIDIAAdapter);
+
+    FString CachedFingerprint, CachedSmall, CachedLarge;
+    GConfig->GetString(PROBE_CONFIG_SECTION, TEXT("Fingerprint"), CachedFingerprint, GGameUserSettingsIni);
+    GConfig->GetString(PROBE_CONFIG_SECTION, TEXT("SmallVariant"), CachedSmall, GGameUserSettingsIni);
+    GConfig->GetString(PROBE_CONFIG_SECTION, TEXT("LargeVariant"), CachedLarge, GGameUserSettingsIni);
+
+    if (CachedFingerprint == Job.Fingerprint)
+    {
+        SetTier(Selection, EIGIModelTier::Small, FindVariant(Job.Manifest, CachedSmall), Info.NumCores);
+        SetTier(Selection, EIGIModelTier::Large, FindVariant(Job.Manifest, CachedLarge), Info.NumCores);
+        UE_LOG(LogIGISDK, Log, TEXT("IGI probe: hardware unchanged, using cached selection (%s, %s)"), *CachedSmall, *CachedLarge);
+        return Selection;
+    }
+
+    // Until the benchmark is done, the best variant that fits on paper serves the tier
+    const TArray<const FIGIModelVariant*> SmallCandidates = GetCandidates(Job.Manifest, EIGIModelTier::Small, Info);
+    const TArray<const FIGIModelVariant*> LargeCandidates = GetCandidates(Job.Manifest, EIGIModelTier::Large, Info);
+    SetTier(Selection, EIGIModelTier::Small, SmallCandidates.IsEmpty() ? nullptr : SmallCandidates[0], Info.NumCores);
+    SetTier(Selection, EIGIModelTier::Large, LargeCandidates.IsEmpty() ? nullptr : LargeCandidates[0], Info.NumCores);
+    Selection.bProvisional = true;
+
+    UE_LOG(LogIGISDK, Log, TEXT("IGI probe: hardware changed, benchmarking in the background; meanwhile small %s, large %s"),
+        Selection.SmallVariant.IsEmpty() ? TEXT("<none>") : *Selection.SmallVariant, Selection.LargeVariant.IsEmpty() ? TEXT("<none>") : *Selection.LargeVariant);
+
+    OutBenchmark = MoveTemp(Job);
+    return Selection;
+}
+
+FIGIHardwareSelection FIGIHardwareProbe::Benchmark(FIGIModule* IGIModule, const FIGIHardwareBenchmarkJob& Job)
+{
+    FIGIHardwareSelection Selection;
+    Selection.Fingerprint = Job.Fingerprint;
+
+    TMap<FString, float> Measured;
+    SetTier(Selection, EIGIModelTier::Large, SelectVariant(IGIModule, Job.Manifest, EIGIModelTier::Large, Job.Info, Measured), Job.Info.NumCores);
+    SetTier(Selection, EIGIModelTier::Small, SelectVariant(IGIModule, Job.Manifest, EIGIModelTier::Small, Job.Info, Measured), Job.Info.NumCores);
+
+    UE_LOG(LogIGISDK, Log, TEXT("IGI probe: selected small %s, large %s"),
+        Selection.SmallVariant.IsEmpty() ? TEXT("<none>") : *Selection.SmallVariant, Selection.LargeVariant.IsEmpty() ? TEXT("<none>") : *Selection.LargeVariant);
+    return Selection;
+}
+
+void FIGIHardwareProbe::CacheSelection(const FIGIHardwareSelection& Selection)
+{
+    GConfig->SetString(PROBE_CONFIG_SECTION, TEXT("Fingerprint"), *Selection.Fingerprint, GGameUserSettingsIni);
+    GConfig->SetString(PROBE_CONFIG_SECTION, TEXT("SmallVariant"), *Selection.SmallVariant, GGameUserSettingsIni);
+    GConfig->SetString(PROBE_CONFIG_SECTION, TEXT("LargeVariant"), *Selection.LargeVariant, GGameUserSettingsIni);
+    GConfig->Flush(false, GGameUserSettingsIni);
+}
@@ -0,0 +1,272 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIHostChannel.h"
+
+#include "CoreMinimal.h"
+
+#include "IGILog.h"
+
+namespace
+{
+    constexpr uint32 CHANNEL_MAGIC{ 0x54534849 }; // "IHST"
+    constexpr uint32 CHANNEL_VERSION{ 4 };
+
+    // Marks the unused tail of a ring; the record that didn't fit starts again at offset 0
+    constexpr uint32 WRAP_MARKER{ 0xFFFFFFFF };
+    constexpr uint32 RECORD_ALIGNMENT{ 8 };
+
+    uint32 RecordBytes(int32 Size)
+    {
+        return Align(static_cast<uint32>(sizeof(uint32) + Size), RECORD_ALIGNMENT);
+    }
+
+    FString DoorbellName(const FString& Name, FIGIHostChannel::ERing Ring)
+    {
+        return Name + (Ring == FIGIHostChannel::ERing::ToHost ? TEXT("_ToHost") : TEXT("_ToGame"));
+    }
+
+    template<typename EnumType>
+    void SerializeEnum(FArchive& Ar, EnumType& Value)
+    {
+        uint8 Raw = static_cast<uint8>(Value);
+        Ar << Raw;
+        Value = static_cast<EnumType>(Raw);
+    }
+}
+
+FIGIHostChannel::~FIGIHostChannel()
+{
+    for (FPlatformProcess::FSemaphore*& Doorbell : Doorbells)
+    {
+        if (Doorbell)
+        {
+            FPlatformProcess::DeleteInterprocessSynchObject(Doorbell);
+            Doorbell = nullptr;
+        }
+    }
+    if (Region)
+    {
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+        Region = nullptr;
+    }
+}
+
+TUniquePtr<FIGIHostChannel> FIGIHostChannel::Create(const FString& Name, int32 InRingBytes)
+{
+    TUniquePtr<FIGIHostChannel> Channel(new FIGIHostChannel());
+    return Channel->Map(Name, true, InRingBytes) ? MoveTemp(Channel) : nullptr;
+}
+
+TUniquePtr<FIGIHostChannel> FIGIHostChannel::Open(const FString& Name)
+{
+    TUniquePtr<FIGIHostChannel> Channel(new FIGIHostChannel());
+    return Channel->Map(Name, false, 0) ? MoveTemp(Channel) : nullptr;
+}
+
+bool FIGIHostChannel::Map(const FString& Name, bool bCreate, int32 InRingBytes)
+{
+    const uint32 Access = FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write;
+
+    if (bCreate)
+    {
+        RingBytes = Align(static_cast<uint32>(InRingBytes), RECORD_ALIGNMENT);
+        Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, true, Access, sizeof(FSharedHeader) + 2 * RingBytes);
+        if (Region == nullptr)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: unable to create shared memory %s"), *Name);
+            return false;
+        }
+
+        Header = new (Region->GetAddress()) FSharedHeader();
+        Header->Magic = CHANNEL_MAGIC;
+        Header->Version = CHANNEL_VERSION;
+        Header->RingBytes = RingBytes;
+        Header->HostReady = 0;
+        Header->HostHeartbeat = 0;
+        for (FRingState& Ring : Header->Rings)
+        {
+            Ring.Head = 0;
+            Ring.Tail = 0;
+        }
+    }
+    else
+    {
+        // The size isn't known until the header is read, so map the header first and then the whole region
+        Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false, Access, sizeof(FSharedHeader));
+        if (Region == nullptr)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: unable to open shared memory %s"), *Name);
+            return false;
+        }
+        const FSharedHeader* Probe = static_cast<const FSharedHeader*>(Region->GetAddress());
+        if (Probe->Magic != CHANNEL_MAGIC || Probe->Version != CHANNEL_VERSION)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: shared memory %s is from a different build"), *Name);
+            return false;
+        }
+        RingBytes = Probe->RingBytes;
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+
+        Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false, Access, sizeof(FSharedHeader) + 2 * RingBytes);
+        if (Region == nullptr)
+        {
+            return false;
+        }
+        Header = static_cast<FSharedHeader*>(Region->GetAddress());
+    }
+
+    uint8* Base = static_cast<uint8*>(Region->GetAddress()) + sizeof(FSharedHeader);
+    RingData[0] = Base;
+    RingData[1] = Base + RingBytes;
+
+    for (ERing Ring : { ERing::ToHost, ERing::ToGame })
+    {
+        Doorbells[static_cast<uint8>(Ring)] = FPlatformProcess::NewInterprocessSynchObject(DoorbellName(Name, Ring), bCreate, 1);
+        if (Doorbells[static_cast<uint8>(Ring)] == nullptr)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: unable to %s doorbell for %s"), bCreate ? TEXT("create") : TEXT("open"), *Name);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FIGIHostChannel::Write(ERing Ring, const uint8* Data, int32 Size)
+{
+    const uint32 Bytes = RecordBytes(Size);
+    if (Bytes > RingBytes / 2)
+    {
+        return false;
+    }
+
+    FRingState& State = Header->Rings[static_cast<uint8>(Ring)];
+    uint8* Buffer = RingData[static_cast<uint8>(Ring)];
+
+    uint64 Head = State.Head.load(std::memory_order_relaxed);
+    const uint64 Tail = State.Tail.load(std::memory_order_acquire);
+    const uint32 Offset = static_cast<uint32>(Head % RingBytes);
+    const uint32 Contiguous = RingBytes - Offset;
+    const uint32 Needed = Contiguous >= Bytes ? Bytes : Contiguous + Bytes;
+    if (Needed > RingBytes - (Head - Tail))
+    {
+        return false;
+    }
+
+    // Records are always contiguous so the reader can use them in place
+    if (Contiguous < Bytes)
+    {
+        *reinterpret_cast<uint32*>(Buffer + Offset) = WRAP_MARKER;
+        Head += Contiguous;
+    }
+
+    uint8* Record = Buffer + Head % RingBytes;
+    *reinterpret_cast<uint32*>(Record) = static_cast<uint32>(Size);
+    FMemory::Memcpy(Record + sizeof(uint32), Data, Size);
+    State.Head.store(Head + Bytes, std::memory_order_release);
+
+    Doorbells[static_cast<uint8>(Ring)]->Unlock();
+    return true;
+}
+
+bool FIGIHostChannel::Read(ERing Ring, TFunctionRef<void(const uint8*, int32)> Visitor)
+{
+    FRingState& State = Header->Rings[static_cast<uint8>(Ring)];
+    const uint8* Buffer = RingData[static_cast<uint8>(Ring)];
+
+    uint64 Tail = State.Tail.load(std::memory_order_relaxed);
+    const uint64 Head = State.Head.load(std::memory_order_acquire);
+    if (Tail == Head)
+    {
+        return false;
+    }
+
+    uint32 Offset = static_cast<uint32>(Tail % RingBytes);
+    uint32 Size = *reinterpret_cast<const uint32*>(Buffer + Offset);
+    if (Size == WRAP_MARKER)
+    {
+        Tail += RingBytes - Offset;
+        Offset = 0;
+        Size = *reinterpret_cast<const uint32*>(Buffer);
+    }
+
+    Visitor(Buffer + Offset + sizeof(uint32), static_cast<int32>(Size));
+    State.Tail.store(Tail + RecordBytes(Size), std::memory_order_release);
+    return true;
+}
+
+bool FIGIHostChannel::IsEmpty(ERing Ring) const
+{
+    const FRingState& State = Header->Rings[static_cast<uint8>(Ring)];
+    return State.Tail.load(std::memory_order_relaxed) == State.Head.load(std::memory_order_acquire);
+}
+
+bool FIGIHostChannel::WaitForData(ERing Ring, double SpinMicroseconds, uint32 TimeoutMs)
+{
+    const double SpinUntil = FPlatformTime::Seconds() + SpinMicroseconds * 1e-6;
+    do
+    {
+        if (!IsEmpty(Ring))
+        {
+            return true;
+        }
+        FPlatformProcess::YieldCycles(64);
+    } while (FPlatformTime::Seconds() < SpinUntil);
+
+    // The doorbell only coalesces wakeups, so the ring is always rechecked afterwards
+    Doorbells[static_cast<uint8>(Ring)]->TryLock(static_cast<uint64>(TimeoutMs) * 1000000ull);
+    return !IsEmpty(Ring);
+}
+
+int32 FIGIHostChannel::GetMaxRecordSize() const
+{
+    return static_cast<int32>(RingBytes / 2 - sizeof(uint32) - RECORD_ALIGNMENT);
+}
+
+void FIGIHostChannel::Heartbeat()
+{
+    Header->HostHeartbeat.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64 FIGIHostChannel::GetHeartbeat() const
+{
+    return Header->HostHeartbeat.load(std::memory_order_relaxed);
+}
+
+void FIGIHostChannel::SetHostReady()
+{
+    Header->HostReady.store(1, std::memory_order_release);
+}
+
+bool FIGIHostChannel::IsHostReady() const
+{
+    return Header->HostReady.load(std::memory_order_acquire) != 0;
+}
+
+// ----------------------------------
+
+void SerializeModelDesc(FArchive& Ar, FIGIGPTModelDesc& Desc)
+{
+    Ar << Desc.ModelGUID;
+    SerializeEnum(Ar, Desc.Backend);
+    Ar << Desc.VRAMBudgetMB << Desc.NumThreads << Desc.ContextSize;
+}
+
+void SerializeRequest(FArchive& Ar, FIGIGPTRequest& Request)
+{
+    Ar << Request.SystemPrompt << Request.UserPrompt << Request.AssistantPrompt << Request.SessionCachePath;
+    Ar << Request.TokensToPredict;
+
+    FIGIGPTSamplingParams& Sampling = Request.Sampling;
+    Ar << Sampling.Temperature << Sampling.TopP << Sampling.TopK << Sampling.MinP;
+    Ar << Sampling.RepeatPenalty << Sampling.RepeatLastN << Sampling.FrequencyPenalty << Sampling.PresencePenalty;
+    Ar << Sampling.LogitBias << Sampling.Seed;
+
+    SerializeEnum(Ar, Request.Priority);
+}
+
+void SerializeTimings(FArchive& Ar, FIGIGPTTimings& Timings)
+{
+    Ar << Timings.TimeToFirstTokenMs << Timings.TotalMs << Timings.NumTokens << Timings.bPreempted;
+}
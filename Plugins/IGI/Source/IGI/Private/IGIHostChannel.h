@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+
+#include "IGIGPT.h"
+
+#include <atomic>
+
+/** Message kinds on the host channel; the first byte of every record */
+enum class EIGIHostMessage : uint8
+{
+    // Game to host
+    LoadModel,
+    UnloadModel,
+    Evaluate,
+    Cancel,
+    Shutdown,
+
+    // Host to game
+    ModelLoaded,
+    Chunk,
+    Completed,
+};
+
+/**
+ * Shared-memory link between the game and the inference host process.
+ *
+ * Two single-producer single-consumer byte rings, one per direction, hold length-prefixed records
+ * that are never split across the end of the ring, so a reader deserializes a record without first
+ * copying it out. Requests and replies are still serialized on both sides; nothing is shared by
+ * pointer. An interprocess semaphore per ring is the doorbell: readers spin briefly before sleeping
+ * on it, so a token crosses in microseconds while an idle link costs nothing. The header carries a
+ * heartbeat the host bumps and the game's watchdog reads.
+ *
+ * Each ring has one writer at a time; callers with several writing threads serialize them.
+ */
+class FIGIHostChannel
+{
+public:
+    enum class ERing : uint8
+    {
+        ToHost,
+        ToGame,
+    };
+
+    ~FIGIHostChannel();
+
+    /** Game side: create the shared region and doorbells */
+    static TUniquePtr<FIGIHostChannel> Create(const FString& Name, int32 RingBytes);
+
+    /** Host side: attach to a region the game created */
+    static TUniquePtr<FIGIHostChannel> Open(const FString& Name);
+
+    /** Append a record; false if the ring is full or the record can never fit */
+    bool Write(ERing Ring, const uint8* Data, int32 Size);
+
+    /** Call Visitor with the next record, in place, then release it; false if the ring is empty */
+    bool Read(ERing Ring, TFunctionRef<void(const uint8* /*Data*/, int32 /*Size*/)> Visitor);
+
+    /** Spin for SpinMicroseconds, then sleep on the doorbell for up to TimeoutMs; true if a record is ready */
+    bool WaitForData(ERing Ring, double SpinMicroseconds, uint32 TimeoutMs);
+
+    /** Largest record Write accepts */
+    int32 GetMaxRecordSize() const;
+
+    void Heartbeat();
+    uint64 GetHeartbeat() const;
+
+    void SetHostReady();
+    bool IsHostReady() const;
+
+private:
+    struct alignas(64) FRingState
+    {
+        std::atomic<uint64> Head;
+        uint8 HeadPadding[64 - sizeof(std::atomic<uint64>)];
+        std::atomic<uint64> Tail;
+        uint8 TailPadding[64 - sizeof(std::atomic<uint64>)];
+    };
+
+    struct alignas(64) FSharedHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 RingBytes;
+        std::atomic<uint32> HostReady;
+        std::atomic<uint64> HostHeartbeat;
+        FRingState Rings[2];
+    };
+
+    FIGIHostChannel() {}
+
+    bool Map(const FString& Name, bool bCreate, int32 RingBytes);
+    bool IsEmpty(ERing Ring) const;
+
+    FPlatformMemory::FSharedMemoryRegion* Region{ nullptr };
+    FSharedHeader* Header{ nullptr };
+    uint8* RingData[2]{ nullptr, nullptr };
+    uint32 RingBytes{ 0 };
+    FPlatformProcess::FSemaphore* Doorbells[2]{ nullptr, nullptr };
+};
+
+/** Field-by-field wire format of the types that cross the channel; both sides are the same build */
+void SerializeModelDesc(FArchive& Ar, FIGIGPTModelDesc& Desc);
+void SerializeRequest(FArchive& Ar, FIGIGPTRequest& Request);
+void SerializeTimings(FArchive& Ar, FIGIGPTTimings& Timings);
@@ -0,0 +1,580 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIHost.h"
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "IGIFrameBudget.h"
+#include "IGIHostChannel.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+#include "IGISettings.h"
+
+#include <atomic>
+
+namespace
+{
+    // Empty map the host boots into, so no gameplay runs there
+    constexpr const TCHAR* HOST_MAP{ TEXT("/Engine/Maps/Entry") };
+
+    // How often the watchdog checks whether a launching host has attached
+    constexpr float LAUNCH_POLL_SECONDS{ 0.01f };
+
+    // Replies are polled this long before sleeping on the doorbell while requests are in flight
+    constexpr double REPLY_SPIN_MICROSECONDS{ 50.0 };
+    constexpr uint32 REPLY_POLL_MS{ 5 };
+
+    // How often a waiting request checks whether it should be cancelled
+    constexpr uint32 CANCEL_POLL_MS{ 2 };
+
+    constexpr double STALL_CHECK_SECONDS{ 0.25 };
+    constexpr double MAX_RESTART_BACKOFF_SECONDS{ 8.0 };
+    constexpr float HOST_EXIT_WAIT_SECONDS{ 5.f };
+}
+
+class FIGIHostClient::Impl : public FRunnable
+{
+public:
+    Impl(FIGIModule* IGIModule)
+        : IGIModulePtr(IGIModule)
+    {
+    }
+
+    virtual ~Impl()
+    {
+        bStop = true;
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+        }
+
+        if (bConnected)
+        {
+            Send(EIGIHostMessage::Shutdown, 0, [](FArchive&) {});
+            const double Deadline = FPlatformTime::Seconds() + HOST_EXIT_WAIT_SECONDS;
+            while (FPlatformProcess::IsProcRunning(HostProc) && FPlatformTime::Seconds() < Deadline)
+            {
+                FPlatformProcess::Sleep(0.01f);
+            }
+        }
+        Disconnect();
+    }
+
+    bool Start()
+    {
+        const bool bLaunched = Launch();
+        if (!bLaunched)
+        {
+            OnLaunchFailed();
+        }
+        Thread = FRunnableThread::Create(this, TEXT("IGIHostWatchdog"), 0, TPri_AboveNormal);
+        return bLaunched;
+    }
+
+    bool IsAvailable() const { return bAvailable; }
+
+    bool IsConnected() const { return bConnected; }
+
+    uint32 GetGeneration() const { return Generation; }
+
+    int32 GetNumRestarts() const { return NumRestarts; }
+
+    uint64 LoadModel(const FIGIGPTModelDesc& Desc)
+    {
+        TSharedRef<FPending> Pending = MakeShared<FPending>();
+        Pending->bModelLoad = true;
+
+        FIGIGPTModelDesc SentDesc = Desc;
+        const uint64 Id = Submit(EIGIHostMessage::LoadModel, Pending, [&SentDesc](FArchive& Ar) { SerializeModelDesc(Ar, SentDesc); });
+        if (Id == 0)
+        {
+            return 0;
+        }
+
+        Pending->DoneEvent->Wait();
+        return Pending->bModelLoaded ? Id : 0;
+    }
+
+    void UnloadModel(uint64 Model)
+    {
+        if (bConnected)
+        {
+            Send(EIGIHostMessage::UnloadModel, Model, [](FArchive&) {});
+        }
+    }
+
+    FString Evaluate(uint64 Model, const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings)
+    {
+        TSharedRef<FPending> Pending = MakeShared<FPending>();
+        if (Request.OnChunk && !Request.bPreemptible)
+        {
+            Pending->OnChunk = Request.OnChunk;
+        }
+
+        FIGIGPTRequest SentRequest = Request;
+        const uint64 Id = Submit(EIGIHostMessage::Evaluate, Pending, [Model, &SentRequest](FArchive& Ar)
+            {
+                uint64 SentModel = Model;
+                Ar << SentModel;
+                SerializeRequest(Ar, SentRequest);
+            });
+        if (Id == 0)
+        {
+            return FString();
+        }
+
+        // The host can't see the game's frame budget, so preemption is decided here and sent as a cancel
+        FIGIFrameBudget* FrameBudget = IGIModulePtr->GetFrameBudget();
+        bool bCancelSent = false;
+        while (!Pending->DoneEvent->Wait(CANCEL_POLL_MS))
+        {
+            if (!bCancelSent && Request.bPreemptible && FrameBudget->ShouldYield(Request.Priority))
+            {
+                bCancelSent = Send(EIGIHostMessage::Cancel, Id, [](FArchive&) {});
+            }
+        }
+
+        OutTimings = Pending->Timings;
+        return MoveTemp(Pending->Response);
+    }
+
+    //~ Begin FRunnable
+    virtual uint32 Run() override
+    {
+        while (!bStop)
+        {
+            if (!bConnected)
+            {
+                if (LaunchingChannel.IsValid())
+                {
+                    CheckLaunch();
+                    FPlatformProcess::Sleep(LAUNCH_POLL_SECONDS);
+                }
+                else if (bAvailable && FPlatformTime::Seconds() >= NextLaunchTime)
+                {
+                    if (!Launch())
+                    {
+                        OnLaunchFailed();
+                    }
+                }
+                else
+                {
+                    FPlatformProcess::Sleep(0.05f);
+                }
+                continue;
+            }
+
+            const double SpinMicroseconds = NumPending > 0 ? REPLY_SPIN_MICROSECONDS : 0.0;
+            if (Channel->WaitForData(FIGIHostChannel::ERing::ToGame, SpinMicroseconds, REPLY_POLL_MS))
+            {
+                while (Channel->Read(FIGIHostChannel::ERing::ToGame, [this](const uint8* Data, int32 Size) { HandleReply(Data, Size); }))
+                {
+                }
+            }
+
+            CheckHost();
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStop = true;
+    }
+    //~ End FRunnable
+
+private:
+    struct FPending
+    {
+        FPending() { DoneEvent = FPlatformProcess::GetSynchEventFromPool(true); }
+        ~FPending() { FPlatformProcess::ReturnSynchEventToPool(DoneEvent); }
+
+        FEvent* DoneEvent{ nullptr };
+        FString Response;
+        FIGIGPTTimings Timings;
+        TFunction<void(const FString&)> OnChunk;
+
+        bool bModelLoad{ false };
+        bool bModelLoaded{ false };
+
+        /** Last time the host reported anything for this request; read by the watchdog */
+        std::atomic<double> LastProgressTime{ 0.0 };
+    };
+
+    /** Register Pending and send its message; returns the request id, or 0 if the host is unavailable */
+    uint64 Submit(EIGIHostMessage Type, const TSharedRef<FPending>& Pending, TFunctionRef<void(FArchive&)> Body)
+    {
+        const uint64 Id = ++NextId;
+        Pending->LastProgressTime = FPlatformTime::Seconds();
+        {
+            FScopeLock Lock(&PendingCS);
+            PendingRequests.Add(Id, Pending);
+            ++NumPending;
+        }
+
+        // Sent after registering, so a reply can't arrive for an unknown id; a failed send unregisters
+        // it again unless the watchdog already failed it when the host went away
+        if (!Send(Type, Id, Body))
+        {
+            FScopeLock Lock(&PendingCS);
+            if (PendingRequests.Remove(Id) > 0)
+            {
+                --NumPending;
+            }
+            return 0;
+        }
+        return Id;
+    }
+
+    bool Send(EIGIHostMessage Type, uint64 Id, TFunctionRef<void(FArchive&)> Body)
+    {
+        FScopeLock Lock(&SendCS);
+        if (!Channel.IsValid())
+        {
+            return false;
+        }
+
+        SendBuffer.Reset();
+        FMemoryWriter Ar(SendBuffer);
+        Ar << Type << Id;
+        Body(Ar);
+
+        if (SendBuffer.Num() > Channel->GetMaxRecordSize())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: %d byte message exceeds the channel; raise HostChannelKB"), SendBuffer.Num());
+            return false;
+        }
+
+        // A full ring means the host is behind on reading; it drains it within a poll interval unless it is hung
+        const double Deadline = FPlatformTime::Seconds() + GetDefault<UIGISettings>()->HostStallTimeoutSeconds;
+        while (!Channel->Write(FIGIHostChannel::ERing::ToHost, SendBuffer.GetData(), SendBuffer.Num()))
+        {
+            if (!bConnected || FPlatformTime::Seconds() > Deadline)
+            {
+                return false;
+            }
+            FPlatformProcess::Sleep(0.f);
+        }
+        return true;
+    }
+
+    void HandleReply(const uint8* Data, int32 Size)
+    {
+        FMemoryReaderView Ar(MakeArrayView(Data, Size));
+        EIGIHostMessage Type;
+        uint64 Id = 0;
+        Ar << Type << Id;
+
+        TSharedPtr<FPending> Pending;
+        {
+            FScopeLock Lock(&PendingCS);
+            if (Type == EIGIHostMessage::Chunk)
+            {
+                Pending = PendingRequests.FindRef(Id);
+            }
+            else if (PendingRequests.RemoveAndCopyValue(Id, Pending))
+            {
+                --NumPending;
+            }
+        }
+        if (!Pending.IsValid())
+        {
+            return;
+        }
+
+        switch (Type)
+        {
+        case EIGIHostMessage::ModelLoaded:
+        {
+            Ar << Pending->bModelLoaded;
+            Pending->DoneEvent->Trigger();
+            break;
+        }
+        case EIGIHostMessage::Chunk:
+        {
+            Pending->LastProgressTime = FPlatformTime::Seconds();
+            if (Pending->OnChunk)
+            {
+                FString Chunk;
+                Ar << Chunk;
+                Pending->OnChunk(Chunk);
+            }
+            break;
+        }
+        case EIGIHostMessage::Completed:
+        {
+            Ar << Pending->Response;
+            SerializeTimings(Ar, Pending->Timings);
+            Pending->DoneEvent->Trigger();
+            break;
+        }
+        default:
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI host: unexpected message %d"), static_cast<int32>(Type));
+            Pending->DoneEvent->Trigger();
+            break;
+        }
+    }
+
+    void CheckHost()
+    {
+        const double Now = FPlatformTime::Seconds();
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+
+        if (!FPlatformProcess::IsProcRunning(HostProc))
+        {
+            int32 ReturnCode = 0;
+            FPlatformProcess::GetProcReturnCode(HostProc, &ReturnCode);
+            OnHostLost(*FString::Printf(TEXT("exited with code %d"), ReturnCode));
+            return;
+        }
+
+        const uint64 Heartbeat = Channel->GetHeartbeat();
+        if (Heartbeat != LastHeartbeat)
+        {
+            LastHeartbeat = Heartbeat;
+            LastHeartbeatTime = Now;
+        }
+        else if (Now - LastHeartbeatTime > Settings->HostStallTimeoutSeconds)
+        {
+            OnHostLost(TEXT("stopped responding"));
+            return;
+        }
+
+        // A hung backend can leave the host's own threads alive, so requests are checked for progress too
+        if (Now - LastStallCheckTime < STALL_CHECK_SECONDS)
+        {
+            return;
+        }
+        LastStallCheckTime = Now;
+
+        bool bStalled = false;
+        {
+            FScopeLock Lock(&PendingCS);
+            for (const TPair<uint64, TSharedPtr<FPending>>& Pair : PendingRequests)
+            {
+                const double Timeout = Pair.Value->bModelLoad ? Settings->HostStartTimeoutSeconds : Settings->HostStallTimeoutSeconds;
+                if (Now - Pair.Value->LastProgressTime > Timeout)
+                {
+                    bStalled = true;
+                    break;
+                }
+            }
+        }
+        if (bStalled)
+        {
+            OnHostLost(TEXT("stalled on a request"));
+        }
+    }
+
+    bool Launch()
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        const uint32 ParentPid = FPlatformProcess::GetCurrentProcessId();
+
+        // A fresh name per launch, so a dying host can never attach to its successor's channel
+        const FString ChannelName = FString::Printf(TEXT("IGIHost_%u_%u"), ParentPid, Generation + 1);
+        TUniquePtr<FIGIHostChannel> NewChannel = FIGIHostChannel::Create(ChannelName, Settings->HostChannelKB * 1024);
+        if (!NewChannel.IsValid())
+        {
+            return false;
+        }
+
+        FString Params;
+#if WITH_EDITOR
+        Params = FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+#endif
+        const FString LogPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectLogDir(), TEXT("IGIHost.log")));
+        Params += FString::Printf(TEXT("%s -IGIHost=%s -IGIParentPid=%u -nullrhi -nosound -unattended -nosplash -abslog=\"%s\""), HOST_MAP, *ChannelName, ParentPid, *LogPath);
+
+        HostProc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, true, true, true, nullptr, 0, nullptr, nullptr);
+        if (!HostProc.IsValid())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: unable to launch %s"), FPlatformProcess::ExecutablePath());
+            return false;
+        }
+
+        // The host takes seconds to boot; the watchdog connects it once it attaches (see CheckLaunch), and
+        // until then FIGIGPT runs models in-process
+        LaunchingChannel = MoveTemp(NewChannel);
+        LaunchLogPath = LogPath;
+        LaunchDeadline = FPlatformTime::Seconds() + Settings->HostStartTimeoutSeconds;
+        return true;
+    }
+
+    /** Connect a launched host once it has attached, or give up on it */
+    void CheckLaunch()
+    {
+        if (!LaunchingChannel->IsHostReady())
+        {
+            if (!FPlatformProcess::IsProcRunning(HostProc) || FPlatformTime::Seconds() > LaunchDeadline)
+            {
+                UE_LOG(LogIGISDK, Error, TEXT("IGI host: did not start; see %s"), *LaunchLogPath);
+                LaunchingChannel.Reset();
+                FPlatformProcess::TerminateProc(HostProc, true);
+                FPlatformProcess::CloseProc(HostProc);
+                OnLaunchFailed();
+            }
+            return;
+        }
+
+        LastHeartbeat = LaunchingChannel->GetHeartbeat();
+        LastHeartbeatTime = FPlatformTime::Seconds();
+        {
+            FScopeLock Lock(&SendCS);
+            Channel = MoveTemp(LaunchingChannel);
+        }
+        ++Generation;
+        bConnected = true;
+
+        UE_LOG(LogIGISDK, Log, TEXT("IGI host attached"));
+    }
+
+    void OnLaunchFailed()
+    {
+        ++NumRestarts;
+        ScheduleRelaunch();
+    }
+
+    void OnHostLost(const TCHAR* Reason)
+    {
+        UE_LOG(LogIGISDK, Warning, TEXT("IGI host %s; failing %d in-flight requests"), Reason, NumPending.load());
+        Disconnect();
+        ++NumRestarts;
+        ScheduleRelaunch();
+    }
+
+    void ScheduleRelaunch()
+    {
+        const int32 MaxRestarts = GetDefault<UIGISettings>()->MaxHostRestarts;
+        if (NumRestarts > MaxRestarts)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: giving up after %d restarts; GPT requests will return empty"), MaxRestarts);
+            bAvailable = false;
+            return;
+        }
+        const double Backoff = FMath::Min(0.5 * (1 << FMath::Min(NumRestarts.load(), 8)), MAX_RESTART_BACKOFF_SECONDS);
+        NextLaunchTime = FPlatformTime::Seconds() + Backoff;
+    }
+
+    void Disconnect()
+    {
+        bConnected = false;
+        LaunchingChannel.Reset();
+
+        // The channel goes first: a request registered after the sweep below then fails its own send
+        {
+            FScopeLock Lock(&SendCS);
+            Channel.Reset();
+        }
+
+        TMap<uint64, TSharedPtr<FPending>> Failed;
+        {
+            FScopeLock Lock(&PendingCS);
+            Failed = MoveTemp(PendingRequests);
+            PendingRequests.Reset();
+            NumPending = 0;
+        }
+        for (const TPair<uint64, TSharedPtr<FPending>>& Pair : Failed)
+        {
+            Pair.Value->DoneEvent->Trigger();
+        }
+
+        if (HostProc.IsValid())
+        {
+            FPlatformProcess::TerminateProc(HostProc, true);
+            FPlatformProcess::CloseProc(HostProc);
+        }
+    }
+
+    // Non-owning ptr
+    FIGIModule* IGIModulePtr;
+
+    FRunnableThread* Thread{ nullptr };
+    FProcHandle HostProc;
+
+    // Replaced only by the watchdog thread; senders use it under SendCS
+    TUniquePtr<FIGIHostChannel> Channel;
+    FCriticalSection SendCS;
+    TArray<uint8> SendBuffer;
+
+    FCriticalSection PendingCS;
+    TMap<uint64, TSharedPtr<FPending>> PendingRequests;
+    std::atomic<int32> NumPending{ 0 };
+    std::atomic<uint64> NextId{ 0 };
+
+    std::atomic<bool> bStop{ false };
+    std::atomic<bool> bConnected{ false };
+    std::atomic<bool> bAvailable{ true };
+    std::atomic<uint32> Generation{ 0 };
+    std::atomic<int32> NumRestarts{ 0 };
+
+    // Watchdog thread only (or Start, before it runs)
+    TUniquePtr<FIGIHostChannel> LaunchingChannel;
+    FString LaunchLogPath;
+    double LaunchDeadline{ 0.0 };
+    uint64 LastHeartbeat{ 0 };
+    double LastHeartbeatTime{ 0.0 };
+    double LastStallCheckTime{ 0.0 };
+    double NextLaunchTime{ 0.0 };
+};
+
+// ----------------------------------
+
+FIGIHostClient::FIGIHostClient(FIGIModule* IGIModule)
+{
+    Pimpl = MakePimpl<FIGIHostClient::Impl>(IGIModule);
+}
+
+FIGIHostClient::~FIGIHostClient()
+{
+}
+
+bool FIGIHostClient::Start()
+{
+    return Pimpl->Start();
+}
+
+bool FIGIHostClient::IsAvailable() const
+{
+    return Pimpl->IsAvailable();
+}
+
+bool FIGIHostClient::IsConnected() const
+{
+    return Pimpl->IsConnected();
+}
+
+uint32 FIGIHostClient::GetGeneration() const
+{
+    return Pimpl->GetGeneration();
+}
+
+int32 FIGIHostClient::GetNumRestarts() const
+{
+    return Pimpl->GetNumRestarts();
+}
+
+uint64 FIGIHostClient::LoadModel(const FIGIGPTModelDesc& Desc)
+{
+    return Pimpl->LoadModel(Desc);
+}
+
+void FIGIHostClient::UnloadModel(uint64 Model)
+{
+    Pimpl->UnloadModel(Model);
+}
+
+FString FIGIHostClient::Evaluate(uint64 Model, const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings)
+{
+    return Pimpl->Evaluate(Model, Request, OutTimings);
+}
@@ -0,0 +1,300 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIHostServer.h"
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "IGIGPT.h"
+#include "IGIHostChannel.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+
+#include <atomic>
+
+namespace
+{
+    // Requests are polled this long before sleeping on the doorbell; the game spins on its side too
+    constexpr double REQUEST_SPIN_MICROSECONDS{ 50.0 };
+
+    // Also the heartbeat period
+    constexpr uint32 REQUEST_POLL_MS{ 10 };
+}
+
+class FIGIHostServer::Impl : public FRunnable
+{
+public:
+    Impl(FIGIModule* IGIModule, const FString& ChannelName, uint32 ParentPid)
+        : IGIModulePtr(IGIModule)
+    {
+        Channel = FIGIHostChannel::Open(ChannelName);
+        ParentProc = FPlatformProcess::OpenProcess(ParentPid);
+        if (!Channel.IsValid() || !ParentProc.IsValid())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: unable to attach to %s of process %u"), *ChannelName, ParentPid);
+            RequestExit();
+            return;
+        }
+
+        Thread = FRunnableThread::Create(this, TEXT("IGIHostServer"), 0, TPri_AboveNormal);
+    }
+
+    virtual ~Impl()
+    {
+        bStop = true;
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+        }
+
+        // Evaluations stop at their next token; the models must outlive them
+        {
+            FScopeLock Lock(&CS);
+            for (const TPair<uint64, TSharedPtr<std::atomic<bool>>>& Pair : CancelFlags)
+            {
+                *Pair.Value = true;
+            }
+        }
+        while (NumInFlight > 0)
+        {
+            FPlatformProcess::Sleep(0.01f);
+        }
+
+        FScopeLock Lock(&CS);
+        Models.Reset();
+        if (ParentProc.IsValid())
+        {
+            FPlatformProcess::CloseProc(ParentProc);
+        }
+    }
+
+    //~ Begin FRunnable
+    virtual uint32 Run() override
+    {
+        Channel->SetHostReady();
+        UE_LOG(LogIGISDK, Log, TEXT("IGI host ready"));
+
+        while (!bStop)
+        {
+            Channel->Heartbeat();
+
+            if (!FPlatformProcess::IsProcRunning(ParentProc))
+            {
+                UE_LOG(LogIGISDK, Log, TEXT("IGI host: game process is gone"));
+                RequestExit();
+                break;
+            }
+
+            if (Channel->WaitForData(FIGIHostChannel::ERing::ToHost, NumInFlight > 0 ? REQUEST_SPIN_MICROSECONDS : 0.0, REQUEST_POLL_MS))
+            {
+                while (!bStop && Channel->Read(FIGIHostChannel::ERing::ToHost, [this](const uint8* Data, int32 Size) { HandleRequest(Data, Size); }))
+                {
+                }
+            }
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStop = true;
+    }
+    //~ End FRunnable
+
+private:
+    void HandleRequest(const uint8* Data, int32 Size)
+    {
+        FMemoryReaderView Ar(MakeArrayView(Data, Size));
+        EIGIHostMessage Type;
+        uint64 Id = 0;
+        Ar << Type << Id;
+
+        switch (Type)
+        {
+        case EIGIHostMessage::LoadModel:
+        {
+            FIGIGPTModelDesc Desc;
+            SerializeModelDesc(Ar, Desc);
+            RunAsync([this, Id, Desc = MoveTemp(Desc)]() { LoadModel(Id, Desc); });
+            break;
+        }
+        case EIGIHostMessage::UnloadModel:
+        {
+            FIGIGPTPtr Model;
+            {
+                FScopeLock Lock(&CS);
+                Models.RemoveAndCopyValue(Id, Model);
+            }
+            // Destroying an instance takes a while, so not on this thread
+            if (Model.IsValid())
+            {
+                RunAsync([Model = MoveTemp(Model)]() mutable { Model.Reset(); });
+            }
+            break;
+        }
+        case EIGIHostMessage::Evaluate:
+        {
+            uint64 ModelId = 0;
+            FIGIGPTRequest Request;
+            Ar << ModelId;
+            SerializeRequest(Ar, Request);
+
+            TSharedPtr<std::atomic<bool>> CancelFlag = MakeShared<std::atomic<bool>>(false);
+            {
+                FScopeLock Lock(&CS);
+                CancelFlags.Add(Id, CancelFlag);
+            }
+            RunAsync([this, Id, ModelId, Request = MoveTemp(Request), CancelFlag]() mutable { Evaluate(Id, ModelId, Request, CancelFlag); });
+            break;
+        }
+        case EIGIHostMessage::Cancel:
+        {
+            FScopeLock Lock(&CS);
+            if (const TSharedPtr<std::atomic<bool>>* CancelFlag = CancelFlags.Find(Id))
+            {
+                **CancelFlag = true;
+            }
+            break;
+        }
+        case EIGIHostMessage::Shutdown:
+            UE_LOG(LogIGISDK, Log, TEXT("IGI host: shutdown requested"));
+            RequestExit();
+            bStop = true;
+            break;
+        default:
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI host: unexpected message %d"), static_cast<int32>(Type));
+            break;
+        }
+    }
+
+    void LoadModel(uint64 Id, const FIGIGPTModelDesc& Desc)
+    {
+        FIGIGPTPtr Model = MakeShared<FIGIGPT, ESPMode::ThreadSafe>(IGIModulePtr, Desc);
+        bool bLoaded = Model->IsValid();
+
+        if (bLoaded)
+        {
+            FScopeLock Lock(&CS);
+            Models.Add(Id, Model);
+        }
+
+        Reply(EIGIHostMessage::ModelLoaded, Id, [&bLoaded](FArchive& Ar) { Ar << bLoaded; });
+    }
+
+    void Evaluate(uint64 Id, uint64 ModelId, FIGIGPTRequest& Request, const TSharedPtr<std::atomic<bool>>& CancelFlag)
+    {
+        FIGIGPTPtr Model;
+        {
+            FScopeLock Lock(&CS);
+            Model = Models.FindRef(ModelId);
+        }
+
+        FString Response;
+        FIGIGPTTimings Timings;
+        if (Model.IsValid())
+        {
+            // Every token goes back, whether or not the game streams it: it is what tells the watchdog the request is alive
+            Request.OnChunk = [this, Id](const FString& Chunk)
+                {
+                    FString Sent = Chunk;
+                    Reply(EIGIHostMessage::Chunk, Id, [&Sent](FArchive& Ar) { Ar << Sent; });
+                };
+            Request.ShouldCancel = [CancelFlag]() { return CancelFlag->load(); };
+            Response = Model->Evaluate(Request, &Timings);
+        }
+        else
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: evaluate on unknown model %llu"), ModelId);
+        }
+
+        {
+            FScopeLock Lock(&CS);
+            CancelFlags.Remove(Id);
+        }
+
+        Reply(EIGIHostMessage::Completed, Id, [&Response, &Timings](FArchive& Ar)
+            {
+                Ar << Response;
+                SerializeTimings(Ar, Timings);
+            });
+    }
+
+    void Reply(EIGIHostMessage Type, uint64 Id, TFunctionRef<void(FArchive&)> Body)
+    {
+        FScopeLock Lock(&ReplyCS);
+
+        ReplyBuffer.Reset();
+        FMemoryWriter Ar(ReplyBuffer);
+        Ar << Type << Id;
+        Body(Ar);
+
+        if (ReplyBuffer.Num() > Channel->GetMaxRecordSize())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI host: %d byte reply exceeds the channel"), ReplyBuffer.Num());
+            return;
+        }
+
+        // The game's watchdog drains replies continuously; if it stops, the game is gone and so are we
+        while (!Channel->Write(FIGIHostChannel::ERing::ToGame, ReplyBuffer.GetData(), ReplyBuffer.Num()))
+        {
+            if (bStop)
+            {
+                return;
+            }
+            FPlatformProcess::Sleep(0.f);
+        }
+    }
+
+    /** Loads and evaluations block for seconds, so each gets a thread rather than a pool worker */
+    void RunAsync(TUniqueFunction<void()>&& Work)
+    {
+        ++NumInFlight;
+        Async(EAsyncExecution::Thread, [this, Work = MoveTemp(Work)]() mutable
+            {
+                Work();
+                --NumInFlight;
+            });
+    }
+
+    static void RequestExit()
+    {
+        AsyncTask(ENamedThreads::GameThread, []() { RequestEngineExit(TEXT("IGI host shutting down")); });
+    }
+
+    // Non-owning ptr
+    FIGIModule* IGIModulePtr;
+
+    TUniquePtr<FIGIHostChannel> Channel;
+    FProcHandle ParentProc;
+    FRunnableThread* Thread{ nullptr };
+    std::atomic<bool> bStop{ false };
+    std::atomic<int32> NumInFlight{ 0 };
+
+    // Guards Models and CancelFlags
+    FCriticalSection CS;
+    TMap<uint64, FIGIGPTPtr> Models;
+    TMap<uint64, TSharedPtr<std::atomic<bool>>> CancelFlags;
+
+    // Serializes writers of the reply ring, which has a single producer slot
+    FCriticalSection ReplyCS;
+    TArray<uint8> ReplyBuffer;
+};
+
+// ----------------------------------
+
+FIGIHostServer::FIGIHostServer(FIGIModule* IGIModule, const FString& ChannelName, uint32 ParentPid)
+{
+    Pimpl = MakePimpl<FIGIHostServer::Impl>(IGIModule, ChannelName, ParentPid);
+}
+
+FIGIHostServer::~FIGIHostServer()
+{
+}
@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+class FIGIModule;
+
+/**
+ * Host side of out-of-process inference, run by a game executable started with -IGIHost=<Channel>.
+ *
+ * Attaches to the channel the game created, loads models and evaluates requests on their own
+ * threads, streaming every token back so the game's watchdog sees progress. Exits when the game
+ * asks it to or when the parent process is gone.
+ */
+class FIGIHostServer
+{
+public:
+    FIGIHostServer(FIGIModule* IGIModule, const FString& ChannelName, uint32 ParentPid);
+    virtual ~FIGIHostServer();
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
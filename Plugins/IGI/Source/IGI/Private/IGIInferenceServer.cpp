@@ -0,0 +1,549 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIInferenceServer.h"
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+
+#include "IGIFrameBudget.h"
+#include "IGIKVCacheManager.h"
+#include "IGILog.h"
+#include "IGIModelRegistry.h"
+#include "IGIModule.h"
+#include "IGISettings.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace
+{
+    // Aggregate tokens/s is measured over this trailing window
+    constexpr double THROUGHPUT_WINDOW_SECONDS{ 10.0 };
+
+    // While every queued sequence is held back by more important work, re-check this often
+    constexpr double BLOCKED_POLL_SECONDS{ 0.05 };
+
+    FAutoConsoleCommand ServerStatsCommand(
+        TEXT("IGI.Server.Stats"),
+        TEXT("Print inference server throughput and load."),
+        FConsoleCommandDelegate::CreateLambda([]()
+            {
+                const FIGIInferenceServerMetrics Metrics = FIGIModule::Get().GetInferenceServer()->GetMetrics();
+                UE_LOG(LogIGISDK, Display, TEXT("IGI server: %d slots, %d active, %d queued, %lld completed, %lld preempted, %lld tokens, %.1f tokens/s, %.1f ms mean queue wait"),
+                    Metrics.NumSlots, Metrics.ActiveSequences, Metrics.QueuedSequences, Metrics.CompletedSequences, Metrics.PreemptedSequences, Metrics.GeneratedTokens,
+                    Metrics.TokensPerSecond, Metrics.MeanQueueWaitMs);
+            }));
+
+    struct FSequence
+    {
+        FIGIGPTRequest Request;
+        FString SessionId;
+        FIGIInferenceCallback OnComplete;
+        double EnqueueTime{ 0.0 };
+
+        /** Class the sequence was submitted with; Request.Priority holds the aged class while it runs */
+        EIGIRequestPriority Priority{ EIGIRequestPriority::Interactive };
+    };
+
+    class FPool;
+
+    /** One sequence at a time on one instance */
+    class FSlot : public FRunnable
+    {
+    public:
+        FSlot(FPool* InPool, int32 InIndex);
+        virtual ~FSlot();
+
+        //~ Begin FRunnable
+        virtual uint32 Run() override;
+        //~ End FRunnable
+
+    private:
+        FIGIGPTPtr AcquireInstance();
+        void ReleaseOwned();
+
+        FPool* Pool;
+        int32 Index;
+        FString ContextKey;
+        FIGIGPTPtr Owned;
+        FRunnableThread* Thread{ nullptr };
+    };
+
+    /** Slots and queue for the model serving one tier */
+    class FPool
+    {
+    public:
+        FPool(FIGIModule* IGIModule, EIGIModelTier InTier, int32 NumSlots)
+            : IGIModulePtr(IGIModule)
+            , Tier(InTier)
+            , NumSlotsToLoad(NumSlots)
+        {
+            KVCache = IGIModulePtr->GetKVCacheManager();
+            FrameBudget = IGIModulePtr->GetFrameBudget();
+            StartTime = FPlatformTime::Seconds();
+            for (int32 Index = 0; Index < NumSlots; ++Index)
+            {
+                Slots.Add(MakeUnique<FSlot>(this, Index));
+            }
+        }
+
+        ~FPool()
+        {
+            {
+                std::scoped_lock Lock(Mutex);
+                bStop = true;
+            }
+            CV.notify_all();
+            Slots.Empty();
+
+            for (FSequence& Sequence : Queue)
+            {
+                FrameBudget->RemoveQueued(Sequence.Priority, Sequence.EnqueueTime);
+                Sequence.OnComplete(FString(), FIGIGPTTimings());
+            }
+        }
+
+        void Enqueue(FSequence&& Sequence)
+        {
+            bool bQueued = false;
+            {
+                std::scoped_lock Lock(Mutex);
+                if (!bFailed)
+                {
+                    // Registered under the lock so a running sequence sees it at its next token boundary
+                    FrameBudget->AddQueued(Sequence.Priority, Sequence.EnqueueTime);
+                    Queue.Add(MoveTemp(Sequence));
+                    bQueued = true;
+                }
+            }
+            if (!bQueued)
+            {
+                // No slot is left to run it
+                Sequence.OnComplete(FString(), FIGIGPTTimings());
+                return;
+            }
+            CV.notify_one();
+        }
+
+        /** A slot gave up loading; once none is left, everything queued fails rather than wait forever */
+        void OnSlotFailed()
+        {
+            TArray<FSequence> Orphans;
+            {
+                std::scoped_lock Lock(Mutex);
+                if (++NumFailedSlots < NumSlotsToLoad)
+                {
+                    return;
+                }
+
+                UE_LOG(LogIGISDK, Error, TEXT("IGI: no inference slot for %s tier could load its model; failing %d queued sequences"), *UEnum::GetValueAsString(Tier), Queue.Num());
+                bFailed = true;
+                Orphans = MoveTemp(Queue);
+                Queue.Reset();
+                for (const FSequence& Orphan : Orphans)
+                {
+                    FrameBudget->RemoveQueued(Orphan.Priority, Orphan.EnqueueTime);
+                }
+            }
+
+            for (FSequence& Orphan : Orphans)
+            {
+                Orphan.OnComplete(FString(), FIGIGPTTimings());
+            }
+        }
+
+        bool IsFailed() const
+        {
+            std::scoped_lock Lock(Mutex);
+            return bFailed;
+        }
+
+        bool Dequeue(FSequence& OutSequence)
+        {
+            std::unique_lock Lock(Mutex);
+
+            int32 Next = INDEX_NONE;
+            EIGIRequestPriority NextPriority = EIGIRequestPriority::Interactive;
+            while (!bStop && (Next = PickNext(NextPriority)) == INDEX_NONE)
+            {
+                // Nothing is notified when the more important work elsewhere finishes, so poll while blocked
+                if (Queue.IsEmpty())
+                {
+                    CV.wait(Lock);
+                }
+                else
+                {
+                    CV.wait_for(Lock, std::chrono::duration<double>(BLOCKED_POLL_SECONDS));
+                }
+            }
+            if (bStop)
+            {
+                return false;
+            }
+
+            OutSequence = MoveTemp(Queue[Next]);
+            Queue.RemoveAt(Next);
+            FrameBudget->RemoveQueued(OutSequence.Priority, OutSequence.EnqueueTime);
+            OutSequence.Request.Priority = NextPriority;
+
+            const double Now = FPlatformTime::Seconds();
+            if (!OutSequence.SessionId.IsEmpty())
+            {
+                ActiveSessions.Add(OutSequence.SessionId);
+                LastServed.Add(OutSequence.SessionId, Now);
+            }
+            QueueWaitMs += (Now - OutSequence.EnqueueTime) * 1000.0;
+            ++Started;
+            ++Active;
+            return true;
+        }
+
+        void Complete(const FSequence& Sequence, const FIGIGPTTimings& Timings)
+        {
+            {
+                std::scoped_lock Lock(Mutex);
+                ActiveSessions.Remove(Sequence.SessionId);
+                --Active;
+                ++Completed;
+                GeneratedTokens += Timings.NumTokens;
+
+                const double Now = FPlatformTime::Seconds();
+                Window.Add({ Now, Timings.NumTokens });
+                Window.RemoveAll([Now](const TPair<double, int32>& Sample) { return Now - Sample.Key > THROUGHPUT_WINDOW_SECONDS; });
+            }
+
+            // Another sequence of the same session may be runnable now
+            CV.notify_all();
+        }
+
+        /** Put a preempted sequence back; it keeps its enqueue time, so it keeps aging */
+        void Requeue(FSequence&& Sequence)
+        {
+            {
+                std::scoped_lock Lock(Mutex);
+                ActiveSessions.Remove(Sequence.SessionId);
+                --Active;
+                ++Preempted;
+
+                Sequence.Request.Priority = Sequence.Priority;
+                FrameBudget->AddQueued(Sequence.Priority, Sequence.EnqueueTime);
+                Queue.Add(MoveTemp(Sequence));
+            }
+            CV.notify_all();
+        }
+
+        void AddMetrics(FIGIInferenceServerMetrics& Total, double& TotalQueueWaitMs, int64& TotalStarted) const
+        {
+            std::scoped_lock Lock(Mutex);
+
+            Total.NumSlots += NumReadySlots.load();
+            Total.ActiveSequences += Active;
+            Total.QueuedSequences += Queue.Num();
+            Total.CompletedSequences += Completed;
+            Total.PreemptedSequences += Preempted;
+            Total.GeneratedTokens += GeneratedTokens;
+
+            const double Now = FPlatformTime::Seconds();
+            const double Span = FMath::Min(THROUGHPUT_WINDOW_SECONDS, Now - StartTime);
+            int64 WindowTokens = 0;
+            for (const TPair<double, int32>& Sample : Window)
+            {
+                if (Now - Sample.Key <= THROUGHPUT_WINDOW_SECONDS)
+                {
+                    WindowTokens += Sample.Value;
+                }
+            }
+            Total.TokensPerSecond += Span > 0.0 ? WindowTokens / Span : 0.0;
+
+            TotalQueueWaitMs += QueueWaitMs;
+            TotalStarted += Started;
+        }
+
+        // Non-owning ptrs
+        FIGIModule* IGIModulePtr;
+        FIGIKVCacheManager* KVCache{ nullptr };
+        FIGIFrameBudget* FrameBudget{ nullptr };
+
+        const EIGIModelTier Tier;
+        const int32 NumSlotsToLoad;
+        std::atomic<int32> NumReadySlots{ 0 };
+
+    private:
+        /**
+         * Most important first after aging, then the session served least recently, then oldest. Busy
+         * sessions wait, as does preemptible work that would yield straight away.
+         */
+        int32 PickNext(EIGIRequestPriority& OutPriority) const
+        {
+            int32 Best = INDEX_NONE;
+            EIGIRequestPriority BestPriority = EIGIRequestPriority::Interactive;
+            double BestLastServed = 0.0;
+            for (int32 Index = 0; Index < Queue.Num(); ++Index)
+            {
+                const FSequence& Candidate = Queue[Index];
+                if (!Candidate.SessionId.IsEmpty() && ActiveSessions.Contains(Candidate.SessionId))
+                {
+                    continue;
+                }
+
+                const EIGIRequestPriority CandidatePriority = FrameBudget->GetAgedPriority(Candidate.Priority, Candidate.EnqueueTime);
+                if (Candidate.Request.bPreemptible && FrameBudget->ShouldYield(CandidatePriority))
+                {
+                    continue;
+                }
+
+                // Sessions never served yet go first; requests without a session are ranked by arrival
+                const double* Served = Candidate.SessionId.IsEmpty() ? &Candidate.EnqueueTime : LastServed.Find(Candidate.SessionId);
+                const double CandidateLastServed = Served ? *Served : 0.0;
+                if (Best == INDEX_NONE
+                    || CandidatePriority < BestPriority
+                    || (CandidatePriority == BestPriority && CandidateLastServed < BestLastServed))
+                {
+                    Best = Index;
+                    BestPriority = CandidatePriority;
+                    BestLastServed = CandidateLastServed;
+                }
+            }
+            OutPriority = BestPriority;
+            return Best;
+        }
+
+        mutable std::mutex Mutex;
+        std::condition_variable CV;
+        bool bStop{ false };
+
+        // Every slot failed to load; new sequences complete straight away with an empty response
+        int32 NumFailedSlots{ 0 };
+        bool bFailed{ false };
+
+        TArray<FSequence> Queue;
+        TSet<FString> ActiveSessions;
+        TMap<FString, double> LastServed;
+
+        int32 Active{ 0 };
+        int64 Started{ 0 };
+        int64 Completed{ 0 };
+        int64 Preempted{ 0 };
+        int64 GeneratedTokens{ 0 };
+        double QueueWaitMs{ 0.0 };
+        double StartTime{ 0.0 };
+        TArray<TPair<double, int32>> Window;
+
+        TArray<TUniquePtr<FSlot>> Slots;
+    };
+
+    FSlot::FSlot(FPool* InPool, int32 InIndex)
+        : Pool(InPool)
+        , Index(InIndex)
+    {
+        Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("IGIInferenceSlot%d"), Index));
+    }
+
+    FSlot::~FSlot()
+    {
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+        }
+        ReleaseOwned();
+    }
+
+    uint32 FSlot::Run()
+    {
+        // Load up front so the first sequence doesn't pay for it
+        FIGIGPTPtr Initial = AcquireInstance();
+        if (!Initial.IsValid() || !Initial->IsValid() || (Index > 0 && !Owned.IsValid()))
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI: inference slot %d for %s tier failed to load; serving with fewer slots"), Index, *UEnum::GetValueAsString(Pool->Tier));
+            Pool->OnSlotFailed();
+            return 0;
+        }
+        Initial.Reset();
+        ++Pool->NumReadySlots;
+
+        FSequence Sequence;
+        while (Pool->Dequeue(Sequence))
+        {
+            // Resolved per sequence, so a hot-swapped model takes over at the next sequence boundary
+            FIGIGPTPtr GPT = AcquireInstance();
+
+            FIGIGPTRequest Request = Sequence.Request;
+            if (!Sequence.SessionId.IsEmpty() && GPT.IsValid())
+            {
+                Request.SessionCachePath = Pool->KVCache->AcquireSession(Sequence.SessionId, GPT->GetModelDesc().ModelGUID);
+            }
+
+            FIGIGPTTimings Timings;
+            const FString Response = (GPT.IsValid() && GPT->IsValid()) ? GPT->Evaluate(Request, &Timings) : FString();
+
+            if (!Sequence.SessionId.IsEmpty() && GPT.IsValid())
+            {
+                Pool->KVCache->ReleaseSession(Sequence.SessionId);
+            }
+
+            // Gave way to a more important request at a token boundary; run it again from the start later
+            if (Timings.bPreempted)
+            {
+                Pool->Requeue(MoveTemp(Sequence));
+                continue;
+            }
+
+            Pool->Complete(Sequence, Timings);
+            Sequence.OnComplete(Response, Timings);
+        }
+
+        --Pool->NumReadySlots;
+        return 0;
+    }
+
+    FIGIGPTPtr FSlot::AcquireInstance()
+    {
+        // Slot 0 shares the registry's instance; the others load their own copy of the same model
+        FIGIGPTPtr Shared = Pool->IGIModulePtr->GetModelRegistry()->GetGPT(Pool->Tier);
+        if (Index == 0 || !Shared.IsValid() || !Shared->IsValid())
+        {
+            return Shared;
+        }
+
+        const FIGIGPTModelDesc& SharedDesc = Shared->GetModelDesc();
+        if (Owned.IsValid() && Owned->GetModelDesc().ModelGUID == SharedDesc.ModelGUID && Owned->GetModelDesc().Backend == SharedDesc.Backend)
+        {
+            return Owned;
+        }
+
+        // The tier switched models; free this slot's copy before loading the new one
+        ReleaseOwned();
+
+        FIGIGPTModelDesc Desc = SharedDesc;
+        ContextKey = FString::Printf(TEXT("%s@%s#%d"), *Desc.ModelGUID, *UEnum::GetValueAsString(Desc.Backend), Index);
+        Desc.ContextSize = Pool->KVCache->ReserveModelContext(ContextKey, Desc.ContextSize);
+
+        Owned = MakeShared<FIGIGPT, ESPMode::ThreadSafe>(Pool->IGIModulePtr, Desc);
+        if (!Owned->IsValid())
+        {
+            ReleaseOwned();
+            return Shared;
+        }
+        return Owned;
+    }
+
+    void FSlot::ReleaseOwned()
+    {
+        if (Owned.IsValid())
+        {
+            Owned.Reset();
+            Pool->KVCache->ReleaseModelContext(ContextKey);
+        }
+    }
+}
+
+class FIGIInferenceServer::Impl
+{
+public:
+    Impl(FIGIModule* IGIModule)
+        : IGIModulePtr(IGIModule)
+    {
+        NumSlotsPerModel = FMath::Max(1, GetDefault<UIGISettings>()->InferenceSlotsPerModel);
+    }
+
+    virtual ~Impl()
+    {
+        TArray<TUniquePtr<FPool>> OldPools;
+        {
+            FScopeLock Lock(&CS);
+            for (TPair<EIGIModelTier, TUniquePtr<FPool>>& Pair : Pools)
+            {
+                OldPools.Add(MoveTemp(Pair.Value));
+            }
+            Pools.Empty();
+            OldPools.Append(MoveTemp(FailedPools));
+        }
+
+        // Each pool joins its workers and completes whatever is still queued with an empty response
+        OldPools.Empty();
+    }
+
+    void Submit(EIGIModelTier Tier, const FIGIGPTRequest& Request, const FString& SessionId, FIGIInferenceCallback&& OnComplete)
+    {
+        const int32 PromptLength = Request.SystemPrompt.Len() + Request.UserPrompt.Len() + Request.AssistantPrompt.Len();
+        const EIGIModelTier ResolvedTier = IGIModulePtr->GetModelRegistry()->SelectTier(Tier, PromptLength);
+
+        FPool* Pool = nullptr;
+        {
+            FScopeLock Lock(&CS);
+            // A pool whose slots all failed gets another try, in case the tier has been swapped to a model that loads.
+            // The failed one is kept until shutdown: another submit may still hold it.
+            TUniquePtr<FPool>& Existing = Pools.FindOrAdd(ResolvedTier);
+            if (Existing.IsValid() && Existing->IsFailed())
+            {
+                FailedPools.Add(MoveTemp(Existing));
+            }
+            if (!Existing.IsValid())
+            {
+                Existing = MakeUnique<FPool>(IGIModulePtr, ResolvedTier, NumSlotsPerModel);
+            }
+            Pool = Existing.Get();
+        }
+
+        FSequence Sequence;
+        Sequence.Request = Request;
+        Sequence.SessionId = SessionId;
+        Sequence.OnComplete = MoveTemp(OnComplete);
+        Sequence.EnqueueTime = FPlatformTime::Seconds();
+        Sequence.Priority = Request.Priority;
+        // Only the player's own conversation runs to completion regardless of what else arrives
+        Sequence.Request.bPreemptible = Request.bPreemptible || Request.Priority != EIGIRequestPriority::Interactive;
+        Pool->Enqueue(MoveTemp(Sequence));
+    }
+
+    FIGIInferenceServerMetrics GetMetrics() const
+    {
+        FIGIInferenceServerMetrics Total;
+        double QueueWaitMs = 0.0;
+        int64 Started = 0;
+
+        FScopeLock Lock(&CS);
+        for (const TPair<EIGIModelTier, TUniquePtr<FPool>>& Pair : Pools)
+        {
+            Pair.Value->AddMetrics(Total, QueueWaitMs, Started);
+        }
+        Total.MeanQueueWaitMs = Started > 0 ? QueueWaitMs / Started : 0.0;
+        return Total;
+    }
+
+private:
+    // Non-owning ptr
+    FIGIModule* IGIModulePtr;
+
+    int32 NumSlotsPerModel{ 1 };
+
+    mutable FCriticalSection CS;
+    TMap<EIGIModelTier, TUniquePtr<FPool>> Pools;
+    TArray<TUniquePtr<FPool>> FailedPools;
+};
+
+// ----------------------------------
+
+FIGIInferenceServer::FIGIInferenceServer(FIGIModule* IGIModule)
+{
+    Pimpl = MakePimpl<FIGIInferenceServer::Impl>(IGIModule);
+}
+
+FIGIInferenceServer::~FIGIInferenceServer() {}
+
+void FIGIInferenceServer::Submit(EIGIModelTier Tier, const FIGIGPTRequest& Request, const FString& SessionId, FIGIInferenceCallback&& OnComplete)
+{
+    Pimpl->Submit(Tier, Request, SessionId, MoveTemp(OnComplete));
+}
+
+FIGIInferenceServerMetrics FIGIInferenceServer::GetMetrics() const
+{
+    return Pimpl->GetMetrics();
+}
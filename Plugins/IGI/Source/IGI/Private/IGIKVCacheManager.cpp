@@ -0,0 +1,608 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIKVCacheManager.h"
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "IGILog.h"
+#include "IGISettings.h"
+
+namespace
+{
+    constexpr int32 MIN_CONTEXT_SIZE{ 512 };
+
+    constexpr int64 MB{ 1024 * 1024 };
+
+    constexpr uint32 SAVE_MAGIC{ 0x53494749 }; // "IGIS"
+    constexpr uint32 SAVE_VERSION{ 2 };
+
+    // Far more than a level ever holds or a session is given; larger values in a save mean the file is corrupt
+    constexpr int32 MAX_SAVED_SESSIONS{ 4096 };
+    constexpr int32 MAX_SESSION_CONTEXT_SIZE{ 128 * 1024 };
+}
+
+class FIGIKVCacheManager::Impl
+{
+public:
+    Impl()
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        BytesPerToken = Settings->KVBytesPerTokenF16;
+        KVBudgetBytes = static_cast<int64>(Settings->KVMemoryBudgetMB) * MB;
+        DefaultSessionContextSize = Settings->DefaultSessionContextSize;
+
+        SessionDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IGI"), TEXT("Sessions"));
+        IFileManager::Get().MakeDirectory(*SessionDirectory, true);
+    }
+
+    virtual ~Impl()
+    {
+        WaitForSaves();
+
+        TArray<FString> SessionIds;
+        {
+            FScopeLock Lock(&CS);
+            Sessions.GetKeys(SessionIds);
+        }
+        for (const FString& SessionId : SessionIds)
+        {
+            IFileManager::Get().Delete(*GetSessionPath(SessionId), false, true, true);
+        }
+    }
+
+    int64 EstimateKVBytes(int32 ContextSize) const
+    {
+        return BytesPerToken * ContextSize;
+    }
+
+    int32 ReserveModelContext(const FString& ModelKey, int32 RequestedContextSize)
+    {
+        FScopeLock Lock(&CS);
+
+        const int64 Available = KVBudgetBytes - ResidentModelBytes;
+        const int32 Fits = BytesPerToken > 0 ? static_cast<int32>(FMath::Min<int64>(Available / BytesPerToken, MAX_int32)) : RequestedContextSize;
+        const int32 ContextSize = FMath::Max(MIN_CONTEXT_SIZE, FMath::Min(RequestedContextSize, Fits));
+        if (ContextSize < RequestedContextSize)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI: KV budget allows %d of %d context tokens for %s"), ContextSize, RequestedContextSize, *ModelKey);
+        }
+
+        // A swapped-out instance can still be draining when the same model is loaded again, so one key
+        // may hold several reservations at once
+        const int64 Bytes = EstimateKVBytes(ContextSize);
+        ModelBytes.FindOrAdd(ModelKey).Add(Bytes);
+        ResidentModelBytes += Bytes;
+        return ContextSize;
+    }
+
+    void ReleaseModelContext(const FString& ModelKey)
+    {
+        FScopeLock Lock(&CS);
+
+        TArray<int64>* Reservations = ModelBytes.Find(ModelKey);
+        if (Reservations == nullptr)
+        {
+            return;
+        }
+
+        // Oldest first: the instance being released is the one that was swapped out
+        ResidentModelBytes -= (*Reservations)[0];
+        Reservations->RemoveAt(0);
+        if (Reservations->IsEmpty())
+        {
+            ModelBytes.Remove(ModelKey);
+        }
+    }
+
+    void SetSessionContextSize(const FString& SessionId, int32 ContextSize)
+    {
+        FScopeLock Lock(&CS);
+        Sessions.FindOrAdd(SessionId).ContextSize = ContextSize;
+    }
+
+    int32 GetSessionContextSize(const FString& SessionId) const
+    {
+        FScopeLock Lock(&CS);
+        const FSession* Session = Sessions.Find(SessionId);
+        return (Session && Session->ContextSize > 0) ? Session->ContextSize : DefaultSessionContextSize;
+    }
+
+    FString AcquireSession(const FString& SessionId, const FString& ModelGUID)
+    {
+        const FString Path = GetSessionPath(SessionId);
+        TArray<uint8> Compressed;
+        int32 UncompressedSize = 0;
+        int64 MaxSessionBytes = 0;
+        bool bDiscard = false;
+        {
+            FScopeLock Lock(&CS);
+
+            FSession& Session = Sessions.FindOrAdd(SessionId);
+
+            // KV state is only meaningful to the model that produced it; a session routed to another model starts cold
+            if (Session.State != ESessionState::Cold && Session.State != ESessionState::Active && Session.ModelGUID != ModelGUID)
+            {
+                UE_LOG(LogIGISDK, Log, TEXT("IGI: session %s moved from model %s to %s, starting cold"), *SessionId, *Session.ModelGUID, *ModelGUID);
+                bDiscard = true;
+            }
+            else if (Session.State == ESessionState::Saved)
+            {
+                Compressed = MoveTemp(Session.Snapshot);
+                UncompressedSize = Session.UncompressedSize;
+                MaxSessionBytes = EstimateKVBytes(Session.ContextSize > 0 ? Session.ContextSize : DefaultSessionContextSize);
+            }
+            bDiscard |= Session.bStaleFile;
+
+            Session.Snapshot.Empty();
+            Session.bStaleFile = false;
+            Session.ModelGUID = ModelGUID;
+            Session.State = ESessionState::Active;
+            ++Session.Generation;
+        }
+
+        // Outside CS: an active session's file is only touched by its own request, and saves skip it
+        if (bDiscard)
+        {
+            IFileManager::Get().Delete(*Path, false, true, true);
+        }
+        else if (!Compressed.IsEmpty())
+        {
+            RestoreSaved(SessionId, Compressed, UncompressedSize, MaxSessionBytes, Path);
+        }
+        return Path;
+    }
+
+    void ReleaseSession(const FString& SessionId)
+    {
+        int32 ContextSize = 0;
+        {
+            FScopeLock Lock(&CS);
+            const FSession* Session = Sessions.Find(SessionId);
+            if (Session == nullptr || Session->State != ESessionState::Active)
+            {
+                return;
+            }
+            ContextSize = Session->ContextSize > 0 ? Session->ContextSize : DefaultSessionContextSize;
+        }
+
+        // Sessions longer than their context budget start cold next time
+        const FString Path = GetSessionPath(SessionId);
+        if (IFileManager::Get().FileSize(*Path) > EstimateKVBytes(ContextSize))
+        {
+            IFileManager::Get().Delete(*Path, false, true, true);
+        }
+
+        FScopeLock Lock(&CS);
+        if (FSession* Session = Sessions.Find(SessionId); Session && Session->State == ESessionState::Active)
+        {
+            Session->State = ESessionState::Disk;
+        }
+    }
+
+    void DropSession(const FString& SessionId)
+    {
+        FScopeLock Lock(&CS);
+        if (FSession* Session = Sessions.Find(SessionId))
+        {
+            // The entry stays so the stale file is deleted by the next AcquireSession, outside CS
+            const uint32 Generation = Session->Generation + 1;
+            *Session = FSession();
+            Session->Generation = Generation;
+            Session->bStaleFile = true;
+        }
+    }
+
+    void SaveSessions(const FString& Path, TUniqueFunction<void(bool)>&& OnSaved)
+    {
+        // Only copies happen here; reading session files, compressing and writing run on a worker
+        TArray<FSavedSession> Snapshots;
+        {
+            FScopeLock Lock(&CS);
+            for (const TPair<FString, FSession>& Pair : Sessions)
+            {
+                const FSession& Session = Pair.Value;
+                if (Session.State == ESessionState::Active)
+                {
+                    // Its cache file is being written by the backend right now
+                    UE_LOG(LogIGISDK, Log, TEXT("IGI: session %s is in use and is not saved"), *Pair.Key);
+                    continue;
+                }
+                if (Session.State == ESessionState::Cold)
+                {
+                    continue;
+                }
+
+                FSavedSession& Saved = Snapshots.AddDefaulted_GetRef();
+                Saved.SessionId = Pair.Key;
+                Saved.ModelGUID = Session.ModelGUID;
+                Saved.ContextSize = Session.ContextSize;
+                Saved.Generation = Session.Generation;
+                if (Session.State == ESessionState::Saved)
+                {
+                    // Never restored since the last load, so the blob passes through untouched
+                    Saved.UncompressedSize = Session.UncompressedSize;
+                    Saved.Data = Session.Snapshot;
+                    Saved.bCompressed = true;
+                }
+            }
+        }
+
+        FScopeLock Lock(&CS);
+        PendingSaves.RemoveAll([](const TFuture<void>& Pending) { return Pending.IsReady(); });
+        PendingSaves.Add(Async(EAsyncExecution::ThreadPool, [this, Path, Snapshots = MoveTemp(Snapshots), OnSaved = MoveTemp(OnSaved)]() mutable
+            {
+                const bool bSaved = WriteSessions(Path, Snapshots);
+                if (OnSaved)
+                {
+                    OnSaved(bSaved);
+                }
+            }));
+    }
+
+    bool LoadSessions(const FString& Path)
+    {
+        // A save still being written may be the one to load
+        WaitForSaves();
+
+        // Parsed before taking CS, so requests finishing on other threads never wait on the file
+        TArray<FSavedSession> Loaded;
+        const bool bRead = ReadSessions(Path, Loaded);
+
+        int32 NumLoaded = 0;
+        {
+            FScopeLock Lock(&CS);
+
+            // Whatever the NPCs said before the load no longer happened. Stale files are deleted by the
+            // next AcquireSession, which owns the file by then, rather than under CS here
+            for (TPair<FString, FSession>& Pair : Sessions)
+            {
+                if (Pair.Value.State != ESessionState::Active)
+                {
+                    Pair.Value.bStaleFile |= Pair.Value.State == ESessionState::Disk;
+                    Pair.Value.Snapshot.Empty();
+                    Pair.Value.State = ESessionState::Cold;
+                    ++Pair.Value.Generation;
+                }
+            }
+
+            for (FSavedSession& Saved : Loaded)
+            {
+                FSession& Session = Sessions.FindOrAdd(Saved.SessionId);
+                if (Session.State == ESessionState::Active)
+                {
+                    continue;
+                }
+                if (Session.ContextSize == 0)
+                {
+                    Session.ContextSize = Saved.ContextSize;
+                }
+
+                // Restored lazily by AcquireSession, so loading a save costs no prefill and no decompression
+                if (Saved.UncompressedSize > 0)
+                {
+                    Session.State = ESessionState::Saved;
+                    Session.ModelGUID = Saved.ModelGUID;
+                    Session.UncompressedSize = Saved.UncompressedSize;
+                    Session.Snapshot = MoveTemp(Saved.Data);
+                    ++NumLoaded;
+                }
+            }
+        }
+
+        if (bRead)
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("IGI: loaded %d sessions from %s"), NumLoaded, *Path);
+        }
+        return bRead;
+    }
+
+    int64 GetResidentModelBytes() const
+    {
+        FScopeLock Lock(&CS);
+        return ResidentModelBytes;
+    }
+
+private:
+    enum class ESessionState : uint8
+    {
+        Cold,
+        Active,
+        /** Idle; the backend's session file holds the state */
+        Disk,
+        // Compressed snapshot from a save game, not yet validated against the model
+        Saved,
+    };
+
+    struct FSession
+    {
+        ESessionState State{ ESessionState::Cold };
+        int32 ContextSize{ 0 };
+        TArray<uint8> Snapshot;
+
+        /** Model the KV state belongs to */
+        FString ModelGUID;
+
+        /** Bumped whenever the session file may change, so a save never reads a file that was reused meanwhile */
+        uint32 Generation{ 0 };
+
+        /** The file on disk holds discarded state and must go before the backend sees it */
+        bool bStaleFile{ false };
+
+        /** Saved state only */
+        int32 UncompressedSize{ 0 };
+    };
+
+    /** A session as SaveSessions copied it; idle sessions are read from disk by the worker */
+    struct FSavedSession
+    {
+        FString SessionId;
+        FString ModelGUID;
+        int32 ContextSize{ 0 };
+        int32 UncompressedSize{ 0 };
+        uint32 Generation{ 0 };
+        TArray<uint8> Data;
+        bool bCompressed{ false };
+    };
+
+    /** Worker thread; CS is only taken to check that a session file read is still current */
+    bool WriteSessions(const FString& Path, TArray<FSavedSession>& Snapshots)
+    {
+        // Saves to the same slot land in the order they were made
+        FScopeLock SaveLock(&SaveCS);
+
+        TArray<uint8> Data;
+        FMemoryWriter Ar(Data);
+
+        uint32 Magic = SAVE_MAGIC;
+        uint32 Version = SAVE_VERSION;
+        Ar << Magic << Version;
+
+        int32 NumSessions = Snapshots.Num();
+        Ar << NumSessions;
+
+        for (FSavedSession& Saved : Snapshots)
+        {
+            TArray<uint8> Compressed;
+            int32 UncompressedSize = Saved.UncompressedSize;
+            if (Saved.bCompressed)
+            {
+                Compressed = MoveTemp(Saved.Data);
+            }
+            else
+            {
+                FFileHelper::LoadFileToArray(Saved.Data, *GetSessionPath(Saved.SessionId), FILEREAD_Silent);
+                {
+                    // Picked up again since the copy: the backend may have been writing the file as it was read
+                    FScopeLock Lock(&CS);
+                    const FSession* Session = Sessions.Find(Saved.SessionId);
+                    if (Session == nullptr || Session->State != ESessionState::Disk || Session->Generation != Saved.Generation)
+                    {
+                        Saved.Data.Empty();
+                    }
+                }
+
+                UncompressedSize = Saved.Data.Num();
+                int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+                Compressed.SetNumUninitialized(CompressedSize);
+                if (UncompressedSize == 0 || !FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Saved.Data.GetData(), UncompressedSize))
+                {
+                    UncompressedSize = 0;
+                    CompressedSize = 0;
+                }
+                Compressed.SetNum(CompressedSize);
+            }
+
+            int32 ContextSize = Saved.ContextSize;
+            Ar << Saved.SessionId << Saved.ModelGUID << ContextSize << UncompressedSize << Compressed;
+        }
+
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+        if (!FFileHelper::SaveArrayToFile(Data, *Path))
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: unable to write sessions to %s"), *Path);
+            return false;
+        }
+
+        UE_LOG(LogIGISDK, Log, TEXT("IGI: saved %d sessions (%d bytes) to %s"), NumSessions, Data.Num(), *Path);
+        return true;
+    }
+
+    /** No locks held; parses a file written by WriteSessions */
+    bool ReadSessions(const FString& Path, TArray<FSavedSession>& OutSessions) const
+    {
+        TArray<uint8> Data;
+        if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+        {
+            // A save made without sessions is fine; everyone starts cold
+            return false;
+        }
+
+        FMemoryReader Ar(Data);
+
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        Ar << Magic << Version;
+        if (Magic != SAVE_MAGIC || Version != SAVE_VERSION)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI: %s is not a version %u session save"), *Path, SAVE_VERSION);
+            return false;
+        }
+
+        int32 NumSessions = 0;
+        Ar << NumSessions;
+        if (NumSessions < 0 || NumSessions > MAX_SAVED_SESSIONS)
+        {
+            Ar.SetError();
+        }
+
+        for (int32 Index = 0; Index < NumSessions && !Ar.IsError(); ++Index)
+        {
+            FSavedSession& Saved = OutSessions.AddDefaulted_GetRef();
+            int32 CompressedSize = 0;
+            Ar << Saved.SessionId << Saved.ModelGUID << Saved.ContextSize << Saved.UncompressedSize << CompressedSize;
+
+            // Sizes are checked before anything is allocated from them: the state can't outgrow the context
+            // it was saved with (ReleaseSession drops it otherwise), and zlib never grows it past the bound
+            const int64 MaxSessionBytes = FMath::Min<int64>(EstimateKVBytes(Saved.ContextSize > 0 ? Saved.ContextSize : DefaultSessionContextSize), MAX_int32);
+            if (Ar.IsError() || Saved.ContextSize < 0 || Saved.ContextSize > MAX_SESSION_CONTEXT_SIZE
+                || Saved.UncompressedSize < 0 || Saved.UncompressedSize > MaxSessionBytes
+                || CompressedSize < 0 || CompressedSize > Ar.TotalSize() - Ar.Tell()
+                || CompressedSize > FCompression::CompressMemoryBound(NAME_Zlib, Saved.UncompressedSize)
+                || (CompressedSize == 0) != (Saved.UncompressedSize == 0))
+            {
+                Ar.SetError();
+                break;
+            }
+
+            Saved.Data.SetNumUninitialized(CompressedSize);
+            Ar.Serialize(Saved.Data.GetData(), CompressedSize);
+        }
+
+        if (Ar.IsError())
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI: %s is corrupt, every session starts cold"), *Path);
+            OutSessions.Empty();
+            return false;
+        }
+        return true;
+    }
+
+    FString GetSessionPath(const FString& SessionId) const
+    {
+        return FPaths::Combine(SessionDirectory, FPaths::MakeValidFileName(SessionId) + TEXT(".kv"));
+    }
+
+    /** No locks held; the session is Active, so nothing else touches its file */
+    void RestoreSaved(const FString& SessionId, const TArray<uint8>& Compressed, int32 UncompressedSize, int64 MaxSessionBytes, const FString& Path)
+    {
+        // The session's context may have shrunk since the save; state that no longer fits starts cold like it would on release
+        TArray<uint8> Snapshot;
+        if (UncompressedSize <= 0 || UncompressedSize > MaxSessionBytes)
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("IGI: saved session %s no longer fits its context, starting cold"), *SessionId);
+        }
+        else
+        {
+            Snapshot.SetNumUninitialized(UncompressedSize);
+        }
+        if (!Snapshot.IsEmpty() && !FCompression::UncompressMemory(NAME_Zlib, Snapshot.GetData(), Snapshot.Num(), Compressed.GetData(), Compressed.Num()))
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI: saved session %s is corrupt, starting cold"), *SessionId);
+            Snapshot.Empty();
+        }
+
+        if (Snapshot.IsEmpty() || !FFileHelper::SaveArrayToFile(Snapshot, *Path))
+        {
+            IFileManager::Get().Delete(*Path, false, true, true);
+        }
+    }
+
+    void WaitForSaves()
+    {
+        TArray<TFuture<void>> Saves;
+        {
+            FScopeLock Lock(&CS);
+            Saves = MoveTemp(PendingSaves);
+        }
+        for (TFuture<void>& Save : Saves)
+        {
+            Save.Wait();
+        }
+    }
+
+    mutable FCriticalSection CS;
+
+    // Saves in flight (under CS), and the lock that keeps their writes in order
+    TArray<TFuture<void>> PendingSaves;
+    FCriticalSection SaveCS;
+
+    int64 BytesPerToken{ 0 };
+    int64 KVBudgetBytes{ 0 };
+    int32 DefaultSessionContextSize{ 0 };
+
+    int64 ResidentModelBytes{ 0 };
+
+    FString SessionDirectory;
+    /** Reservations per model key, oldest first */
+    TMap<FString, TArray<int64>> ModelBytes;
+    TMap<FString, FSession> Sessions;
+};
+
+// ----------------------------------
+
+FIGIKVCacheManager::FIGIKVCacheManager()
+{
+    Pimpl = MakePimpl<FIGIKVCacheManager::Impl>();
+}
+
+FIGIKVCacheManager::~FIGIKVCacheManager() {}
+
+int64 FIGIKVCacheManager::EstimateKVBytes(int32 ContextSize) const
+{
+    return Pimpl->EstimateKVBytes(ContextSize);
+}
+
+int32 FIGIKVCacheManager::ReserveModelContext(const FString& ModelKey, int32 RequestedContextSize)
+{
+    return Pimpl->ReserveModelContext(ModelKey, RequestedContextSize);
+}
+
+void FIGIKVCacheManager::ReleaseModelContext(const FString& ModelKey)
+{
+    Pimpl->ReleaseModelContext(ModelKey);
+}
+
+void FIGIKVCacheManager::SetSessionContextSize(const FString& SessionId, int32 ContextSize)
+{
+    Pimpl->SetSessionContextSize(SessionId, ContextSize);
+}
+
+int32 FIGIKVCacheManager::GetSessionContextSize(const FString& SessionId) const
+{
+    return Pimpl->GetSessionContextSize(SessionId);
+}
+
+FString FIGIKVCacheManager::AcquireSession(const FString& SessionId, const FString& ModelGUID)
+{
+    return Pimpl->AcquireSession(SessionId, ModelGUID);
+}
+
+void FIGIKVCacheManager::ReleaseSession(const FString& SessionId)
+{
+    Pimpl->ReleaseSession(SessionId);
+}
+
+void FIGIKVCacheManager::DropSession(const FString& SessionId)
+{
+    Pimpl->DropSession(SessionId);
+}
+
+void FIGIKVCacheManager::SaveSessions(const FString& Path, TUniqueFunction<void(bool)>&& OnSaved)
+{
+    Pimpl->SaveSessions(Path, MoveTemp(OnSaved));
+}
+
+bool FIGIKVCacheManager::LoadSessions(const FString& Path)
+{
+    return Pimpl->LoadSessions(Path);
+}
+
+FString FIGIKVCacheManager::GetSaveGameSessionsPath(const FString& SlotName)
+{
+    // Next to the .sav written by the default save game system
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".igisessions"));
+}
+
+int64 FIGIKVCacheManager::GetResidentModelBytes() const
+{
+    return Pimpl->GetResidentModelBytes();
+}
@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGILog.h"
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeExit.h"
+
+#include "IGISettings.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr uint32 RING_CAPACITY{ 1024 };
+    constexpr uint32 RING_MASK{ RING_CAPACITY - 1 };
+    constexpr int32 MAX_MESSAGE_BYTES{ 496 };
+
+    // A longer message spans consecutive slots; one that would need more than this is logged directly
+    constexpr uint32 MAX_MESSAGE_SLOTS{ 64 };
+
+    // How often the drain thread empties the ring when nobody wakes it
+    constexpr uint32 DRAIN_INTERVAL_MS{ 20 };
+
+    ELogVerbosity::Type ToVerbosity(EIGILogLevel Level)
+    {
+        switch (Level)
+        {
+        case EIGILogLevel::Off: return ELogVerbosity::NoLogging;
+        case EIGILogLevel::Error: return ELogVerbosity::Error;
+        case EIGILogLevel::Warning: return ELogVerbosity::Warning;
+        case EIGILogLevel::Log: return ELogVerbosity::Log;
+        case EIGILogLevel::Verbose: return ELogVerbosity::Verbose;
+        default: return ELogVerbosity::Log;
+        }
+    }
+
+    void LogNow(EIGILogSource Source, ELogVerbosity::Type Verbosity, const FString& Message)
+    {
+        const TCHAR* Prefix{ Source == EIGILogSource::Backend ? TEXT("IGI: ") : TEXT("") };
+
+        switch (Verbosity)
+        {
+        case ELogVerbosity::Error: UE_LOG(LogIGISDK, Error, TEXT("%s%s"), Prefix, *Message); break;
+        case ELogVerbosity::Warning: UE_LOG(LogIGISDK, Warning, TEXT("%s%s"), Prefix, *Message); break;
+        case ELogVerbosity::Verbose: UE_LOG(LogIGISDK, Verbose, TEXT("%s%s"), Prefix, *Message); break;
+        default: UE_LOG(LogIGISDK, Log, TEXT("%s%s"), Prefix, *Message); break;
+        }
+    }
+
+    // Bounded multi-producer, single-consumer ring. Each slot carries a sequence number: a producer
+    // claims the slot whose sequence equals the write index, fills it and publishes it by bumping the
+    // sequence; the drain thread consumes a slot once its sequence shows it was published. A message
+    // longer than a slot claims a run of consecutive slots in one step and is logged once they are
+    // all published. Producers never wait: if the ring is full the message is counted as dropped.
+    class FLogRing : public FRunnable
+    {
+    public:
+        FLogRing()
+        {
+            for (uint32 Index = 0; Index < RING_CAPACITY; ++Index)
+            {
+                Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+            }
+        }
+
+        void Start()
+        {
+            const UIGISettings* Settings = GetDefault<UIGISettings>();
+            Levels[static_cast<int32>(EIGILogSource::Backend)].store(ToVerbosity(Settings->BackendLogLevel), std::memory_order_relaxed);
+            Levels[static_cast<int32>(EIGILogSource::Request)].store(ToVerbosity(Settings->RequestLogLevel), std::memory_order_relaxed);
+            bRedactPrompts.store(Settings->bRedactPrompts, std::memory_order_relaxed);
+            MaxLoggedPromptChars.store(Settings->MaxLoggedPromptChars, std::memory_order_relaxed);
+
+            if (Thread == nullptr && FPlatformProcess::SupportsMultithreading())
+            {
+                bStop = false;
+                WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+                Thread = FRunnableThread::Create(this, TEXT("IGILogDrain"), 0, TPri_Lowest);
+                bRunning.store(Thread != nullptr, std::memory_order_release);
+            }
+        }
+
+        void Shutdown()
+        {
+            if (Thread == nullptr)
+            {
+                return;
+            }
+
+            // New messages go straight to UE_LOG from here on. Producers that got in before that are
+            // waited for, so the final drain sees their messages.
+            bRunning.store(false, std::memory_order_seq_cst);
+            while (NumProducers.load(std::memory_order_seq_cst) > 0)
+            {
+                FPlatformProcess::Yield();
+            }
+            bStop = true;
+            WakeEvent->Trigger();
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+            FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+            WakeEvent = nullptr;
+        }
+
+        bool ShouldLog(EIGILogSource Source, ELogVerbosity::Type Verbosity) const
+        {
+            const ELogVerbosity::Type Level{ Levels[static_cast<int32>(Source)].load(std::memory_order_relaxed) };
+            return Level != ELogVerbosity::NoLogging && Verbosity <= Level;
+        }
+
+        void Push(EIGILogSource Source, ELogVerbosity::Type Verbosity, const char* Text, int32 Length)
+        {
+            // Register as a producer before checking bRunning, so Shutdown cannot finish its last drain
+            // between the check and the publish
+            NumProducers.fetch_add(1, std::memory_order_seq_cst);
+            ON_SCOPE_EXIT
+            {
+                NumProducers.fetch_sub(1, std::memory_order_release);
+            };
+
+            const uint32 NumSlots{ static_cast<uint32>(FMath::Max(1, FMath::DivideAndRoundUp(Length, MAX_MESSAGE_BYTES))) };
+            if (!bRunning.load(std::memory_order_seq_cst) || NumSlots > MAX_MESSAGE_SLOTS)
+            {
+                LogNow(Source, Verbosity, FString(Length, reinterpret_cast<const UTF8CHAR*>(Text)).TrimEnd());
+                return;
+            }
+
+            // The drain thread frees slots in order, so the run is free once its last slot is
+            uint64 Position{ WriteIndex.load(std::memory_order_relaxed) };
+            for (;;)
+            {
+                const uint64 Last{ Position + NumSlots - 1 };
+                const uint64 Sequence{ Slots[Last & RING_MASK].Sequence.load(std::memory_order_acquire) };
+                const int64 Diff{ static_cast<int64>(Sequence) - static_cast<int64>(Last) };
+                if (Diff == 0)
+                {
+                    if (WriteIndex.compare_exchange_weak(Position, Position + NumSlots, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (Diff < 0)
+                {
+                    Dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else
+                {
+                    Position = WriteIndex.load(std::memory_order_relaxed);
+                }
+            }
+
+            // Fill and publish the tail slots first; the drain thread starts from the head
+            for (uint32 Part = NumSlots; Part-- > 0;)
+            {
+                FSlot& Slot{ Slots[(Position + Part) & RING_MASK] };
+                const int32 Offset{ static_cast<int32>(Part) * MAX_MESSAGE_BYTES };
+                const int32 PartLength{ FMath::Min(Length - Offset, MAX_MESSAGE_BYTES) };
+
+                Slot.Source = Source;
+                Slot.Verbosity = Verbosity;
+                Slot.NumSlots = static_cast<uint16>(Part == 0 ? NumSlots : 0);
+                Slot.Length = static_cast<uint16>(PartLength);
+                FMemory::Memcpy(Slot.Text, Text + Offset, PartLength);
+                Slot.Sequence.store(Position + Part + 1, std::memory_order_release);
+            }
+        }
+
+        FString Redact(const FString& Text) const
+        {
+            if (bRedactPrompts.load(std::memory_order_relaxed))
+            {
+                return FString::Printf(TEXT("<redacted, %d chars>"), Text.Len());
+            }
+
+            const int32 MaxChars{ MaxLoggedPromptChars.load(std::memory_order_relaxed) };
+            if (MaxChars > 0 && Text.Len() > MaxChars)
+            {
+                return FString::Printf(TEXT("%s... <%d chars>"), *Text.Left(MaxChars), Text.Len());
+            }
+            return Text;
+        }
+
+    protected:
+        uint32 Run() override
+        {
+            while (!bStop)
+            {
+                WakeEvent->Wait(DRAIN_INTERVAL_MS);
+                Drain();
+            }
+            Drain();
+            return 0;
+        }
+
+    private:
+        struct FSlot
+        {
+            std::atomic<uint64> Sequence{ 0 };
+            EIGILogSource Source{ EIGILogSource::Backend };
+            ELogVerbosity::Type Verbosity{ ELogVerbosity::Log };
+
+            // Slots in the message on its first slot, 0 on the ones that continue it
+            uint16 NumSlots{ 1 };
+            uint16 Length{ 0 };
+            char Text[MAX_MESSAGE_BYTES];
+        };
+
+        void Drain()
+        {
+            TArray<UTF8CHAR, TInlineAllocator<MAX_MESSAGE_BYTES>> Bytes;
+            for (;;)
+            {
+                FSlot& Head{ Slots[ReadIndex & RING_MASK] };
+                if (Head.Sequence.load(std::memory_order_acquire) != ReadIndex + 1)
+                {
+                    break;
+                }
+
+                // Tail slots publish before the head, so a published head means the whole message is
+                const uint32 NumSlots{ FMath::Max<uint32>(Head.NumSlots, 1) };
+                const EIGILogSource Source{ Head.Source };
+                const ELogVerbosity::Type Verbosity{ Head.Verbosity };
+
+                Bytes.Reset();
+                for (uint32 Part = 0; Part < NumSlots; ++Part)
+                {
+                    FSlot& Slot{ Slots[(ReadIndex + Part) & RING_MASK] };
+                    Bytes.Append(reinterpret_cast<const UTF8CHAR*>(Slot.Text), Slot.Length);
+                    Slot.Sequence.store(ReadIndex + Part + RING_CAPACITY, std::memory_order_release);
+                }
+                ReadIndex += NumSlots;
+
+                // nvigi messages end with newlines
+                FString Message(Bytes.Num(), Bytes.GetData());
+                Message.TrimEndInline();
+                LogNow(Source, Verbosity, Message);
+            }
+
+            const uint64 NumDropped{ Dropped.exchange(0, std::memory_order_relaxed) };
+            if (NumDropped > 0)
+            {
+                UE_LOG(LogIGISDK, Warning, TEXT("IGI log ring was full, dropped %llu messages"), NumDropped);
+            }
+        }
+
+        FSlot Slots[RING_CAPACITY];
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> WriteIndex{ 0 };
+        alignas(PLATFORM_CACHE_LINE_SIZE) uint64 ReadIndex{ 0 };
+        std::atomic<uint64> Dropped{ 0 };
+
+        std::atomic<ELogVerbosity::Type> Levels[2]{ { ELogVerbosity::Log }, { ELogVerbosity::Log } };
+        std::atomic<bool> bRedactPrompts{ false };
+        std::atomic<int32> MaxLoggedPromptChars{ 0 };
+
+        std::atomic<bool> bRunning{ false };
+        std::atomic<int32> NumProducers{ 0 };
+        std::atomic<bool> bStop{ false };
+        FEvent* WakeEvent{ nullptr };
+        FRunnableThread* Thread{ nullptr };
+    };
+
+    // nvigi's log callback carries no user pointer, so the ring has to be global
+    FLogRing GLogRing;
+}
+
+void IGILogCallback(nvigi::LogType Type, const char* InMessage)
+{
+    ELogVerbosity::Type Verbosity{ ELogVerbosity::Error };
+    if (Type == nvigi::LogType::eInfo)
+    {
+        Verbosity = ELogVerbosity::Log;
+    }
+    else if (Type == nvigi::LogType::eWarn)
+    {
+        Verbosity = ELogVerbosity::Warning;
+    }
+
+    if (InMessage != nullptr && GLogRing.ShouldLog(EIGILogSource::Backend, Verbosity))
+    {
+        GLogRing.Push(EIGILogSource::Backend, Verbosity, InMessage, static_cast<int32>(FCStringAnsi::Strlen(InMessage)));
+    }
+}
+
+bool IGIShouldLog(EIGILogSource Source, ELogVerbosity::Type Verbosity)
+{
+    return GLogRing.ShouldLog(Source, Verbosity);
+}
+
+void IGILogRequest(ELogVerbosity::Type Verbosity, const FString& Message)
+{
+    if (GLogRing.ShouldLog(EIGILogSource::Request, Verbosity))
+    {
+        FTCHARToUTF8 Converted(*Message);
+        GLogRing.Push(EIGILogSource::Request, Verbosity, Converted.Get(), Converted.Length());
+    }
+}
+
+FString IGIRedactForLog(const FString& Text)
+{
+    return GLogRing.Redact(Text);
+}
+
+void IGIStartLogRing()
+{
+    GLogRing.Start();
+}
+
+void IGIStopLogRing()
+{
+    GLogRing.Shutdown();
+}
@@ -10,27 +10,28 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogIGISDK, Log, All);
 
-static void IGILogCallback(nvigi::LogType Type, const char* InMessage)
+/** Source of a message queued on the IGI log ring; each has its own verbosity filter */
+enum class EIGILogSource : uint8
 {
-    FString Message(reinterpret_cast<const UTF8CHAR*>(InMessage));
-
-    // AIM log messages end with newlines, so fix that
-    Message.TrimEndInline();
-    
-    if (Type == nvigi::LogType::eInfo)
-    {
-        UE_LOG(LogIGISDK, Log, TEXT("IGI: %s"), *Message);
-    }
-    else if (Type == nvigi::LogType::eWarn)
-    {
-        UE_LOG(LogIGISDK, Warning, TEXT("IGI: %s"), *Message);
-    }
-    else if (Type == nvigi::LogType::eError)
-    {
-        UE_LOG(LogIGISDK, Error, TEXT("IGI: %s"), *Message);
-    }
-    else
-    {
-        UE_LOG(LogIGISDK, Error, TEXT("Received unknown IGI log type %d: %s"), Type, *Message);
-    }
-}
+    Backend,
+    Request,
+};
+
+/**
+ * nvigi log callback. Copies the raw UTF-8 message into the log ring and returns; the message is
+ * converted and passed to UE_LOG later on the drain thread, so backend threads never wait on logging.
+ */
+void IGILogCallback(nvigi::LogType Type, const char* InMessage);
+
+/** True if a message of this verbosity from this source would be logged; check before formatting */
+bool IGIShouldLog(EIGILogSource Source, ELogVerbosity::Type Verbosity);
+
+/** Queue a request-path message (prompts, responses, routing) for the drain thread */
+void IGILogRequest(ELogVerbosity::Type Verbosity, const FString& Message);
+
+/** Prompt or response text as it may appear in logs: redacted or truncated per UIGISettings */
+FString IGIRedactForLog(const FString& Text);
+
+/** Start/stop the drain thread; while it isn't running, messages are logged directly on the calling thread */
+void IGIStartLogRing();
+void IGIStopLogRing();
@@ -0,0 +1,466 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIModelRegistry.h"
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Async/Future.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeRWLock.h"
+
+#include "IGIGPT.h"
+#include "IGIHardwareProbe.h"
+#include "IGIKVCacheManager.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+#include "IGISettings.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr int32 NUM_TIERS{ 2 };
+
+    int32 TierIndex(EIGIModelTier Tier)
+    {
+        check(Tier != EIGIModelTier::Auto);
+        return Tier == EIGIModelTier::Small ? 0 : 1;
+    }
+
+    /** Reload is 0 for a plain load; a forced reload gets its own number so it never matches the instance it replaces */
+    FString GetModelKey(const FIGIModelTierSettings& Settings, int32 Reload)
+    {
+        const FString Key = Settings.ModelGUID + TEXT("@") + UEnum::GetValueAsString(Settings.Backend);
+        return Reload > 0 ? FString::Printf(TEXT("%s#%d"), *Key, Reload) : Key;
+    }
+
+    FAutoConsoleCommand SwapModelCommand(
+        TEXT("IGI.SwapModel"),
+        TEXT("Load a model in the background and switch a tier to it once ready. Arguments: Small|Large <ModelGUID> [CUDA|CPU] [-reload]. ")
+        TEXT("-reload loads a fresh instance even if the tier already serves that model."),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+            {
+                TArray<FString> Args = InArgs;
+                const bool bReload = Args.RemoveAll([](const FString& Arg) { return Arg.Equals(TEXT("-reload"), ESearchCase::IgnoreCase); }) > 0;
+
+                const int64 Tier = Args.Num() >= 2 ? StaticEnum<EIGIModelTier>()->GetValueByNameString(Args[0]) : INDEX_NONE;
+                const int64 Backend = Args.Num() >= 3 ? StaticEnum<EIGIGPTBackend>()->GetValueByNameString(Args[2]) : static_cast<int64>(EIGIGPTBackend::CUDA);
+                if (Tier == INDEX_NONE || Tier == static_cast<int64>(EIGIModelTier::Auto) || Backend == INDEX_NONE)
+                {
+                    UE_LOG(LogIGISDK, Warning, TEXT("Usage: IGI.SwapModel Small|Large <ModelGUID> [CUDA|CPU] [-reload]"));
+                    return;
+                }
+                FIGIModule::Get().GetModelRegistry()->SwapModel(static_cast<EIGIModelTier>(Tier), Args[1], static_cast<EIGIGPTBackend>(Backend), bReload);
+            }));
+}
+
+class FIGIModelRegistry::Impl
+{
+public:
+    Impl(FIGIModule* IGIModule)
+        : IGIModulePtr(IGIModule)
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        TierSettings[TierIndex(EIGIModelTier::Small)] = Settings->SmallTier;
+        TierSettings[TierIndex(EIGIModelTier::Large)] = Settings->LargeTier;
+        AutoSmallPromptMaxChars = Settings->AutoSmallPromptMaxChars;
+        bAllowOverflowToLarge = Settings->bAllowOverflowToLarge;
+
+        const FIGIHardwareSelection Selection = IGIModulePtr->GetHardwareSelection();
+        if (Selection.SmallTier.IsSet())
+        {
+            TierSettings[TierIndex(EIGIModelTier::Small)] = Selection.SmallTier.GetValue();
+        }
+        if (Selection.LargeTier.IsSet())
+        {
+            TierSettings[TierIndex(EIGIModelTier::Large)] = Selection.LargeTier.GetValue();
+        }
+
+        KVCache = IGIModulePtr->GetKVCacheManager();
+
+        if (TierSettings[TierIndex(EIGIModelTier::Large)].ModelGUID.IsEmpty())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: large model tier has no model GUID configured"));
+        }
+    }
+
+    virtual ~Impl()
+    {
+        // Swaps finish first; each one waits for its own load
+        TArray<TSharedFuture<bool>> Swaps;
+        {
+            FScopeLock Lock(&CS);
+            Swaps = PendingSwaps;
+        }
+        for (const TSharedFuture<bool>& Swap : Swaps)
+        {
+            Swap.Wait();
+        }
+
+        TArray<TSharedPtr<FModelSlot>> Slots;
+        {
+            FScopeLock Lock(&CS);
+            Models.GenerateValueArray(Slots);
+            Models.Empty();
+        }
+
+        // Loads in progress finish first; the instance can't be torn down halfway through creation
+        for (const TSharedPtr<FModelSlot>& Slot : Slots)
+        {
+            Slot->Future.Wait();
+        }
+
+        FWriteScopeLock Lock(TierLock);
+        for (FIGIGPTPtr& Ready : ReadyModels)
+        {
+            Ready.Reset();
+        }
+    }
+
+    EIGIModelTier SelectTier(EIGIModelTier RequestedTier, int32 PromptLength) const
+    {
+        if (RequestedTier != EIGIModelTier::Auto)
+        {
+            return IsConfigured(RequestedTier) ? RequestedTier : EIGIModelTier::Large;
+        }
+
+        if (!IsConfigured(EIGIModelTier::Small) || PromptLength > AutoSmallPromptMaxChars)
+        {
+            return EIGIModelTier::Large;
+        }
+
+        // Small tier is saturated; only borrow the large model while nothing important is running on it
+        if (bAllowOverflowToLarge && IsFull(EIGIModelTier::Small) && GetQueueDepth(EIGIModelTier::Large) == 0)
+        {
+            return EIGIModelTier::Large;
+        }
+
+        return EIGIModelTier::Small;
+    }
+
+    bool TryBeginRequest(EIGIModelTier RequestedTier, int32 PromptLength, EIGIRequestPriority Priority, EIGIModelTier& OutTier)
+    {
+        OutTier = SelectTier(RequestedTier, PromptLength);
+
+        const int32 Index = TierIndex(OutTier);
+        const FIGIModelTierSettings Settings = GetTierSettings(OutTier);
+        int32 MaxDepth = FMath::Max(1, Settings.MaxQueueDepth);
+        if (Priority == EIGIRequestPriority::Interactive)
+        {
+            MaxDepth += FMath::Max(0, Settings.InteractiveQueueReserve);
+        }
+        int32 Depth = InFlight[Index].load();
+        do
+        {
+            if (Depth >= MaxDepth)
+            {
+                return false;
+            }
+        } while (!InFlight[Index].compare_exchange_weak(Depth, Depth + 1));
+
+        return true;
+    }
+
+    void EndRequest(EIGIModelTier Tier)
+    {
+        const int32 Previous = InFlight[TierIndex(Tier)].fetch_sub(1);
+        check(Previous > 0);
+    }
+
+    TSharedFuture<FIGIGPTPtr> GetGPTFuture(EIGIModelTier Tier)
+    {
+        Tier = ResolveTier(Tier);
+        FIGIModelTierSettings Settings;
+        const FString ModelKey = GetTierModelKey(Tier, Settings);
+        return FindOrLoad(Settings, ModelKey, Tier)->Future;
+    }
+
+    FIGIGPTPtr TryGetGPT(EIGIModelTier Tier)
+    {
+        Tier = ResolveTier(Tier);
+        const int32 Index = TierIndex(Tier);
+        {
+            FReadScopeLock Lock(TierLock);
+            if (ReadyModels[Index].IsValid())
+            {
+                return ReadyModels[Index];
+            }
+        }
+
+        TSharedFuture<FIGIGPTPtr> Future = GetGPTFuture(Tier);
+        if (!Future.IsReady())
+        {
+            return nullptr;
+        }
+
+        FWriteScopeLock Lock(TierLock);
+        if (!ReadyModels[Index].IsValid())
+        {
+            ReadyModels[Index] = Future.Get();
+        }
+        return ReadyModels[Index];
+    }
+
+    FIGIGPTPtr GetGPT(EIGIModelTier Tier)
+    {
+        if (FIGIGPTPtr Ready = TryGetGPT(Tier))
+        {
+            return Ready;
+        }
+        return GetGPTFuture(Tier).Get();
+    }
+
+    TSharedFuture<bool> SwapModel(EIGIModelTier Tier, const FString& ModelGUID, EIGIGPTBackend Backend, bool bReload)
+    {
+        check(Tier != EIGIModelTier::Auto);
+
+        FIGIModelTierSettings NewSettings = GetTierSettings(Tier);
+        NewSettings.ModelGUID = ModelGUID;
+        NewSettings.Backend = Backend;
+        return SwapModel(Tier, NewSettings, bReload);
+    }
+
+    TSharedFuture<bool> SwapModel(EIGIModelTier Tier, const FIGIModelTierSettings& NewSettings, bool bReload)
+    {
+        check(Tier != EIGIModelTier::Auto);
+
+        // Nothing loaded for the tier yet, so there is nothing to keep serving; the next request loads the new model
+        FIGIModelTierSettings CurrentSettings;
+        const FString CurrentKey = GetTierModelKey(Tier, CurrentSettings);
+        const int32 NewReload = bReload ? ++NextReload : 0;
+        const FString NewKey = GetModelKey(NewSettings, NewReload);
+        bool bCurrentLoaded = false;
+        {
+            FScopeLock Lock(&CS);
+            bCurrentLoaded = Models.Contains(CurrentKey);
+        }
+        if (!bCurrentLoaded)
+        {
+            FWriteScopeLock Lock(TierLock);
+            TierSettings[TierIndex(Tier)] = NewSettings;
+            TierReloads[TierIndex(Tier)] = NewReload;
+            return MakeFulfilledPromise<bool>(true).GetFuture().Share();
+        }
+
+        UE_LOG(LogIGISDK, Log, TEXT("IGI: %s %s tier to model %s; the current model keeps serving until it is ready"),
+            bReload ? TEXT("reloading") : TEXT("swapping"), *UEnum::GetValueAsString(Tier), *NewSettings.ModelGUID);
+
+        TSharedPtr<FModelSlot> NewSlot = FindOrLoad(NewSettings, NewKey, Tier);
+
+        TSharedFuture<bool> Swap = Async(EAsyncExecution::Thread, [this, Tier, NewSettings, NewReload, NewKey, NewSlot]()
+            {
+                FIGIGPTPtr NewModel = NewSlot->Future.Get();
+                if (!NewModel.IsValid() || !NewModel->IsValid())
+                {
+                    UE_LOG(LogIGISDK, Error, TEXT("IGI: model %s failed to load; %s tier keeps its current model"), *NewSettings.ModelGUID, *UEnum::GetValueAsString(Tier));
+                    FScopeLock Lock(&CS);
+                    Models.Remove(NewKey);
+                    return false;
+                }
+
+                FString OldKey;
+                {
+                    FWriteScopeLock Lock(TierLock);
+                    const int32 Index = TierIndex(Tier);
+                    OldKey = GetModelKey(TierSettings[Index], TierReloads[Index]);
+                    TierSettings[Index] = NewSettings;
+                    TierReloads[Index] = NewReload;
+                    ReadyModels[Index] = NewModel;
+                }
+
+                // The old instance is freed once in-flight requests drop their references (see FindOrLoad)
+                if (OldKey != NewKey && !IsKeyInUse(OldKey))
+                {
+                    FScopeLock Lock(&CS);
+                    Models.Remove(OldKey);
+                }
+
+                UE_LOG(LogIGISDK, Log, TEXT("IGI: %s tier now serves model %s"), *UEnum::GetValueAsString(Tier), *NewSettings.ModelGUID);
+                return true;
+            }).Share();
+
+        FScopeLock Lock(&CS);
+        PendingSwaps.RemoveAll([](const TSharedFuture<bool>& Pending) { return Pending.IsReady(); });
+        PendingSwaps.Add(Swap);
+        return Swap;
+    }
+
+    int32 GetQueueDepth(EIGIModelTier Tier) const
+    {
+        return InFlight[TierIndex(Tier)].load();
+    }
+
+private:
+    struct FModelSlot
+    {
+        TPromise<FIGIGPTPtr> Promise;
+        TSharedFuture<FIGIGPTPtr> Future;
+    };
+
+    TSharedPtr<FModelSlot> FindOrLoad(const FIGIModelTierSettings& Settings, const FString& ModelKey, EIGIModelTier Tier)
+    {
+        TSharedPtr<FModelSlot> Slot;
+        bool bStartLoad = false;
+        {
+            FScopeLock Lock(&CS);
+            TSharedPtr<FModelSlot>& Existing = Models.FindOrAdd(ModelKey);
+            if (!Existing.IsValid())
+            {
+                Existing = MakeShared<FModelSlot>();
+                Existing->Future = Existing->Promise.GetFuture().Share();
+                bStartLoad = true;
+            }
+            Slot = Existing;
+        }
+
+        // Creating an instance takes seconds, so it runs on its own thread with no lock held
+        if (bStartLoad)
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("IGI: loading model %s for %s tier"), *Settings.ModelGUID, *UEnum::GetValueAsString(Tier));
+            Async(EAsyncExecution::Thread, [this, Slot, ModelKey, Settings]()
+                {
+                    FIGIGPTModelDesc ModelDesc;
+                    ModelDesc.ModelGUID = Settings.ModelGUID;
+                    ModelDesc.Backend = Settings.Backend;
+                    ModelDesc.VRAMBudgetMB = Settings.VRAMBudgetMB;
+                    ModelDesc.NumThreads = Settings.NumThreads;
+                    ModelDesc.ContextSize = KVCache->ReserveModelContext(ModelKey, Settings.ContextSize);
+
+                    // Weights and KV reservation go away with the last reference, so a swapped-out model drains naturally
+                    FIGIKVCacheManager* KVCacheManager = KVCache;
+                    FIGIGPTPtr Model = MakeShareable(new FIGIGPT(IGIModulePtr, ModelDesc), [KVCacheManager, ModelKey](FIGIGPT* GPT)
+                        {
+                            delete GPT;
+                            KVCacheManager->ReleaseModelContext(ModelKey);
+                            UE_LOG(LogIGISDK, Log, TEXT("IGI: unloaded model %s"), *ModelKey);
+                        });
+                    Slot->Promise.SetValue(Model);
+                });
+        }
+
+        return Slot;
+    }
+
+    FIGIModelTierSettings GetTierSettings(EIGIModelTier Tier) const
+    {
+        FReadScopeLock Lock(TierLock);
+        return TierSettings[TierIndex(Tier)];
+    }
+
+    /** Key of the instance the tier serves, read together with its settings */
+    FString GetTierModelKey(EIGIModelTier Tier, FIGIModelTierSettings& OutSettings) const
+    {
+        FReadScopeLock Lock(TierLock);
+        const int32 Index = TierIndex(Tier);
+        OutSettings = TierSettings[Index];
+        return GetModelKey(OutSettings, TierReloads[Index]);
+    }
+
+    bool IsKeyInUse(const FString& ModelKey) const
+    {
+        FReadScopeLock Lock(TierLock);
+        for (int32 Index = 0; Index < NUM_TIERS; ++Index)
+        {
+            if (GetModelKey(TierSettings[Index], TierReloads[Index]) == ModelKey)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    EIGIModelTier ResolveTier(EIGIModelTier Tier) const
+    {
+        return (Tier == EIGIModelTier::Auto || !IsConfigured(Tier)) ? EIGIModelTier::Large : Tier;
+    }
+
+    bool IsConfigured(EIGIModelTier Tier) const
+    {
+        FReadScopeLock Lock(TierLock);
+        return !TierSettings[TierIndex(Tier)].ModelGUID.IsEmpty();
+    }
+
+    bool IsFull(EIGIModelTier Tier) const
+    {
+        return InFlight[TierIndex(Tier)].load() >= FMath::Max(1, GetTierSettings(Tier).MaxQueueDepth);
+    }
+
+    // Non-owning ptrs
+    FIGIModule* IGIModulePtr;
+    FIGIKVCacheManager* KVCache{ nullptr };
+
+    int32 AutoSmallPromptMaxChars{ 0 };
+    bool bAllowOverflowToLarge{ true };
+
+    std::atomic<int32> InFlight[NUM_TIERS]{};
+
+    // Tier configuration and the instance each tier currently serves; swapped together under the write lock
+    mutable FRWLock TierLock;
+    FIGIModelTierSettings TierSettings[NUM_TIERS];
+    FIGIGPTPtr ReadyModels[NUM_TIERS];
+    /** Forced reload each tier's instance came from, 0 for none (see GetModelKey) */
+    int32 TierReloads[NUM_TIERS]{};
+
+    std::atomic<int32> NextReload{ 0 };
+
+    // Models keyed by GUID, backend and reload, so tiers sharing a model share the instance. CS only guards the map.
+    FCriticalSection CS;
+    TMap<FString, TSharedPtr<FModelSlot>> Models;
+    TArray<TSharedFuture<bool>> PendingSwaps;
+};
+
+// ----------------------------------
+
+FIGIModelRegistry::FIGIModelRegistry(FIGIModule* IGIModule)
+{
+    Pimpl = MakePimpl<FIGIModelRegistry::Impl>(IGIModule);
+}
+
+FIGIModelRegistry::~FIGIModelRegistry() {}
+
+EIGIModelTier FIGIModelRegistry::SelectTier(EIGIModelTier RequestedTier, int32 PromptLength) const
+{
+    return Pimpl->SelectTier(RequestedTier, PromptLength);
+}
+
+bool FIGIModelRegistry::TryBeginRequest(EIGIModelTier RequestedTier, int32 PromptLength, EIGIRequestPriority Priority, EIGIModelTier& OutTier)
+{
+    return Pimpl->TryBeginRequest(RequestedTier, PromptLength, Priority, OutTier);
+}
+
+void FIGIModelRegistry::EndRequest(EIGIModelTier Tier)
+{
+    Pimpl->EndRequest(Tier);
+}
+
+FIGIGPTPtr FIGIModelRegistry::GetGPT(EIGIModelTier Tier)
+{
+    return Pimpl->GetGPT(Tier);
+}
+
+FIGIGPTPtr FIGIModelRegistry::TryGetGPT(EIGIModelTier Tier)
+{
+    return Pimpl->TryGetGPT(Tier);
+}
+
+TSharedFuture<FIGIGPTPtr> FIGIModelRegistry::GetGPTFuture(EIGIModelTier Tier)
+{
+    return Pimpl->GetGPTFuture(Tier);
+}
+
+TSharedFuture<bool> FIGIModelRegistry::SwapModel(EIGIModelTier Tier, const FString& ModelGUID, EIGIGPTBackend Backend, bool bReload)
+{
+    return Pimpl->SwapModel(Tier, ModelGUID, Backend, bReload);
+}
+
+TSharedFuture<bool> FIGIModelRegistry::SwapModel(EIGIModelTier Tier, const FIGIModelTierSettings& Settings, bool bReload)
+{
+    return Pimpl->SwapModel(Tier, Settings, bReload);
+}
+
+int32 FIGIModelRegistry::GetQueueDepth(EIGIModelTier Tier) const
+{
+    return Pimpl->GetQueueDepth(Tier);
+}
@@ -5,13 +5,28 @@
 #include "IGIModule.h"
 
 #include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Misc/CommandLine.h"
 #include "Misc/MessageDialog.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
 
+#include "IGIBackgroundJobs.h"
 #include "IGICore.h"
+#include "IGIEmbed.h"
+#include "IGIFrameBudget.h"
 #include "IGIGPT.h"
+#include "IGIHardwareProbe.h"
+#include "IGIHost.h"
+#include "IGIHostServer.h"
+#include "IGIInferenceServer.h"
+#include "IGIKVCacheManager.h"
 #include "IGILog.h"
+#include "IGIModelRegistry.h"
+#include "IGIResultDispatcher.h"
+#include "IGISettings.h"
+#include "IGITrace.h"
 
 #include "nvigi.h"
 #include "nvigi_ai.h"
@@ -33,6 +48,30 @@ public:
         FString BaseDir = IPluginManager::Get().FindPlugin("IGI")->GetBaseDir();
         IGICoreLibraryPath = FPaths::Combine(*BaseDir, TEXT("ThirdParty/nvigi_pack/plugins/sdk/bin/x64/nvigi.core.framework.dll"));
         IGIModelsPath = FPaths::Combine(*BaseDir, TEXT("ThirdParty/nvigi_pack/plugins/sdk/data/nvigi.models"));
+
+        // Set when the game launched this process as its inference host
+        FParse::Value(FCommandLine::Get(), TEXT("IGIHost="), HostChannelName);
+        FParse::Value(FCommandLine::Get(), TEXT("IGIParentPid="), HostParentPid);
+
+        // Created up front rather than on first use: it outlives core reloads and the ticker reads it without CS
+        ResultDispatcher = MakeUnique<FIGIResultDispatcher>();
+
+        TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &Impl::Tick));
+    }
+
+    bool Tick(float DeltaSeconds)
+    {
+        if (FrameBudget.IsValid())
+        {
+            FrameBudget->Tick(DeltaSeconds);
+        }
+        // Game worlds drain in TG_PrePhysics earlier in the frame; this covers frames without one
+        ResultDispatcher->Drain();
+        if (ProbeBenchmark.IsValid() && ProbeBenchmark.IsReady())
+        {
+            ApplyProbeBenchmark();
+        }
+        return true;
     }
 
     void ShutdownModule()
@@ -40,6 +79,8 @@ public:
         // This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
         // we call this function before unloading the module.
 
+        FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
         if (Core)
         {
             UnloadIGICore();
@@ -48,60 +89,288 @@ public:
 
     bool LoadIGICore()
     {
-        FScopeLock Lock(&CS);
+        FScopeLock Lock(&FeatureCS);
 
         Core = MakeUnique<FIGICore>(IGICoreLibraryPath);
         return (Core != nullptr) && (Core->IsInitialized());
     }
 
-    bool UnloadIGICore()
+    void RunHardwareProbe(FIGIModule* module)
+    {
+        TOptional<FIGIHardwareBenchmarkJob> BenchmarkJob;
+        FIGIHardwareSelection Selection = FIGIHardwareProbe::Run(Core ? Core->GetSystemInformation() : nullptr, BenchmarkJob);
+        {
+            FScopeLock Lock(&ProbeCS);
+            HardwareSelection = MoveTemp(Selection);
+        }
+
+        // Loading and timing candidates takes seconds each, so the game starts on the provisional
+        // selection and Tick switches the tiers over once the benchmark is done
+        if (BenchmarkJob.IsSet())
+        {
+            ProbeBenchmark = Async(EAsyncExecution::Thread, [module, Job = MoveTemp(BenchmarkJob.GetValue())]()
+                {
+                    return FIGIHardwareProbe::Benchmark(module, Job);
+                });
+        }
+    }
+
+    FIGIHardwareSelection GetHardwareSelection() const
+    {
+        FScopeLock Lock(&ProbeCS);
+        return HardwareSelection;
+    }
+
+    /** Game thread: cache the benchmarked selection and move a registry that already exists onto it */
+    void ApplyProbeBenchmark()
+    {
+        const FIGIHardwareSelection Selection = ProbeBenchmark.Consume();
+        FIGIHardwareProbe::CacheSelection(Selection);
+        {
+            FScopeLock Lock(&ProbeCS);
+            HardwareSelection = Selection;
+        }
+
+        FIGIModelRegistry* ExistingRegistry = nullptr;
+        {
+            FScopeLock Lock(&CS);
+            ExistingRegistry = Registry.Get();
+        }
+        if (ExistingRegistry)
+        {
+            if (Selection.SmallTier.IsSet())
+            {
+                ExistingRegistry->SwapModel(EIGIModelTier::Small, Selection.SmallTier.GetValue());
+            }
+            if (Selection.LargeTier.IsSet())
+            {
+                ExistingRegistry->SwapModel(EIGIModelTier::Large, Selection.LargeTier.GetValue());
+            }
+        }
+    }
+
+    bool IsInferenceHost() const { return !HostChannelName.IsEmpty(); }
+
+    /** Serve the game when this is the host; otherwise launch the host if the project runs inference out of process */
+    void StartInferenceHost(FIGIModule* module)
+    {
+        if (IsInferenceHost())
+        {
+            TUniquePtr<FIGIHostServer> NewServer = MakeUnique<FIGIHostServer>(module, HostChannelName, HostParentPid);
+            FScopeLock Lock(&CS);
+            HostServer = MoveTemp(NewServer);
+        }
+        else if (GetDefault<UIGISettings>()->bOutOfProcessInference && !IsRunningCommandlet())
+        {
+            // Start doesn't wait for the host; models created while it boots load in-process until it attaches
+            TUniquePtr<FIGIHostClient> NewClient = MakeUnique<FIGIHostClient>(module);
+            NewClient->Start();
+            FScopeLock Lock(&CS);
+            HostClient = MoveTemp(NewClient);
+        }
+    }
+
+    FIGIHostClient* GetHostClient()
+    {
+        FScopeLock Lock(&CS);
+        return HostClient.Get();
+    }
+
+    FIGIBackgroundJobs* GetBackgroundJobs(FIGIModule* module)
     {
         FScopeLock Lock(&CS);
+        if (!BackgroundJobs.IsValid())
+        {
+            BackgroundJobs = MakeUnique<FIGIBackgroundJobs>(module);
+        }
+        return BackgroundJobs.Get();
+    }
 
-        GPT.Reset();
+    FIGIInferenceServer* GetInferenceServer(FIGIModule* module)
+    {
+        FScopeLock Lock(&CS);
+        if (!InferenceServer.IsValid())
+        {
+            InferenceServer = MakeUnique<FIGIInferenceServer>(module);
+        }
+        return InferenceServer.Get();
+    }
+
+    FIGIFrameBudget* GetFrameBudget()
+    {
+        FScopeLock Lock(&CS);
+        if (!FrameBudget.IsValid())
+        {
+            FrameBudget = MakeUnique<FIGIFrameBudget>();
+        }
+        return FrameBudget.Get();
+    }
+
+    FIGIKVCacheManager* GetKVCacheManager()
+    {
+        FScopeLock Lock(&CS);
+        if (!KVCache.IsValid())
+        {
+            KVCache = MakeUnique<FIGIKVCacheManager>();
+        }
+        return KVCache.Get();
+    }
+
+    FIGIResultDispatcher* GetResultDispatcher() const { return ResultDispatcher.Get(); }
+
+    FIGITraceRecorder* GetTraceRecorder()
+    {
+        FScopeLock Lock(&CS);
+        if (!TraceRecorder.IsValid())
+        {
+            TraceRecorder = MakeUnique<FIGITraceRecorder>();
+        }
+        return TraceRecorder.Get();
+    }
+
+    FIGIEmbedPtr GetEmbed(FIGIModule* module)
+    {
+        // Its own lock: the first call loads the model, which must not hold up the other subsystems
+        FScopeLock Lock(&EmbedCS);
+        if (!Embed.IsValid() && !bEmbedFailed)
+        {
+            const UIGISettings* Settings = GetDefault<UIGISettings>();
+            FIGIEmbedModelDesc Desc;
+            Desc.ModelGUID = Settings->EmbedModelGUID;
+            Desc.Backend = Settings->EmbedBackend;
+            Desc.NumThreads = Settings->EmbedNumThreads;
+
+            FIGIEmbedPtr NewEmbed = MakeShared<FIGIEmbed, ESPMode::ThreadSafe>(module, Desc);
+            if (NewEmbed->IsValid())
+            {
+                Embed = NewEmbed;
+            }
+            else
+            {
+                // Don't retry the load on every call
+                bEmbedFailed = true;
+            }
+        }
+        return Embed;
+    }
+
+    bool UnloadIGICore()
+    {
+        // The benchmark loads models through the core; a result nobody will apply is dropped
+        if (ProbeBenchmark.IsValid())
+        {
+            ProbeBenchmark.Wait();
+            ProbeBenchmark.Reset();
+        }
+
+        TUniquePtr<FIGIInferenceServer> OldInferenceServer;
+        TUniquePtr<FIGIBackgroundJobs> OldBackgroundJobs;
+        TUniquePtr<FIGIModelRegistry> OldRegistry;
+        TUniquePtr<FIGITraceRecorder> OldTraceRecorder;
+        TUniquePtr<FIGIKVCacheManager> OldKVCache;
+        TUniquePtr<FIGIFrameBudget> OldFrameBudget;
+        TUniquePtr<FIGIHostClient> OldHostClient;
+        TUniquePtr<FIGIHostServer> OldHostServer;
+        {
+            FScopeLock Lock(&CS);
+            OldInferenceServer = MoveTemp(InferenceServer);
+            OldBackgroundJobs = MoveTemp(BackgroundJobs);
+            OldRegistry = MoveTemp(Registry);
+            OldTraceRecorder = MoveTemp(TraceRecorder);
+            OldKVCache = MoveTemp(KVCache);
+            OldFrameBudget = MoveTemp(FrameBudget);
+            OldHostClient = MoveTemp(HostClient);
+            OldHostServer = MoveTemp(HostServer);
+        }
+
+        // Torn down outside CS: the registry waits for model loads that still query the module
+        OldInferenceServer.Reset();
+        OldBackgroundJobs.Reset();
+        OldRegistry.Reset();
+        OldHostServer.Reset();
+        OldHostClient.Reset();
+        OldTraceRecorder.Reset();
+        OldKVCache.Reset();
+        OldFrameBudget.Reset();
+
+        {
+            FScopeLock Lock(&EmbedCS);
+            Embed.Reset();
+            bEmbedFailed = false;
+        }
+
+        FScopeLock Lock(&FeatureCS);
         Core.Reset();
         return true;
     }
 
     nvigi::Result LoadIGIFeature(const nvigi::PluginID& Feature, nvigi::InferenceInterface** Interface, const UTF8CHAR* UTF8PathToPlugin = nullptr)
     {
-        FScopeLock Lock(&CS);
+        FScopeLock Lock(&FeatureCS);
 
         return Core->LoadInterface(Feature, nvigi::InferenceInterface::s_type, Interface, UTF8PathToPlugin);
     }
 
     nvigi::Result UnloadIGIFeature(nvigi::PluginID Feature, nvigi::InferenceInterface* Interface)
     {
-        FScopeLock Lock(&CS);
+        FScopeLock Lock(&FeatureCS);
 
         return Core->UnloadInterface(Feature, Interface);
     }
 
     const FString GetModelsPath() const { return IGIModelsPath; }
 
-    FIGIGPT* GetGPT(FIGIModule* module)
+    FIGIModelRegistry* GetModelRegistry(FIGIModule* module)
     {
         FScopeLock Lock(&CS);
-        if(!GPT.IsValid())
+        if (!Registry.IsValid())
         {
-            GPT = MakeUnique<FIGIGPT>(module);
+            Registry = MakeUnique<FIGIModelRegistry>(module);
         }
-        return GPT.Get();
+        return Registry.Get();
     }
 
 private:
     TUniquePtr<FIGICore> Core;
-    TUniquePtr<FIGIGPT> GPT;
-
+    TUniquePtr<FIGIFrameBudget> FrameBudget;
+    TUniquePtr<FIGIBackgroundJobs> BackgroundJobs;
+    TUniquePtr<FIGIInferenceServer> InferenceServer;
+    TUniquePtr<FIGIKVCacheManager> KVCache;
+    TUniquePtr<FIGIModelRegistry> Registry;
+    TUniquePtr<FIGIResultDispatcher> ResultDispatcher;
+    TUniquePtr<FIGITraceRecorder> TraceRecorder;
+    TUniquePtr<FIGIHostClient> HostClient;
+    TUniquePtr<FIGIHostServer> HostServer;
+
+    // The probe's selection, replaced when the background benchmark finishes
+    mutable FCriticalSection ProbeCS;
+    FIGIHardwareSelection HardwareSelection;
+    TFuture<FIGIHardwareSelection> ProbeBenchmark;
+
+    // CS guards creation of the subsystems above and is only ever held briefly. FeatureCS serializes the
+    // core and feature loads, which can take seconds, so they never block module queries.
     FCriticalSection CS;
+    FCriticalSection FeatureCS;
     FString IGICoreLibraryPath;
     FString IGIModelsPath;
+
+    // From -IGIHost= and -IGIParentPid=; empty unless this process is the inference host
+    FString HostChannelName;
+    uint32 HostParentPid{ 0 };
+
+    // Loaded on first use under EmbedCS, which is held for the whole load
+    FCriticalSection EmbedCS;
+    FIGIEmbedPtr Embed;
+    bool bEmbedFailed{ false };
+
+    FTSTicker::FDelegateHandle TickHandle;
 };
 
 // ----------------------------------
 
 void FIGIModule::StartupModule()
 {
+    IGIStartLogRing();
     Pimpl = MakePimpl<FIGIModule::Impl>();
     Pimpl->StartupModule();
     UE_LOG(LogIGISDK, Log, TEXT("IGI module started"));
@@ -111,6 +380,7 @@ void FIGIModule::ShutdownModule()
 {
     Pimpl->ShutdownModule();
     Pimpl.Reset();
+    IGIStopLogRing();
     UE_LOG(LogIGISDK, Log, TEXT("IGI module shut down"));
 }
 
@@ -120,6 +390,21 @@ bool FIGIModule::LoadIGICore()
     if (Result)
     {
         UE_LOG(LogIGISDK, Log, TEXT("IGI core loaded"));
+
+        // Before the probe, so out of process its benchmark runs in the host like every other model load
+        Pimpl->StartInferenceHost(this);
+
+        // The host only runs the models the game asks for; the game probes and captures
+        if (!IsInferenceHost())
+        {
+            Pimpl->RunHardwareProbe(this);
+
+            // Commandlets (e.g. trace replay) must not capture their own requests
+            if (GetDefault<UIGISettings>()->bCaptureTraces && !IsRunningCommandlet())
+            {
+                GetTraceRecorder()->Start();
+            }
+        }
     }
     else
     {
@@ -151,7 +436,8 @@ nvigi::Result FIGIModule::LoadIGIFeature(const nvigi::PluginID& Feature, nvigi::
     }
     else
     {
-        UE_LOG(LogIGISDK, Fatal, TEXT("ERROR when loading IGI feature"));
+        // Not fatal: callers fall back to another backend or model variant
+        UE_LOG(LogIGISDK, Error, TEXT("ERROR when loading IGI feature: %s"), *GetIGIStatusString(Result));
     }
     return Result;
 }
@@ -175,9 +461,69 @@ const FString FIGIModule::GetModelsPath() const
     return Pimpl->GetModelsPath();
 }
 
-FIGIGPT* FIGIModule::GetGPT()
+FIGIGPTPtr FIGIModule::GetGPT()
+{
+    return Pimpl->GetModelRegistry(this)->GetGPT(EIGIModelTier::Large);
+}
+
+FIGIGPTPtr FIGIModule::TryGetGPT()
+{
+    return Pimpl->GetModelRegistry(this)->TryGetGPT(EIGIModelTier::Large);
+}
+
+FIGIEmbedPtr FIGIModule::GetEmbed()
+{
+    return Pimpl->GetEmbed(this);
+}
+
+FIGIModelRegistry* FIGIModule::GetModelRegistry()
+{
+    return Pimpl->GetModelRegistry(this);
+}
+
+FIGIInferenceServer* FIGIModule::GetInferenceServer()
+{
+    return Pimpl->GetInferenceServer(this);
+}
+
+FIGIBackgroundJobs* FIGIModule::GetBackgroundJobs()
+{
+    return Pimpl->GetBackgroundJobs(this);
+}
+
+FIGIFrameBudget* FIGIModule::GetFrameBudget()
+{
+    return Pimpl->GetFrameBudget();
+}
+
+FIGIKVCacheManager* FIGIModule::GetKVCacheManager()
+{
+    return Pimpl->GetKVCacheManager();
+}
+
+FIGIResultDispatcher* FIGIModule::GetResultDispatcher()
+{
+    return Pimpl->GetResultDispatcher();
+}
+
+FIGITraceRecorder* FIGIModule::GetTraceRecorder()
+{
+    return Pimpl->GetTraceRecorder();
+}
+
+FIGIHostClient* FIGIModule::GetHostClient()
+{
+    return Pimpl->GetHostClient();
+}
+
+bool FIGIModule::IsInferenceHost() const
+{
+    return Pimpl->IsInferenceHost();
+}
+
+FIGIHardwareSelection FIGIModule::GetHardwareSelection() const
 {
-    return Pimpl->GetGPT(this);
+    return Pimpl->GetHardwareSelection();
 }
 
 
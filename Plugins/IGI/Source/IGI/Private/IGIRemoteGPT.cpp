@@ -0,0 +1,384 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIRemoteGPT.h"
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "IGIFrameBudget.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+#include "IGISettings.h"
+
+namespace
+{
+    // How often a waiting request checks whether it should be cancelled
+    constexpr uint32 CANCEL_POLL_MS{ 2 };
+
+    // A stream line longer than this is not an event from a chat server
+    constexpr int32 MAX_LINE_BYTES{ 1024 * 1024 };
+
+    /** State shared between the waiting thread and the HTTP thread's stream and completion delegates */
+    struct FStreamState
+    {
+        FStreamState() { DoneEvent = FPlatformProcess::GetSynchEventFromPool(true); }
+        ~FStreamState() { FPlatformProcess::ReturnSynchEventToPool(DoneEvent); }
+
+        FEvent* DoneEvent{ nullptr };
+
+        // Written by the HTTP thread, read once DoneEvent fires
+        TArray<uint8> PartialLine;
+        FString Response;
+        FString Error;
+        double FirstTokenTime{ 0.0 };
+        int32 NumChunks{ 0 };
+        int32 UsageTokens{ 0 };
+        int32 ResponseCode{ 0 };
+        bool bConnected{ false };
+        bool bStreamEnded{ false };
+        bool bOverflow{ false };
+        TFunction<void(const FString&)> OnChunk;
+    };
+
+    void ParseEvent(FStreamState& State, const FUTF8ToTCHAR& Payload)
+    {
+        TSharedPtr<FJsonObject> Event;
+        const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(FStringView(Payload.Get(), Payload.Length()));
+        if (!FJsonSerializer::Deserialize(Reader, Event) || !Event.IsValid())
+        {
+            return;
+        }
+
+        const TSharedPtr<FJsonObject>* Error = nullptr;
+        if (Event->TryGetObjectField(TEXT("error"), Error))
+        {
+            (*Error)->TryGetStringField(TEXT("message"), State.Error);
+            return;
+        }
+
+        const TSharedPtr<FJsonObject>* Usage = nullptr;
+        if (Event->TryGetObjectField(TEXT("usage"), Usage))
+        {
+            (*Usage)->TryGetNumberField(TEXT("completion_tokens"), State.UsageTokens);
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Choices = nullptr;
+        if (!Event->TryGetArrayField(TEXT("choices"), Choices) || Choices->IsEmpty())
+        {
+            return;
+        }
+        const TSharedPtr<FJsonObject>* Delta = nullptr;
+        FString Chunk;
+        if (!(*Choices)[0]->AsObject()->TryGetObjectField(TEXT("delta"), Delta) || !(*Delta)->TryGetStringField(TEXT("content"), Chunk) || Chunk.IsEmpty())
+        {
+            return;
+        }
+
+        if (State.NumChunks == 0)
+        {
+            State.FirstTokenTime = FPlatformTime::Seconds();
+        }
+        ++State.NumChunks;
+        State.Response += Chunk;
+        if (State.OnChunk)
+        {
+            State.OnChunk(Chunk);
+        }
+    }
+
+    /** Consume the complete lines of a server-sent event stream, keeping the unterminated tail */
+    void ParseStream(FStreamState& State, const uint8* Data, int64 Length)
+    {
+        State.PartialLine.Append(Data, static_cast<int32>(Length));
+
+        int32 LineStart = 0;
+        for (int32 Index = 0; Index < State.PartialLine.Num(); ++Index)
+        {
+            if (State.PartialLine[Index] != '\n')
+            {
+                continue;
+            }
+
+            int32 LineEnd = Index;
+            if (LineEnd > LineStart && State.PartialLine[LineEnd - 1] == '\r')
+            {
+                --LineEnd;
+            }
+
+            // Only data lines matter; comments, event names and the blank separators are skipped
+            static constexpr char DataField[] = "data:";
+            const int32 FieldLen = UE_ARRAY_COUNT(DataField) - 1;
+            if (LineEnd - LineStart > FieldLen && FMemory::Memcmp(&State.PartialLine[LineStart], DataField, FieldLen) == 0)
+            {
+                int32 PayloadStart = LineStart + FieldLen;
+                while (PayloadStart < LineEnd && State.PartialLine[PayloadStart] == ' ')
+                {
+                    ++PayloadStart;
+                }
+
+                const FUTF8ToTCHAR Payload(reinterpret_cast<const ANSICHAR*>(&State.PartialLine[PayloadStart]), LineEnd - PayloadStart);
+                if (FStringView(Payload.Get(), Payload.Length()) == TEXT("[DONE]"))
+                {
+                    State.bStreamEnded = true;
+                }
+                else
+                {
+                    ParseEvent(State, Payload);
+                }
+            }
+            LineStart = Index + 1;
+        }
+
+        State.PartialLine.RemoveAt(0, LineStart, EAllowShrinking::No);
+        if (State.PartialLine.Num() > MAX_LINE_BYTES)
+        {
+            State.bOverflow = true;
+            State.PartialLine.Reset();
+        }
+    }
+}
+
+class FIGIRemoteGPT::Impl
+{
+public:
+    Impl(FIGIModule* IGIModule, const FIGIGPTModelDesc& ModelDesc)
+        : IGIModulePtr(IGIModule)
+        , Desc(ModelDesc)
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        BaseURL = Settings->RemoteEndpoint;
+        BaseURL.RemoveFromEnd(TEXT("/"));
+        ModelName = Settings->RemoteModelName.IsEmpty() ? Desc.ModelGUID : Settings->RemoteModelName;
+    }
+
+    virtual ~Impl() {}
+
+    void CheckEndpoint(TFunction<void(bool)> OnResult)
+    {
+        if (BaseURL.IsEmpty())
+        {
+            OnResult(false);
+            return;
+        }
+
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateRequest(TEXT("/models"), TEXT("GET"));
+        HttpRequest->SetTimeout(GetDefault<UIGISettings>()->RemoteActivityTimeoutSeconds);
+
+        // Answered on the HTTP thread, so nothing waits on it, and the game thread never has to tick it
+        HttpRequest->OnProcessRequestComplete().BindLambda([OnResult = MoveTemp(OnResult), URL = BaseURL](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnected)
+            {
+                const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+                const bool bReachable = bConnected && EHttpResponseCodes::IsOk(ResponseCode);
+                if (!bReachable)
+                {
+                    UE_LOG(LogIGISDK, Warning, TEXT("Remote GPT endpoint %s is unreachable (HTTP %d)"), *URL, ResponseCode);
+                }
+                OnResult(bReachable);
+            });
+        HttpRequest->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+        HttpRequest->ProcessRequest();
+    }
+
+    bool Evaluate(const FIGIGPTRequest& Request, FString& OutResponse, FIGIGPTTimings& OutTimings)
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateRequest(TEXT("/chat/completions"), TEXT("POST"));
+        HttpRequest->SetHeader(TEXT("Accept"), TEXT("text/event-stream"));
+        HttpRequest->SetContentAsString(BuildBody(Request));
+        HttpRequest->SetTimeout(Settings->RemoteTimeoutSeconds);
+        HttpRequest->SetActivityTimeout(Settings->RemoteActivityTimeoutSeconds);
+
+        TSharedRef<FStreamState> State = MakeShared<FStreamState>();
+        if (Request.OnChunk && !Request.bPreemptible)
+        {
+            State->OnChunk = Request.OnChunk;
+        }
+
+        // Chunks are parsed as they arrive, so the body is never held in full
+        HttpRequest->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda([State](void* Ptr, int64& Length)
+            {
+                ParseStream(*State, static_cast<const uint8*>(Ptr), Length);
+            }));
+        HttpRequest->OnProcessRequestComplete().BindLambda([State](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnected)
+            {
+                State->bConnected = bConnected;
+                State->ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+                State->DoneEvent->Trigger();
+            });
+
+        // Completion is signalled from the HTTP thread, so waiting here can't starve it, even on the game thread
+        HttpRequest->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+
+        const double StartTime = FPlatformTime::Seconds();
+        HttpRequest->ProcessRequest();
+
+        FIGIFrameBudget* FrameBudget = IGIModulePtr->GetFrameBudget();
+        bool bCancelled = false;
+        while (!State->DoneEvent->Wait(CANCEL_POLL_MS))
+        {
+            if (!bCancelled && ((Request.bPreemptible && FrameBudget->ShouldYield(Request.Priority)) || (Request.ShouldCancel && Request.ShouldCancel())))
+            {
+                bCancelled = true;
+                HttpRequest->CancelRequest();
+            }
+        }
+
+        const double EndTime = FPlatformTime::Seconds();
+        OutTimings.NumTokens = State->UsageTokens > 0 ? State->UsageTokens : State->NumChunks;
+        OutTimings.bPreempted = bCancelled;
+        OutTimings.TotalMs = (EndTime - StartTime) * 1000.0;
+        OutTimings.TimeToFirstTokenMs = State->NumChunks > 0 ? (State->FirstTokenTime - StartTime) * 1000.0 : OutTimings.TotalMs;
+        OutResponse = MoveTemp(State->Response);
+
+        if (bCancelled)
+        {
+            return true;
+        }
+
+        // A stream cut off before [DONE] would otherwise pass for a short reply
+        if (State->Error.IsEmpty() && !State->bStreamEnded)
+        {
+            State->Error = TEXT("stream ended before [DONE]");
+        }
+        if (!State->bConnected || !EHttpResponseCodes::IsOk(State->ResponseCode) || !State->Error.IsEmpty() || State->bOverflow)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("Remote GPT request to %s failed (HTTP %d) %s"), *BaseURL, State->ResponseCode, *State->Error);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const TCHAR* Path, const TCHAR* Verb) const
+    {
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+        HttpRequest->SetURL(BaseURL + Path);
+        HttpRequest->SetVerb(Verb);
+        HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        HttpRequest->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+        if (!Settings->RemoteAPIKey.IsEmpty())
+        {
+            HttpRequest->SetHeader(TEXT("Authorization"), TEXT("Bearer ") + Settings->RemoteAPIKey);
+        }
+        return HttpRequest;
+    }
+
+    FString BuildBody(const FIGIGPTRequest& Request) const
+    {
+        const FIGIGPTSamplingParams& Sampling = Request.Sampling;
+
+        FString Body;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("model"), ModelName);
+        Writer->WriteValue(TEXT("stream"), true);
+        Writer->WriteObjectStart(TEXT("stream_options"));
+        Writer->WriteValue(TEXT("include_usage"), true);
+        Writer->WriteObjectEnd();
+
+        // A trailing assistant message is continued rather than answered, like AssistantPrompt locally
+        Writer->WriteArrayStart(TEXT("messages"));
+        const TPair<const TCHAR*, const FString*> Messages[] = {
+            { TEXT("system"), &Request.SystemPrompt },
+            { TEXT("user"), &Request.UserPrompt },
+            { TEXT("assistant"), &Request.AssistantPrompt },
+        };
+        for (const TPair<const TCHAR*, const FString*>& Message : Messages)
+        {
+            if (!Message.Value->IsEmpty())
+            {
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("role"), Message.Key);
+                Writer->WriteValue(TEXT("content"), *Message.Value);
+                Writer->WriteObjectEnd();
+            }
+        }
+        Writer->WriteArrayEnd();
+
+        const UIGISettings* Settings = GetDefault<UIGISettings>();
+        Writer->WriteValue(TEXT("max_tokens"), Request.TokensToPredict);
+        Writer->WriteValue(TEXT("temperature"), Sampling.Temperature);
+        Writer->WriteValue(TEXT("top_p"), Sampling.TopP);
+        Writer->WriteValue(TEXT("frequency_penalty"), Sampling.FrequencyPenalty);
+        Writer->WriteValue(TEXT("presence_penalty"), Sampling.PresencePenalty);
+        if (Sampling.Seed >= 0)
+        {
+            Writer->WriteValue(TEXT("seed"), Sampling.Seed);
+        }
+
+        // llama.cpp server extensions; OpenAI servers reject fields they don't know, so only llama.cpp gets
+        // them. The server keeps the prompt's KV state between requests, which stands in for the local
+        // session cache.
+        if (Settings->RemoteServer == EIGIRemoteServer::LlamaCpp)
+        {
+            Writer->WriteValue(TEXT("top_k"), Sampling.TopK);
+            Writer->WriteValue(TEXT("min_p"), Sampling.MinP);
+            Writer->WriteValue(TEXT("repeat_penalty"), Sampling.RepeatPenalty);
+            Writer->WriteValue(TEXT("repeat_last_n"), Sampling.RepeatLastN);
+            Writer->WriteValue(TEXT("cache_prompt"), true);
+
+            // Biases go by text, which llama.cpp tokenizes; OpenAI's logit_bias takes token ids the game
+            // doesn't have. The project-wide bias applies under the request's.
+            TMap<FString, float> LogitBias = Settings->LogitBias;
+            LogitBias.Append(Sampling.LogitBias);
+            if (!LogitBias.IsEmpty())
+            {
+                Writer->WriteArrayStart(TEXT("logit_bias"));
+                for (const TPair<FString, float>& Bias : LogitBias)
+                {
+                    for (const FString& Text : { Bias.Key, TEXT(" ") + Bias.Key })
+                    {
+                        Writer->WriteArrayStart();
+                        Writer->WriteValue(Text);
+                        Writer->WriteValue(Bias.Value);
+                        Writer->WriteArrayEnd();
+                    }
+                }
+                Writer->WriteArrayEnd();
+            }
+        }
+
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return Body;
+    }
+
+    // Non-owning ptr
+    FIGIModule* IGIModulePtr;
+
+    FIGIGPTModelDesc Desc;
+    FString BaseURL;
+    FString ModelName;
+};
+
+// ----------------------------------
+
+FIGIRemoteGPT::FIGIRemoteGPT(FIGIModule* IGIModule, const FIGIGPTModelDesc& ModelDesc)
+{
+    Pimpl = MakePimpl<FIGIRemoteGPT::Impl>(IGIModule, ModelDesc);
+}
+
+FIGIRemoteGPT::~FIGIRemoteGPT()
+{
+}
+
+void FIGIRemoteGPT::CheckEndpoint(TFunction<void(bool)> OnResult)
+{
+    Pimpl->CheckEndpoint(MoveTemp(OnResult));
+}
+
+bool FIGIRemoteGPT::Evaluate(const FIGIGPTRequest& Request, FString& OutResponse, FIGIGPTTimings& OutTimings)
+{
+    return Pimpl->Evaluate(Request, OutResponse, OutTimings);
+}
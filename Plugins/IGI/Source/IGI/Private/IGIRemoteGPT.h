@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIGPT.h"
+
+class FIGIModule;
+
+/**
+ * Client of an OpenAI-compatible chat completions server (UIGISettings::RemoteEndpoint), used by
+ * FIGIGPT for EIGIGPTBackend::Remote.
+ *
+ * Responses are streamed as server-sent events and parsed line by line as they arrive; only the
+ * unterminated tail of the stream is buffered. Requests go through the engine HTTP module, which
+ * keeps connections to the server alive and reuses them, so concurrent sequences share a small
+ * pool instead of reconnecting per request. The IGIRemoteTest commandlet checks it against a stub server.
+ */
+class FIGIRemoteGPT
+{
+public:
+    FIGIRemoteGPT(FIGIModule* IGIModule, const FIGIGPTModelDesc& ModelDesc);
+    virtual ~FIGIRemoteGPT();
+
+    /**
+     * List the server's models without waiting for the answer. OnResult runs on the HTTP thread, false
+     * if the server didn't answer within UIGISettings::RemoteActivityTimeoutSeconds.
+     */
+    void CheckEndpoint(TFunction<void(bool)> OnResult);
+
+    /**
+     * Stream one completion. Returns false if the server couldn't be reached, answered with an error
+     * or went silent; OutResponse then holds whatever arrived before that.
+     */
+    bool Evaluate(const FIGIGPTRequest& Request, FString& OutResponse, FIGIGPTTimings& OutTimings);
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -0,0 +1,308 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIRemoteTestCommandlet.h"
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "CoreGlobals.h"
+#include "Containers/Ticker.h"
+#include "HttpPath.h"
+#include "HttpRouteHandle.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Serialization/JsonWriter.h"
+
+#include "IGILog.h"
+#include "IGIModule.h"
+#include "IGIRemoteGPT.h"
+#include "IGISettings.h"
+
+#include <atomic>
+
+namespace
+{
+    // Big enough that one event spans many transport reads, small enough to stay under the client's line limit
+    constexpr int32 SPLIT_CONTENT_CHARS{ 256 * 1024 };
+
+    /** A canned reply the stub gives on /<Name>/v1/chat/completions */
+    struct FStubReply
+    {
+        FString Name;
+        EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok;
+        FString Body;
+
+        /** Never answer, so the client sees no activity at all */
+        bool bSilent = false;
+    };
+
+    FString ContentEvent(const FString& Content)
+    {
+        FString Json;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+        Writer->WriteObjectStart();
+        Writer->WriteArrayStart(TEXT("choices"));
+        Writer->WriteObjectStart();
+        Writer->WriteObjectStart(TEXT("delta"));
+        Writer->WriteValue(TEXT("content"), Content);
+        Writer->WriteObjectEnd();
+        Writer->WriteObjectEnd();
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return TEXT("data: ") + Json + TEXT("\r\n\r\n");
+    }
+
+    const TCHAR* DoneEvent = TEXT("data: [DONE]\r\n\r\n");
+
+    /** Tick the core ticker, which the stub server answers from, until Done returns true */
+    void PumpUntil(TFunctionRef<bool()> Done)
+    {
+        double LastTime = FPlatformTime::Seconds();
+        while (!Done())
+        {
+            FPlatformProcess::Sleep(0.001f);
+            const double Now = FPlatformTime::Seconds();
+            FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+            LastTime = Now;
+
+            // Once-per-frame work on the ticker, like the result dispatcher's drain, keys off the frame counter
+            ++GFrameCounter;
+        }
+    }
+
+    struct FEvaluation
+    {
+        bool bSucceeded = false;
+        FString Response;
+        FIGIGPTTimings Timings;
+        double Seconds = 0.0;
+    };
+
+    /** Evaluate on a worker, as FIGIGPT would, while this thread keeps the stub server ticking */
+    FEvaluation Evaluate(FIGIModule& IGIModule, const FString& Endpoint)
+    {
+        GetMutableDefault<UIGISettings>()->RemoteEndpoint = Endpoint;
+
+        FIGIGPTModelDesc Desc;
+        Desc.ModelGUID = TEXT("stub");
+        Desc.Backend = EIGIGPTBackend::Remote;
+        FIGIRemoteGPT Remote(&IGIModule, Desc);
+
+        FIGIGPTRequest Request;
+        Request.SystemPrompt = TEXT("You are the butler.");
+        Request.UserPrompt = TEXT("Who was in the library?");
+        Request.TokensToPredict = 32;
+
+        FEvaluation Result;
+        const double StartTime = FPlatformTime::Seconds();
+        TFuture<bool> Future = Async(EAsyncExecution::Thread, [&Remote, &Request, &Result]()
+            {
+                return Remote.Evaluate(Request, Result.Response, Result.Timings);
+            });
+
+        // The client's total and activity timeouts bound the wait
+        PumpUntil([&Future]() { return Future.IsReady(); });
+        Result.bSucceeded = Future.Get();
+        Result.Seconds = FPlatformTime::Seconds() - StartTime;
+        return Result;
+    }
+
+    bool CheckEndpoint(FIGIModule& IGIModule, const FString& Endpoint)
+    {
+        GetMutableDefault<UIGISettings>()->RemoteEndpoint = Endpoint;
+
+        FIGIGPTModelDesc Desc;
+        Desc.ModelGUID = TEXT("stub");
+        Desc.Backend = EIGIGPTBackend::Remote;
+        FIGIRemoteGPT Remote(&IGIModule, Desc);
+
+        // Answered on the HTTP thread, possibly after Remote is gone
+        struct FProbe
+        {
+            std::atomic<bool> bDone{ false };
+            std::atomic<bool> bReachable{ false };
+        };
+        TSharedRef<FProbe> Probe = MakeShared<FProbe>();
+        Remote.CheckEndpoint([Probe](bool bReachable)
+            {
+                Probe->bReachable = bReachable;
+                Probe->bDone = true;
+            });
+
+        PumpUntil([&Probe]() { return Probe->bDone.load(); });
+        return Probe->bReachable;
+    }
+
+    bool Expect(bool bCondition, const TCHAR* Scenario, const FString& What)
+    {
+        if (bCondition)
+        {
+            UE_LOG(LogIGISDK, Display, TEXT("IGI remote test: %s: %s"), Scenario, *What);
+        }
+        else
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI remote test: %s: expected %s"), Scenario, *What);
+        }
+        return bCondition;
+    }
+}
+
+UIGIRemoteTestCommandlet::UIGIRemoteTestCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UIGIRemoteTestCommandlet::Main(const FString& Params)
+{
+    int32 Port = 18080;
+    float ActivityTimeout = 1.f;
+    FParse::Value(*Params, TEXT("Port="), Port);
+    FParse::Value(*Params, TEXT("ActivityTimeout="), ActivityTimeout);
+    ActivityTimeout = FMath::Max(ActivityTimeout, 0.1f);
+
+    // Only the activity timeout should be able to end the silent request
+    UIGISettings* Settings = GetMutableDefault<UIGISettings>();
+    Settings->RemoteServer = EIGIRemoteServer::LlamaCpp;
+    Settings->RemoteModelName.Reset();
+    Settings->RemoteAPIKey.Reset();
+    Settings->RemoteActivityTimeoutSeconds = ActivityTimeout;
+    Settings->RemoteTimeoutSeconds = FMath::Max(10.f, ActivityTimeout * 10.f);
+
+    const FString Reply = TEXT("The butler was in the library.");
+    FString SplitContent;
+    SplitContent.Reserve(SPLIT_CONTENT_CHARS);
+    while (SplitContent.Len() < SPLIT_CONTENT_CHARS)
+    {
+        // Multi-byte UTF-8 too, so reads also end inside a character
+        SplitContent += TEXT("\u00C9vidence \u2014 the candlestick. ");
+    }
+
+    TArray<FStubReply> Replies;
+    {
+        FStubReply& Stream = Replies.AddDefaulted_GetRef();
+        Stream.Name = TEXT("stream");
+        Stream.Body = TEXT(": keep-alive\r\n\r\n");
+        Stream.Body += ContentEvent(TEXT("The butler ")) + ContentEvent(TEXT("was in ")) + ContentEvent(TEXT("the library."));
+        Stream.Body += TEXT("data: {\"choices\":[],\"usage\":{\"completion_tokens\":7}}\r\n\r\n");
+        Stream.Body += DoneEvent;
+
+        FStubReply& Split = Replies.AddDefaulted_GetRef();
+        Split.Name = TEXT("split");
+        Split.Body = ContentEvent(SplitContent) + DoneEvent;
+
+        FStubReply& ErrorEvent = Replies.AddDefaulted_GetRef();
+        ErrorEvent.Name = TEXT("error");
+        ErrorEvent.Body = ContentEvent(TEXT("The ")) + TEXT("data: {\"error\":{\"message\":\"stub model overloaded\"}}\r\n\r\n") + DoneEvent;
+
+        FStubReply& Status = Replies.AddDefaulted_GetRef();
+        Status.Name = TEXT("status");
+        Status.Code = EHttpServerResponseCodes::ServerError;
+        Status.Body = TEXT("{\"error\":{\"message\":\"stub server error\"}}");
+
+        FStubReply& Truncated = Replies.AddDefaulted_GetRef();
+        Truncated.Name = TEXT("truncated");
+        Truncated.Body = ContentEvent(TEXT("The butler "));
+
+        FStubReply& Silent = Replies.AddDefaulted_GetRef();
+        Silent.Name = TEXT("silent");
+        Silent.bSilent = true;
+    }
+
+    FHttpServerModule& HttpServer = FHttpServerModule::Get();
+    TSharedPtr<IHttpRouter> Router = HttpServer.GetHttpRouter(Port, true);
+    if (!Router.IsValid())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI remote test: unable to listen on port %d"), Port);
+        return 1;
+    }
+
+    // Held until the client has given up on the silent reply; handlers run on this thread, from the ticker
+    TArray<FHttpResultCallback> HeldReplies;
+    TArray<FHttpRouteHandle> Routes;
+    for (const FStubReply& StubReply : Replies)
+    {
+        Routes.Add(Router->BindRoute(FHttpPath(FString::Printf(TEXT("/%s/v1/chat/completions"), *StubReply.Name)), EHttpServerRequestVerbs::VERB_POST,
+            FHttpRequestHandler::CreateLambda([&StubReply, &HeldReplies](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+                {
+                    if (StubReply.bSilent)
+                    {
+                        HeldReplies.Add(OnComplete);
+                        return true;
+                    }
+
+                    // Anything but a streamed completion is a client bug the other checks would hide
+                    const FUTF8ToTCHAR Body(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+                    if (!FString(Body.Length(), Body.Get()).Contains(TEXT("\"stream\":true")))
+                    {
+                        TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("{\"error\":{\"message\":\"stub expects stream: true\"}}"), TEXT("application/json"));
+                        Response->Code = EHttpServerResponseCodes::BadRequest;
+                        OnComplete(MoveTemp(Response));
+                        return true;
+                    }
+
+                    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(StubReply.Body, StubReply.Code == EHttpServerResponseCodes::Ok ? TEXT("text/event-stream") : TEXT("application/json"));
+                    Response->Code = StubReply.Code;
+                    OnComplete(MoveTemp(Response));
+                    return true;
+                })));
+    }
+    Routes.Add(Router->BindRoute(FHttpPath(TEXT("/stream/v1/models")), EHttpServerRequestVerbs::VERB_GET,
+        FHttpRequestHandler::CreateLambda([](const FHttpServerRequest&, const FHttpResultCallback& OnComplete)
+            {
+                OnComplete(FHttpServerResponse::Create(TEXT("{\"object\":\"list\",\"data\":[{\"id\":\"stub\",\"object\":\"model\"}]}"), TEXT("application/json")));
+                return true;
+            })));
+    HttpServer.StartAllListeners();
+
+    FIGIModule& IGIModule = FIGIModule::Get();
+    const FString BaseURL = FString::Printf(TEXT("http://127.0.0.1:%d"), Port);
+    auto Endpoint = [&BaseURL](const TCHAR* Name) { return FString::Printf(TEXT("%s/%s/v1"), *BaseURL, Name); };
+
+    bool bPassed = true;
+
+    bPassed &= Expect(CheckEndpoint(IGIModule, Endpoint(TEXT("stream"))), TEXT("models"), TEXT("a listed model to be reachable"));
+    bPassed &= Expect(!CheckEndpoint(IGIModule, Endpoint(TEXT("missing"))), TEXT("models"), TEXT("a 404 to be unreachable"));
+
+    const FEvaluation Stream = Evaluate(IGIModule, Endpoint(TEXT("stream")));
+    bPassed &= Expect(Stream.bSucceeded && Stream.Response == Reply, TEXT("stream"), FString::Printf(TEXT("'%s' through [DONE], got '%s'"), *Reply, *Stream.Response));
+    bPassed &= Expect(Stream.Timings.NumTokens == 7, TEXT("stream"), FString::Printf(TEXT("the usage event's 7 tokens, got %d"), Stream.Timings.NumTokens));
+
+    const FEvaluation Split = Evaluate(IGIModule, Endpoint(TEXT("split")));
+    bPassed &= Expect(Split.bSucceeded && Split.Response == SplitContent, TEXT("split"),
+        FString::Printf(TEXT("a %d character event reassembled across reads, got %d characters"), SplitContent.Len(), Split.Response.Len()));
+
+    const FEvaluation ErrorEvent = Evaluate(IGIModule, Endpoint(TEXT("error")));
+    bPassed &= Expect(!ErrorEvent.bSucceeded, TEXT("error"), TEXT("an error event to fail the request"));
+
+    const FEvaluation Status = Evaluate(IGIModule, Endpoint(TEXT("status")));
+    bPassed &= Expect(!Status.bSucceeded, TEXT("status"), TEXT("HTTP 500 to fail the request"));
+
+    const FEvaluation Truncated = Evaluate(IGIModule, Endpoint(TEXT("truncated")));
+    bPassed &= Expect(!Truncated.bSucceeded && Truncated.Response == TEXT("The butler "), TEXT("truncated"),
+        FString::Printf(TEXT("a stream without [DONE] to fail and keep its partial reply, got '%s'"), *Truncated.Response));
+
+    const FEvaluation Silent = Evaluate(IGIModule, Endpoint(TEXT("silent")));
+    bPassed &= Expect(!Silent.bSucceeded && Silent.Seconds >= ActivityTimeout * 0.9f && Silent.Seconds < Settings->RemoteTimeoutSeconds * 0.5f, TEXT("silent"),
+        FString::Printf(TEXT("the %.1f s activity timeout, not the %.1f s total, to end it; took %.2f s"), ActivityTimeout, Settings->RemoteTimeoutSeconds, Silent.Seconds));
+
+    // The client has hung up; answering lets the connection close before the listener stops
+    for (const FHttpResultCallback& OnComplete : HeldReplies)
+    {
+        OnComplete(FHttpServerResponse::Create(FString(DoneEvent), TEXT("text/event-stream")));
+    }
+    for (const FHttpRouteHandle& Route : Routes)
+    {
+        Router->UnbindRoute(Route);
+    }
+    HttpServer.StopAllListeners();
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI remote test: %s"), bPassed ? TEXT("passed") : TEXT("FAILED"));
+    return bPassed ? 0 : 1;
+}
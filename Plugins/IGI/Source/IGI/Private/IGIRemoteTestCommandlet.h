@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "IGIRemoteTestCommandlet.generated.h"
+
+/**
+ * Checks the Remote backend headless against a stub chat completions server it hosts on localhost.
+ * Returns non-zero on any failure.
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=IGIRemoteTest [-Port=<port>] [-ActivityTimeout=<seconds>]
+ *
+ * The stub streams canned server-sent events: a normal reply ending in [DONE], a reply whose single
+ * event is far larger than one transport read, an error event, an HTTP error, a stream cut off before
+ * [DONE] and a server that never answers, which must trip the activity timeout. The reachability
+ * check is run against a live and a missing endpoint as well.
+ */
+UCLASS()
+class UIGIRemoteTestCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UIGIRemoteTestCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIReplayCommandlet.h"
+
+#include "CoreMinimal.h"
+#include "Misc/FileHelper.h"
+
+#include "IGIGPT.h"
+#include "IGILog.h"
+#include "IGIModule.h"
+#include "IGITrace.h"
+
+namespace
+{
+    struct FReplaySample
+    {
+        double TimeToFirstTokenMs = 0.0;
+        double LatencyMs = 0.0;
+        double DecodeMs = 0.0;
+        int32 NumTokens = 0;
+    };
+
+    // Nearest-rank percentile of an already sorted array
+    double Percentile(const TArray<double>& Sorted, double P)
+    {
+        if (Sorted.IsEmpty())
+        {
+            return 0.0;
+        }
+        const int32 Rank = FMath::Clamp(FMath::CeilToInt(P / 100.0 * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Rank];
+    }
+
+    void LogDistribution(const TCHAR* Label, TArray<double> Values)
+    {
+        Values.Sort();
+        UE_LOG(LogIGISDK, Display, TEXT("  %-16s p50 %8.1f ms   p95 %8.1f ms   p99 %8.1f ms"), Label, Percentile(Values, 50.0), Percentile(Values, 95.0), Percentile(Values, 99.0));
+    }
+}
+
+UIGIReplayCommandlet::UIGIReplayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UIGIReplayCommandlet::Main(const FString& Params)
+{
+    FString TracePath;
+    if (!FParse::Value(*Params, TEXT("Trace="), TracePath))
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("Usage: -run=IGIReplay -Trace=<file> [-Model=<GUID>] [-Backend=CUDA|CPU|Remote|Mock] [-ContextSize=<tokens>] [-Rate=Original|Max] [-Csv=<file>]"));
+        return 1;
+    }
+
+    TArray<FIGITraceEntry> Entries;
+    if (!FIGITraceRecorder::Load(TracePath, Entries) || Entries.IsEmpty())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI replay: no requests in %s"), *TracePath);
+        return 1;
+    }
+
+    FString ModelOverride;
+    FParse::Value(*Params, TEXT("Model="), ModelOverride);
+
+    TOptional<EIGIGPTBackend> BackendOverride;
+    FString BackendName;
+    if (FParse::Value(*Params, TEXT("Backend="), BackendName))
+    {
+        const int64 Value = StaticEnum<EIGIGPTBackend>()->GetValueByNameString(BackendName);
+        if (Value == INDEX_NONE)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI replay: unknown backend %s"), *BackendName);
+            return 1;
+        }
+        BackendOverride = static_cast<EIGIGPTBackend>(Value);
+    }
+
+    int32 ContextSize = 4096;
+    FParse::Value(*Params, TEXT("ContextSize="), ContextSize);
+
+    FString Rate = TEXT("Original");
+    FParse::Value(*Params, TEXT("Rate="), Rate);
+    const bool bMaxRate = Rate.Equals(TEXT("Max"), ESearchCase::IgnoreCase);
+
+    FIGIModule& IGIModule = FIGIModule::Get();
+    if (!IGIModule.LoadIGICore())
+    {
+        return 1;
+    }
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI replay: %d requests from %s at %s rate"), Entries.Num(), *TracePath, bMaxRate ? TEXT("max") : TEXT("original"));
+
+    TMap<FString, TUniquePtr<FIGIGPT>> Models;
+    TArray<FReplaySample> Samples;
+    Samples.Reserve(Entries.Num());
+
+    const double ReplayStartTime = FPlatformTime::Seconds();
+    for (const FIGITraceEntry& Entry : Entries)
+    {
+        FIGIGPTModelDesc Desc;
+        Desc.ModelGUID = ModelOverride.IsEmpty() ? Entry.ModelGUID : ModelOverride;
+        Desc.Backend = BackendOverride.Get(Entry.Backend);
+        Desc.ContextSize = ContextSize;
+
+        const FString ModelKey = Desc.ModelGUID + TEXT("@") + UEnum::GetValueAsString(Desc.Backend);
+        TUniquePtr<FIGIGPT>& GPT = Models.FindOrAdd(ModelKey);
+        if (!GPT.IsValid())
+        {
+            // Loading is not part of any request's latency, so do it before the request is due
+            GPT = MakeUnique<FIGIGPT>(&IGIModule, Desc);
+        }
+        if (!GPT->IsValid())
+        {
+            continue;
+        }
+
+        double ScheduledTime = FPlatformTime::Seconds();
+        if (!bMaxRate)
+        {
+            ScheduledTime = ReplayStartTime + Entry.StartSeconds;
+            const double Wait = ScheduledTime - FPlatformTime::Seconds();
+            if (Wait > 0.0)
+            {
+                FPlatformProcess::Sleep(static_cast<float>(Wait));
+            }
+        }
+
+        // Captured session caches belong to the original run, so requests replay cold
+        FIGIGPTRequest Request;
+        Request.SystemPrompt = Entry.SystemPrompt;
+        Request.UserPrompt = Entry.UserPrompt;
+        Request.AssistantPrompt = Entry.AssistantPrompt;
+        Request.TokensToPredict = Entry.TokensToPredict;
+        Request.Priority = Entry.Priority;
+
+        FIGIGPTTimings Timings;
+        GPT->Evaluate(Request, &Timings);
+
+        FReplaySample& Sample = Samples.AddDefaulted_GetRef();
+        Sample.TimeToFirstTokenMs = Timings.TimeToFirstTokenMs;
+        Sample.LatencyMs = (FPlatformTime::Seconds() - ScheduledTime) * 1000.0;
+        Sample.DecodeMs = Timings.TotalMs - Timings.TimeToFirstTokenMs;
+        Sample.NumTokens = Timings.NumTokens;
+    }
+
+    Models.Reset();
+    IGIModule.UnloadIGICore();
+
+    if (Samples.IsEmpty())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI replay: no model could be loaded"));
+        return 1;
+    }
+
+    TArray<double> CapturedTTFT;
+    TArray<double> CapturedLatency;
+    for (const FIGITraceEntry& Entry : Entries)
+    {
+        CapturedTTFT.Add(Entry.Timings.TimeToFirstTokenMs);
+        CapturedLatency.Add(Entry.WallMs);
+    }
+
+    TArray<double> TTFT;
+    TArray<double> Latency;
+    double DecodeMs = 0.0;
+    int64 DecodeTokens = 0;
+    for (const FReplaySample& Sample : Samples)
+    {
+        TTFT.Add(Sample.TimeToFirstTokenMs);
+        Latency.Add(Sample.LatencyMs);
+        if (Sample.NumTokens > 1)
+        {
+            DecodeMs += Sample.DecodeMs;
+            DecodeTokens += Sample.NumTokens - 1;
+        }
+    }
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI replay: %d of %d requests completed"), Samples.Num(), Entries.Num());
+    UE_LOG(LogIGISDK, Display, TEXT("Captured:"));
+    LogDistribution(TEXT("TTFT"), CapturedTTFT);
+    LogDistribution(TEXT("Latency"), CapturedLatency);
+    UE_LOG(LogIGISDK, Display, TEXT("Replayed:"));
+    LogDistribution(TEXT("TTFT"), TTFT);
+    LogDistribution(TEXT("Latency"), Latency);
+    UE_LOG(LogIGISDK, Display, TEXT("  %-16s %.1f tokens/s"), TEXT("Decode"), DecodeMs > 0.0 ? DecodeTokens * 1000.0 / DecodeMs : 0.0);
+
+    FString CsvPath;
+    if (FParse::Value(*Params, TEXT("Csv="), CsvPath))
+    {
+        FString Csv = TEXT("TimeToFirstTokenMs,LatencyMs,DecodeMs,NumTokens\n");
+        for (const FReplaySample& Sample : Samples)
+        {
+            Csv += FString::Printf(TEXT("%.3f,%.3f,%.3f,%d\n"), Sample.TimeToFirstTokenMs, Sample.LatencyMs, Sample.DecodeMs, Sample.NumTokens);
+        }
+        FFileHelper::SaveStringToFile(Csv, *CsvPath);
+    }
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "IGIReplayCommandlet.generated.h"
+
+/**
+ * Replays a captured GPT trace headless and reports TTFT, decode rate and latency percentiles.
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=IGIReplay -Trace=<file>
+ *        [-Model=<GUID>] [-Backend=CUDA|CPU|Remote|Mock] [-ContextSize=<tokens>] [-Rate=Original|Max] [-Csv=<file>]
+ *
+ * Model and backend default to whatever each request originally ran on. At the original rate requests
+ * are issued at their captured offsets and latency includes any time spent queued behind earlier ones;
+ * at max rate they are issued back to back and latency is service time only.
+ */
+UCLASS()
+class UIGIReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UIGIReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
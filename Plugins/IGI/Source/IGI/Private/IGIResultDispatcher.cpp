@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIResultDispatcher.h"
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+#include "IGILog.h"
+#include "IGISettings.h"
+
+class FIGIResultDispatcher::Impl
+{
+public:
+    Impl()
+    {
+        BudgetMs = GetDefault<UIGISettings>()->ResultDispatchBudgetMs;
+
+        PostWorldInitHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &Impl::OnPostWorldInitialization);
+        WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &Impl::OnWorldCleanup);
+    }
+
+    virtual ~Impl()
+    {
+        FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitHandle);
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+        for (TPair<UWorld*, TUniquePtr<FDrainTickFunction>>& Pair : WorldTicks)
+        {
+            Pair.Value->UnRegisterTickFunction();
+        }
+        WorldTicks.Empty();
+
+        // Nothing is left to deliver to at shutdown
+        const int32 Dropped = NumPending.load();
+        if (Dropped > 0)
+        {
+            UE_LOG(LogIGISDK, Verbose, TEXT("IGI: dropping %d undelivered results"), Dropped);
+        }
+    }
+
+    void Enqueue(TUniqueFunction<void()>&& Work)
+    {
+        ++NumPending;
+        Queue.Enqueue(MoveTemp(Work));
+    }
+
+    void Drain()
+    {
+        check(IsInGameThread());
+
+        // The world's tick function and the module's core ticker fallback both call this; the first one each frame drains
+        if (LastDrainFrame == GFrameCounter)
+        {
+            return;
+        }
+        LastDrainFrame = GFrameCounter;
+
+        // Always make progress, even if a single item takes longer than the budget
+        const double Deadline = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+        TUniqueFunction<void()> Work;
+        do
+        {
+            if (!Queue.Dequeue(Work))
+            {
+                return;
+            }
+            --NumPending;
+            Work();
+        } while (FPlatformTime::Seconds() < Deadline);
+    }
+
+    int32 GetNumPending() const
+    {
+        return NumPending.load();
+    }
+
+private:
+    /** Drains during TG_PrePhysics of a game world, so results land at the same point of every frame */
+    struct FDrainTickFunction : public FTickFunction
+    {
+        explicit FDrainTickFunction(Impl* InOwner)
+            : Owner(InOwner)
+        {
+            TickGroup = TG_PrePhysics;
+            EndTickGroup = TG_PrePhysics;
+            bCanEverTick = true;
+            bTickEvenWhenPaused = true;
+            bHighPriority = true;
+        }
+
+        virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override
+        {
+            Owner->Drain();
+        }
+
+        virtual FString DiagnosticMessage() override
+        {
+            return TEXT("FIGIResultDispatcher::Drain");
+        }
+
+        Impl* Owner;
+    };
+
+    void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+    {
+        if (World == nullptr || !World->IsGameWorld() || World->PersistentLevel == nullptr || WorldTicks.Contains(World))
+        {
+            return;
+        }
+
+        TUniquePtr<FDrainTickFunction>& Tick = WorldTicks.Add(World, MakeUnique<FDrainTickFunction>(this));
+        Tick->RegisterTickFunction(World->PersistentLevel);
+    }
+
+    void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+    {
+        TUniquePtr<FDrainTickFunction> Tick;
+        if (WorldTicks.RemoveAndCopyValue(World, Tick))
+        {
+            Tick->UnRegisterTickFunction();
+        }
+    }
+
+    TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Queue;
+    std::atomic<int32> NumPending{ 0 };
+    double BudgetMs{ 1.0 };
+
+    // Game thread only
+    uint64 LastDrainFrame{ MAX_uint64 };
+    TMap<UWorld*, TUniquePtr<FDrainTickFunction>> WorldTicks;
+    FDelegateHandle PostWorldInitHandle;
+    FDelegateHandle WorldCleanupHandle;
+};
+
+// ----------------------------------
+
+FIGIResultDispatcher::FIGIResultDispatcher()
+{
+    Pimpl = MakePimpl<FIGIResultDispatcher::Impl>();
+}
+
+FIGIResultDispatcher::~FIGIResultDispatcher() {}
+
+void FIGIResultDispatcher::Enqueue(TUniqueFunction<void()>&& Work)
+{
+    Pimpl->Enqueue(MoveTemp(Work));
+}
+
+void FIGIResultDispatcher::EnqueueChunk(const FIGIChunkStreamRef& Stream, const FString& Chunk)
+{
+    // Here rather than in Impl, which can't see the stream's internals
+    {
+        FScopeLock Lock(&Stream->CS);
+        Stream->Buffer += Chunk;
+    }
+
+    if (!Stream->bScheduled.exchange(true))
+    {
+        Pimpl->Enqueue([Stream]()
+            {
+                FString Chunks;
+                {
+                    FScopeLock Lock(&Stream->CS);
+                    Chunks = MoveTemp(Stream->Buffer);
+                    Stream->Buffer.Reset();
+                    // Cleared under the lock, so a chunk appended from here on schedules another delivery
+                    Stream->bScheduled = false;
+                }
+
+                if (!Chunks.IsEmpty())
+                {
+                    Stream->OnChunks(Chunks);
+                }
+            });
+    }
+}
+
+void FIGIResultDispatcher::Drain()
+{
+    Pimpl->Drain();
+}
+
+int32 FIGIResultDispatcher::GetNumPending() const
+{
+    return Pimpl->GetNumPending();
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGISettings.h"
+
+UIGISettings::UIGISettings()
+{
+    // Small tier ships unconfigured and shares the large model until a tiny GGUF is dropped into nvigi.models
+    SmallTier.VRAMBudgetMB = 1024 * 4;
+    SmallTier.ContextSize = 2048;
+    SmallTier.MaxQueueDepth = 2;
+
+    LargeTier.ModelGUID = TEXT("{8E31808B-C182-4016-9ED8-64804FF5B40D}"); // nemotron-4-mini-4b-instruct
+    LargeTier.VRAMBudgetMB = 1024 * 24;
+    LargeTier.ContextSize = 4096;
+    LargeTier.MaxQueueDepth = 1;
+
+    RemoteFallbackModelGUID = LargeTier.ModelGUID;
+}
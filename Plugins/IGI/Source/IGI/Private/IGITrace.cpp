@@ -0,0 +1,301 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGITrace.h"
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+#include "IGILog.h"
+#include "IGIModule.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr uint32 TRACE_MAGIC{ 0x54494749 }; // "IGIT"
+    // 2: priority classes split Background into ForegroundPrefetch, Ambient and Maintenance
+    // 3: LoRA adapter name after the assistant prompt
+    // 4: adapter name dropped again
+    constexpr uint32 TRACE_VERSION{ 4 };
+
+    constexpr uint8 FLAG_HAD_SESSION{ 1 << 0 };
+    constexpr uint8 FLAG_PREEMPTED{ 1 << 1 };
+
+    FString MakeDefaultTracePath()
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IGI"), TEXT("Traces"), FDateTime::Now().ToString() + TEXT(".igitrace"));
+    }
+
+    FAutoConsoleCommand TraceStartCommand(
+        TEXT("IGI.Trace.Start"),
+        TEXT("Start capturing GPT requests to a trace file. Optional argument: output path."),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+            {
+                FIGIModule::Get().GetTraceRecorder()->Start(Args.Num() > 0 ? Args[0] : FString());
+            }));
+
+    FAutoConsoleCommand TraceStopCommand(
+        TEXT("IGI.Trace.Stop"),
+        TEXT("Stop capturing GPT requests."),
+        FConsoleCommandDelegate::CreateLambda([]()
+            {
+                FIGIModule::Get().GetTraceRecorder()->Stop();
+            }));
+}
+
+class FIGITraceRecorder::Impl
+{
+public:
+    Impl() {}
+
+    virtual ~Impl()
+    {
+        Stop();
+    }
+
+    bool Start(const FString& InPath)
+    {
+        FScopeLock Lock(&CS);
+
+        CloseWriter();
+
+        Path = InPath.IsEmpty() ? MakeDefaultTracePath() : InPath;
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+        Writer.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_AllowRead));
+        if (!Writer.IsValid())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: unable to open trace file %s"), *Path);
+            return false;
+        }
+
+        uint32 Magic = TRACE_MAGIC;
+        uint32 Version = TRACE_VERSION;
+        *Writer << Magic << Version;
+        Writer->Flush();
+
+        CaptureStartTime = FPlatformTime::Seconds();
+        bRecording = true;
+
+        UE_LOG(LogIGISDK, Log, TEXT("IGI: capturing GPT trace to %s"), *Path);
+        return true;
+    }
+
+    void Stop()
+    {
+        FScopeLock Lock(&CS);
+        if (bRecording)
+        {
+            UE_LOG(LogIGISDK, Log, TEXT("IGI: GPT trace %s closed after %d requests"), *Path, NumRecorded);
+        }
+        CloseWriter();
+    }
+
+    bool IsRecording() const { return bRecording; }
+
+    FString GetPath() const
+    {
+        FScopeLock Lock(&CS);
+        return Path;
+    }
+
+    void Record(const FIGIGPTModelDesc& Model, const FIGIGPTRequest& Request, const FIGIGPTTimings& Timings, double StartTime, double EndTime)
+    {
+        FScopeLock Lock(&CS);
+        if (!Writer.IsValid())
+        {
+            return;
+        }
+
+        FArchive& Ar = *Writer;
+
+        double StartSeconds = StartTime - CaptureStartTime;
+        Ar << StartSeconds;
+
+        WriteString(Ar, Model.ModelGUID);
+        uint8 Backend = static_cast<uint8>(Model.Backend);
+        Ar << Backend;
+
+        WriteString(Ar, Request.SystemPrompt);
+        WriteString(Ar, Request.UserPrompt);
+        WriteString(Ar, Request.AssistantPrompt);
+
+        int32 TokensToPredict = Request.TokensToPredict;
+        uint8 Priority = static_cast<uint8>(Request.Priority);
+        uint8 Flags = (Request.SessionCachePath.IsEmpty() ? 0 : FLAG_HAD_SESSION) | (Timings.bPreempted ? FLAG_PREEMPTED : 0);
+        Ar << TokensToPredict << Priority << Flags;
+
+        float TimeToFirstTokenMs = static_cast<float>(Timings.TimeToFirstTokenMs);
+        float TotalMs = static_cast<float>(Timings.TotalMs);
+        float WallMs = static_cast<float>((EndTime - StartTime) * 1000.0);
+        int32 NumTokens = Timings.NumTokens;
+        Ar << TimeToFirstTokenMs << TotalMs << WallMs << NumTokens;
+
+        Ar.Flush();
+        ++NumRecorded;
+    }
+
+    static bool Load(const FString& InPath, TArray<FIGITraceEntry>& OutEntries)
+    {
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InPath));
+        if (!Reader.IsValid())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: unable to open trace file %s"), *InPath);
+            return false;
+        }
+
+        FArchive& Ar = *Reader;
+
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        Ar << Magic << Version;
+        if (Magic != TRACE_MAGIC || Version < 1 || Version > TRACE_VERSION)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: %s is not a GPT trace of version %u or older"), *InPath, TRACE_VERSION);
+            return false;
+        }
+
+        TArray<FString> Strings;
+        while (!Ar.AtEnd())
+        {
+            FIGITraceEntry Entry;
+            uint8 Backend = 0;
+            uint8 Priority = 0;
+            uint8 Flags = 0;
+            float TimeToFirstTokenMs = 0.f;
+            float TotalMs = 0.f;
+            float WallMs = 0.f;
+
+            Ar << Entry.StartSeconds;
+            bool bValid = ReadString(Ar, Strings, Entry.ModelGUID);
+            Ar << Backend;
+            bValid = bValid && ReadString(Ar, Strings, Entry.SystemPrompt);
+            bValid = bValid && ReadString(Ar, Strings, Entry.UserPrompt);
+            bValid = bValid && ReadString(Ar, Strings, Entry.AssistantPrompt);
+            if (Version == 3)
+            {
+                FString LoRAAdapter;
+                bValid = bValid && ReadString(Ar, Strings, LoRAAdapter);
+            }
+            Ar << Entry.TokensToPredict << Priority << Flags;
+            Ar << TimeToFirstTokenMs << TotalMs << WallMs << Entry.Timings.NumTokens;
+
+            // A crash mid-write leaves a truncated last entry; everything before it is still usable
+            if (!bValid || Ar.IsError())
+            {
+                UE_LOG(LogIGISDK, Warning, TEXT("IGI: trace %s is truncated after %d entries"), *InPath, OutEntries.Num());
+                break;
+            }
+
+            Entry.Backend = static_cast<EIGIGPTBackend>(Backend);
+            // Version 1 only had Interactive and Background; the latter is now Ambient
+            Entry.Priority = (Version == 1 && Priority != 0) ? EIGIRequestPriority::Ambient : static_cast<EIGIRequestPriority>(Priority);
+            Entry.bHadSession = (Flags & FLAG_HAD_SESSION) != 0;
+            Entry.Timings.bPreempted = (Flags & FLAG_PREEMPTED) != 0;
+            Entry.Timings.TimeToFirstTokenMs = TimeToFirstTokenMs;
+            Entry.Timings.TotalMs = TotalMs;
+            Entry.WallMs = WallMs;
+            OutEntries.Add(MoveTemp(Entry));
+        }
+
+        return true;
+    }
+
+private:
+    // Strings are written as an index into a table built while writing; the first use of a string carries its text
+    void WriteString(FArchive& Ar, const FString& String)
+    {
+        int32 Index = StringIndices.FindOrAdd(String, StringIndices.Num());
+        const bool bNew = Index == NumWrittenStrings;
+        Ar << Index;
+        if (bNew)
+        {
+            FString Text = String;
+            Ar << Text;
+            ++NumWrittenStrings;
+        }
+    }
+
+    static bool ReadString(FArchive& Ar, TArray<FString>& Strings, FString& OutString)
+    {
+        int32 Index = INDEX_NONE;
+        Ar << Index;
+        if (Index == Strings.Num())
+        {
+            Ar << Strings.AddDefaulted_GetRef();
+        }
+        else if (!Strings.IsValidIndex(Index))
+        {
+            return false;
+        }
+        OutString = Strings[Index];
+        return true;
+    }
+
+    void CloseWriter()
+    {
+        bRecording = false;
+        if (Writer.IsValid())
+        {
+            Writer->Close();
+            Writer.Reset();
+        }
+        StringIndices.Reset();
+        NumWrittenStrings = 0;
+        NumRecorded = 0;
+    }
+
+    mutable FCriticalSection CS;
+    std::atomic<bool> bRecording{ false };
+
+    FString Path;
+    TUniquePtr<FArchive> Writer;
+    double CaptureStartTime{ 0.0 };
+
+    TMap<FString, int32> StringIndices;
+    int32 NumWrittenStrings{ 0 };
+    int32 NumRecorded{ 0 };
+};
+
+// ----------------------------------
+
+FIGITraceRecorder::FIGITraceRecorder()
+{
+    Pimpl = MakePimpl<FIGITraceRecorder::Impl>();
+}
+
+FIGITraceRecorder::~FIGITraceRecorder() {}
+
+bool FIGITraceRecorder::Start(const FString& Path)
+{
+    return Pimpl->Start(Path);
+}
+
+void FIGITraceRecorder::Stop()
+{
+    Pimpl->Stop();
+}
+
+bool FIGITraceRecorder::IsRecording() const
+{
+    return Pimpl->IsRecording();
+}
+
+FString FIGITraceRecorder::GetPath() const
+{
+    return Pimpl->GetPath();
+}
+
+void FIGITraceRecorder::Record(const FIGIGPTModelDesc& Model, const FIGIGPTRequest& Request, const FIGIGPTTimings& Timings, double StartTime, double EndTime)
+{
+    Pimpl->Record(Model, Request, Timings, StartTime, EndTime);
+}
+
+bool FIGITraceRecorder::Load(const FString& Path, TArray<FIGITraceEntry>& OutEntries)
+{
+    return FIGITraceRecorder::Impl::Load(Path, OutEntries);
+}
@@ -0,0 +1,590 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIVectorIndex.h"
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Math/VectorRegister.h"
+#include "Misc/ScopeRWLock.h"
+
+#include "IGILog.h"
+
+namespace
+{
+    constexpr uint32 INDEX_MAGIC{ 'I' | ('G' << 8) | ('V' << 16) | ('X' << 24) };
+    constexpr uint32 INDEX_VERSION{ 1 };
+
+    // HNSW graph shape: links per node above and at the base layer, and candidate list sizes
+    constexpr int32 HNSW_M{ 16 };
+    constexpr int32 HNSW_M0{ 2 * HNSW_M };
+    constexpr int32 HNSW_EF_CONSTRUCTION{ 100 };
+    constexpr int32 HNSW_EF_SEARCH{ 64 };
+
+    // Highest layer a node is ever given
+    constexpr int32 HNSW_MAX_LEVEL{ 16 };
+
+    using FAlignedFloats = TArray<float, TAlignedHeapAllocator<16>>;
+
+    /** Both pointers 16-byte aligned, Stride a multiple of 4 */
+    float DotProduct(const float* A, const float* B, int32 Stride)
+    {
+        VectorRegister4Float Sum = VectorZeroFloat();
+        for (int32 Index = 0; Index < Stride; Index += 4)
+        {
+            Sum = VectorMultiplyAdd(VectorLoadAligned(A + Index), VectorLoadAligned(B + Index), Sum);
+        }
+
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(Sum, Lanes);
+        return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+    }
+
+    struct FScored
+    {
+        int32 Slot;
+        float Score;
+    };
+
+    // Heap predicates: the first keeps the best candidate on top, the second the worst result
+    const auto BestFirst = [](const FScored& A, const FScored& B) { return A.Score > B.Score; };
+    const auto WorstFirst = [](const FScored& A, const FScored& B) { return A.Score < B.Score; };
+}
+
+class FIGIVectorIndex::Impl
+{
+public:
+    Impl(int32 InDimension, EIGIVectorIndexType InType)
+    {
+        Init(InDimension, InType);
+    }
+
+    virtual ~Impl() {}
+
+    void Add(int64 Id, TConstArrayView<float> Vector)
+    {
+        if (Vector.Num() != Dimension || Dimension == 0)
+        {
+            UE_LOG(LogIGISDK, Warning, TEXT("IGI: vector of size %d added to an index of dimension %d"), Vector.Num(), Dimension);
+            return;
+        }
+
+        FWriteScopeLock Lock(RWLock);
+
+        if (const int32* Existing = SlotById.Find(Id))
+        {
+            if (Type == EIGIVectorIndexType::Flat)
+            {
+                FMemory::Memcpy(GetVector(*Existing), Vector.GetData(), Dimension * sizeof(float));
+                return;
+            }
+            // Graph links were chosen for the old vector, so the new one goes in as a fresh node
+            RemoveLocked(Id);
+        }
+
+        const int32 Slot = Ids.Add(Id);
+        Deleted.Add(false);
+        Vectors.AddZeroed(Stride);
+        FMemory::Memcpy(GetVector(Slot), Vector.GetData(), Dimension * sizeof(float));
+        SlotById.Add(Id, Slot);
+
+        if (Type == EIGIVectorIndexType::HNSW)
+        {
+            InsertIntoGraph(Slot);
+        }
+    }
+
+    bool Remove(int64 Id)
+    {
+        FWriteScopeLock Lock(RWLock);
+        return RemoveLocked(Id);
+    }
+
+    bool Contains(int64 Id) const
+    {
+        FReadScopeLock Lock(RWLock);
+        return SlotById.Contains(Id);
+    }
+
+    void Reset()
+    {
+        FWriteScopeLock Lock(RWLock);
+        Init(Dimension, Type);
+    }
+
+    int32 Num() const
+    {
+        FReadScopeLock Lock(RWLock);
+        return SlotById.Num();
+    }
+
+    int32 GetDimension() const { return Dimension; }
+    EIGIVectorIndexType GetType() const { return Type; }
+
+    TArray<FIGIVectorSearchResult> Search(TConstArrayView<float> Query, int32 K) const
+    {
+        TArray<FIGIVectorSearchResult> Results;
+        if (Query.Num() != Dimension || K <= 0)
+        {
+            return Results;
+        }
+
+        FAlignedFloats Padded;
+        Padded.SetNumZeroed(Stride);
+        FMemory::Memcpy(Padded.GetData(), Query.GetData(), Dimension * sizeof(float));
+
+        FReadScopeLock Lock(RWLock);
+
+        TArray<FScored> Best = Type == EIGIVectorIndexType::Flat ? SearchFlat(Padded.GetData(), K) : SearchGraph(Padded.GetData(), K);
+        Best.Sort(BestFirst);
+        Results.Reserve(Best.Num());
+        for (const FScored& Scored : Best)
+        {
+            Results.Add({ Ids[Scored.Slot], Scored.Score });
+        }
+        return Results;
+    }
+
+    void Save(FArchive& Ar) const
+    {
+        FReadScopeLock Lock(RWLock);
+
+        uint32 Magic = INDEX_MAGIC;
+        uint32 Version = INDEX_VERSION;
+        int32 SavedDimension = Dimension;
+        uint8 SavedType = static_cast<uint8>(Type);
+        Ar << Magic << Version << SavedDimension << SavedType;
+
+        // The archive API is non-const; these are only read from
+        Ar << const_cast<TArray<int64>&>(Ids);
+        Ar << const_cast<TBitArray<>&>(Deleted);
+        Ar << const_cast<FAlignedFloats&>(Vectors);
+
+        if (Type == EIGIVectorIndexType::HNSW)
+        {
+            int32 SavedEntryPoint = EntryPoint;
+            int32 SavedMaxLevel = MaxLevel;
+            Ar << SavedEntryPoint << SavedMaxLevel;
+            for (const TArray<TArray<int32>>& NodeLinks : Links)
+            {
+                Ar << const_cast<TArray<TArray<int32>>&>(NodeLinks);
+            }
+        }
+    }
+
+    bool Load(FArchive& Ar)
+    {
+        FWriteScopeLock Lock(RWLock);
+
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        int32 LoadedDimension = 0;
+        uint8 LoadedType = 0;
+        Ar << Magic << Version << LoadedDimension << LoadedType;
+        if (Ar.IsError() || Magic != INDEX_MAGIC || Version != INDEX_VERSION || LoadedDimension <= 0 || LoadedType > static_cast<uint8>(EIGIVectorIndexType::HNSW))
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: not a version %u vector index"), INDEX_VERSION);
+            Ar.SetError();
+            return false;
+        }
+
+        Init(LoadedDimension, static_cast<EIGIVectorIndexType>(LoadedType));
+        Ar << Ids << Deleted << Vectors;
+
+        if (Type == EIGIVectorIndexType::HNSW)
+        {
+            Ar << EntryPoint << MaxLevel;
+            Links.SetNum(Ids.Num());
+            for (TArray<TArray<int32>>& NodeLinks : Links)
+            {
+                Ar << NodeLinks;
+            }
+        }
+
+        if (Ar.IsError() || Deleted.Num() != Ids.Num() || Vectors.Num() != Ids.Num() * Stride
+            || (Type == EIGIVectorIndexType::HNSW && !IsGraphValid()))
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI: vector index is truncated or corrupt"));
+            Init(Dimension, Type);
+            return false;
+        }
+
+        for (int32 Slot = 0; Slot < Ids.Num(); ++Slot)
+        {
+            if (!Deleted[Slot])
+            {
+                SlotById.Add(Ids[Slot], Slot);
+            }
+        }
+        return true;
+    }
+
+private:
+    void Init(int32 InDimension, EIGIVectorIndexType InType)
+    {
+        Dimension = FMath::Max(0, InDimension);
+        Stride = Align(Dimension, 4);
+        Type = InType;
+
+        Ids.Reset();
+        Deleted.Empty();
+        Vectors.Reset();
+        SlotById.Reset();
+        Links.Reset();
+        EntryPoint = INDEX_NONE;
+        MaxLevel = 0;
+        Random.Initialize(0x16C0FFEE);
+    }
+
+    /** Searches index Links and vectors by every slot they reach, so a loaded graph must stay inside the arrays */
+    bool IsGraphValid() const
+    {
+        const int32 NumSlots = Ids.Num();
+        if (NumSlots == 0)
+        {
+            return EntryPoint == INDEX_NONE && MaxLevel == 0;
+        }
+        if (EntryPoint < 0 || EntryPoint >= NumSlots || MaxLevel < 0 || MaxLevel > HNSW_MAX_LEVEL || Links[EntryPoint].Num() != MaxLevel + 1)
+        {
+            return false;
+        }
+
+        for (const TArray<TArray<int32>>& NodeLinks : Links)
+        {
+            if (NodeLinks.IsEmpty() || NodeLinks.Num() > MaxLevel + 1)
+            {
+                return false;
+            }
+            for (int32 Level = 0; Level < NodeLinks.Num(); ++Level)
+            {
+                for (int32 Neighbour : NodeLinks[Level])
+                {
+                    // A neighbour on a layer must have links on that layer too
+                    if (Neighbour < 0 || Neighbour >= NumSlots || Links[Neighbour].Num() <= Level)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    float* GetVector(int32 Slot) { return Vectors.GetData() + Slot * Stride; }
+    const float* GetVector(int32 Slot) const { return Vectors.GetData() + Slot * Stride; }
+
+    bool RemoveLocked(int64 Id)
+    {
+        int32 Slot = INDEX_NONE;
+        if (!SlotById.RemoveAndCopyValue(Id, Slot))
+        {
+            return false;
+        }
+
+        if (Type == EIGIVectorIndexType::HNSW)
+        {
+            // The node stays in the graph as a waypoint; searches just never return it
+            Deleted[Slot] = true;
+            return true;
+        }
+
+        // Flat: move the last vector into the hole
+        const int32 Last = Ids.Num() - 1;
+        if (Slot != Last)
+        {
+            Ids[Slot] = Ids[Last];
+            FMemory::Memcpy(GetVector(Slot), GetVector(Last), Stride * sizeof(float));
+            SlotById[Ids[Slot]] = Slot;
+        }
+        Ids.RemoveAt(Last, EAllowShrinking::No);
+        Deleted.RemoveAt(Last);
+        Vectors.RemoveAt(Last * Stride, Stride, EAllowShrinking::No);
+        return true;
+    }
+
+    TArray<FScored> SearchFlat(const float* Query, int32 K) const
+    {
+        TArray<FScored> Heap;
+        Heap.Reserve(K + 1);
+        for (int32 Slot = 0; Slot < Ids.Num(); ++Slot)
+        {
+            const float Score = DotProduct(Query, GetVector(Slot), Stride);
+            if (Heap.Num() < K)
+            {
+                Heap.HeapPush({ Slot, Score }, WorstFirst);
+            }
+            else if (Score > Heap.HeapTop().Score)
+            {
+                Heap.HeapPopDiscard(WorstFirst, EAllowShrinking::No);
+                Heap.HeapPush({ Slot, Score }, WorstFirst);
+            }
+        }
+        return Heap;
+    }
+
+    TArray<FScored> SearchGraph(const float* Query, int32 K) const
+    {
+        if (EntryPoint == INDEX_NONE)
+        {
+            return TArray<FScored>();
+        }
+
+        int32 Current = EntryPoint;
+        for (int32 Level = MaxLevel; Level > 0; --Level)
+        {
+            Current = GreedyClosest(Query, Current, Level);
+        }
+
+        // Tombstoned nodes take up room in the candidate list, so widen it by how many there are
+        const int32 NumDeleted = Ids.Num() - SlotById.Num();
+        const int32 Ef = FMath::Max(K, HNSW_EF_SEARCH) + FMath::Min(NumDeleted, 4 * K);
+        TArray<FScored> Found = SearchLayer(Query, Current, Ef, 0);
+
+        Found.RemoveAll([this](const FScored& Scored) { return Deleted[Scored.Slot]; });
+        Found.Sort(BestFirst);
+        if (Found.Num() > K)
+        {
+            Found.SetNum(K);
+        }
+        return Found;
+    }
+
+    /** Walk to the neighbour closest to Query on one layer until nothing closer is linked */
+    int32 GreedyClosest(const float* Query, int32 Start, int32 Level) const
+    {
+        int32 Current = Start;
+        float CurrentScore = DotProduct(Query, GetVector(Current), Stride);
+        for (bool bImproved = true; bImproved; )
+        {
+            bImproved = false;
+            for (int32 Neighbour : Links[Current][Level])
+            {
+                const float Score = DotProduct(Query, GetVector(Neighbour), Stride);
+                if (Score > CurrentScore)
+                {
+                    Current = Neighbour;
+                    CurrentScore = Score;
+                    bImproved = true;
+                }
+            }
+        }
+        return Current;
+    }
+
+    /** Best-first search of one layer keeping the Ef best nodes seen */
+    TArray<FScored> SearchLayer(const float* Query, int32 Entry, int32 Ef, int32 Level) const
+    {
+        TBitArray<> Visited(false, Ids.Num());
+        Visited[Entry] = true;
+
+        const FScored Start{ Entry, DotProduct(Query, GetVector(Entry), Stride) };
+        TArray<FScored> Candidates;
+        Candidates.HeapPush(Start, BestFirst);
+        TArray<FScored> Results;
+        Results.HeapPush(Start, WorstFirst);
+
+        while (!Candidates.IsEmpty())
+        {
+            FScored Candidate;
+            Candidates.HeapPop(Candidate, BestFirst, EAllowShrinking::No);
+            if (Results.Num() >= Ef && Candidate.Score < Results.HeapTop().Score)
+            {
+                break;
+            }
+
+            for (int32 Neighbour : Links[Candidate.Slot][Level])
+            {
+                if (Visited[Neighbour])
+                {
+                    continue;
+                }
+                Visited[Neighbour] = true;
+
+                const float Score = DotProduct(Query, GetVector(Neighbour), Stride);
+                if (Results.Num() < Ef || Score > Results.HeapTop().Score)
+                {
+                    Candidates.HeapPush({ Neighbour, Score }, BestFirst);
+                    Results.HeapPush({ Neighbour, Score }, WorstFirst);
+                    if (Results.Num() > Ef)
+                    {
+                        Results.HeapPopDiscard(WorstFirst, EAllowShrinking::No);
+                    }
+                }
+            }
+        }
+        return Results;
+    }
+
+    void InsertIntoGraph(int32 Slot)
+    {
+        // Levels follow the usual exponential distribution with a 1/ln(M) scale
+        const float Uniform = FMath::Max(Random.GetFraction(), UE_SMALL_NUMBER);
+        const int32 Level = FMath::Min(FMath::FloorToInt32(-FMath::Loge(Uniform) / FMath::Loge(static_cast<float>(HNSW_M))), HNSW_MAX_LEVEL);
+
+        TArray<TArray<int32>>& NodeLinks = Links.AddDefaulted_GetRef();
+        check(Links.Num() == Slot + 1);
+        NodeLinks.SetNum(Level + 1);
+
+        if (EntryPoint == INDEX_NONE)
+        {
+            EntryPoint = Slot;
+            MaxLevel = Level;
+            return;
+        }
+
+        const float* Query = GetVector(Slot);
+        int32 Current = EntryPoint;
+        for (int32 Layer = MaxLevel; Layer > Level; --Layer)
+        {
+            Current = GreedyClosest(Query, Current, Layer);
+        }
+
+        for (int32 Layer = FMath::Min(Level, MaxLevel); Layer >= 0; --Layer)
+        {
+            TArray<FScored> Found = SearchLayer(Query, Current, HNSW_EF_CONSTRUCTION, Layer);
+            Found.Sort(BestFirst);
+
+            const int32 MaxLinks = Layer == 0 ? HNSW_M0 : HNSW_M;
+            for (int32 Index = 0; Index < FMath::Min(MaxLinks, Found.Num()); ++Index)
+            {
+                const int32 Neighbour = Found[Index].Slot;
+                Links[Slot][Layer].Add(Neighbour);
+                Links[Neighbour][Layer].Add(Slot);
+                if (Links[Neighbour][Layer].Num() > MaxLinks)
+                {
+                    PruneLinks(Neighbour, Layer, MaxLinks);
+                }
+            }
+            Current = Found[0].Slot;
+        }
+
+        if (Level > MaxLevel)
+        {
+            EntryPoint = Slot;
+            MaxLevel = Level;
+        }
+    }
+
+    /** Keep a node's MaxLinks closest neighbours on one layer */
+    void PruneLinks(int32 Slot, int32 Layer, int32 MaxLinks)
+    {
+        TArray<FScored> Scored;
+        for (int32 Neighbour : Links[Slot][Layer])
+        {
+            Scored.Add({ Neighbour, DotProduct(GetVector(Slot), GetVector(Neighbour), Stride) });
+        }
+        Scored.Sort(BestFirst);
+
+        TArray<int32>& Kept = Links[Slot][Layer];
+        Kept.Reset();
+        for (int32 Index = 0; Index < MaxLinks; ++Index)
+        {
+            Kept.Add(Scored[Index].Slot);
+        }
+    }
+
+    mutable FRWLock RWLock;
+
+    int32 Dimension{ 0 };
+    int32 Stride{ 0 };
+    EIGIVectorIndexType Type{ EIGIVectorIndexType::Flat };
+
+    // Per slot: id, tombstone and vector (zero-padded to Stride)
+    TArray<int64> Ids;
+    TBitArray<> Deleted;
+    FAlignedFloats Vectors;
+    TMap<int64, int32> SlotById;
+
+    // HNSW only: per slot, per layer, linked slots
+    TArray<TArray<TArray<int32>>> Links;
+    int32 EntryPoint{ INDEX_NONE };
+    int32 MaxLevel{ 0 };
+    FRandomStream Random;
+};
+
+// ----------------------------------
+
+FIGIVectorIndex::FIGIVectorIndex(int32 Dimension, EIGIVectorIndexType Type)
+{
+    Pimpl = MakePimpl<FIGIVectorIndex::Impl>(Dimension, Type);
+}
+
+FIGIVectorIndex::~FIGIVectorIndex() {}
+
+void FIGIVectorIndex::Add(int64 Id, TConstArrayView<float> Vector)
+{
+    Pimpl->Add(Id, Vector);
+}
+
+bool FIGIVectorIndex::Remove(int64 Id)
+{
+    return Pimpl->Remove(Id);
+}
+
+bool FIGIVectorIndex::Contains(int64 Id) const
+{
+    return Pimpl->Contains(Id);
+}
+
+void FIGIVectorIndex::Reset()
+{
+    Pimpl->Reset();
+}
+
+int32 FIGIVectorIndex::Num() const
+{
+    return Pimpl->Num();
+}
+
+int32 FIGIVectorIndex::GetDimension() const
+{
+    return Pimpl->GetDimension();
+}
+
+EIGIVectorIndexType FIGIVectorIndex::GetType() const
+{
+    return Pimpl->GetType();
+}
+
+TArray<FIGIVectorSearchResult> FIGIVectorIndex::Search(TConstArrayView<float> Query, int32 K) const
+{
+    return Pimpl->Search(Query, K);
+}
+
+void FIGIVectorIndex::Serialize(FArchive& Ar)
+{
+    if (Ar.IsLoading())
+    {
+        Pimpl->Load(Ar);
+    }
+    else
+    {
+        Pimpl->Save(Ar);
+    }
+}
+
+bool FIGIVectorIndex::SaveToFile(const FString& Path) const
+{
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+    if (!Writer.IsValid())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI: unable to write vector index %s"), *Path);
+        return false;
+    }
+    Pimpl->Save(*Writer);
+    return Writer->Close();
+}
+
+bool FIGIVectorIndex::LoadFromFile(const FString& Path)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader.IsValid())
+    {
+        UE_LOG(LogIGISDK, Error, TEXT("IGI: unable to open vector index %s"), *Path);
+        return false;
+    }
+    return Pimpl->Load(*Reader);
+}
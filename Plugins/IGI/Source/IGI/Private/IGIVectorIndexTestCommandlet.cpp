@@ -0,0 +1,242 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "IGIVectorIndexTestCommandlet.h"
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "IGILog.h"
+#include "IGIVectorIndex.h"
+
+namespace
+{
+    // Must match the header IGIVectorIndex.cpp writes
+    constexpr uint32 INDEX_MAGIC{ 'I' | ('G' << 8) | ('V' << 16) | ('X' << 24) };
+    constexpr uint32 INDEX_VERSION{ 1 };
+
+    TArray<float> RandomUnitVector(FRandomStream& Random, int32 Dimension)
+    {
+        TArray<float> Vector;
+        Vector.SetNumUninitialized(Dimension);
+        float SquaredLength = 0.f;
+        for (float& Value : Vector)
+        {
+            Value = Random.FRandRange(-1.f, 1.f);
+            SquaredLength += Value * Value;
+        }
+
+        const float Scale = FMath::InvSqrt(FMath::Max(SquaredLength, UE_SMALL_NUMBER));
+        for (float& Value : Vector)
+        {
+            Value *= Scale;
+        }
+        return Vector;
+    }
+
+    bool SameResults(const TArray<FIGIVectorSearchResult>& A, const TArray<FIGIVectorSearchResult>& B)
+    {
+        if (A.Num() != B.Num())
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            if (A[Index].Id != B[Index].Id || A[Index].Score != B[Index].Score)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Save Index, load it into a fresh one and check every query gives identical results */
+    bool CheckRoundTrip(const FIGIVectorIndex& Index, const TArray<TArray<float>>& Queries, int32 K, const FString& Path)
+    {
+        const TCHAR* TypeName = Index.GetType() == EIGIVectorIndexType::HNSW ? TEXT("HNSW") : TEXT("flat");
+        FIGIVectorIndex Loaded;
+        if (!Index.SaveToFile(Path) || !Loaded.LoadFromFile(Path))
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI vector index test: %s index did not save and load"), TypeName);
+            return false;
+        }
+
+        if (Loaded.Num() != Index.Num() || Loaded.GetDimension() != Index.GetDimension() || Loaded.GetType() != Index.GetType())
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI vector index test: %s index came back with %d vectors of %d floats, saved %d of %d"),
+                TypeName, Loaded.Num(), Loaded.GetDimension(), Index.Num(), Index.GetDimension());
+            return false;
+        }
+
+        for (int32 Query = 0; Query < Queries.Num(); ++Query)
+        {
+            if (!SameResults(Index.Search(Queries[Query], K), Loaded.Search(Queries[Query], K)))
+            {
+                UE_LOG(LogIGISDK, Error, TEXT("IGI vector index test: loaded %s index answers query %d differently"), TypeName, Query);
+                return false;
+            }
+        }
+
+        UE_LOG(LogIGISDK, Display, TEXT("IGI vector index test: %s index round trip OK"), TypeName);
+        return true;
+    }
+
+    /** A one-node HNSW file whose entry point or link points past the node */
+    TArray<uint8> MakeCorruptGraph(int32 EntryPoint, int32 Link)
+    {
+        constexpr int32 Dimension = 4;
+
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        uint32 Magic = INDEX_MAGIC;
+        uint32 Version = INDEX_VERSION;
+        int32 SavedDimension = Dimension;
+        uint8 SavedType = static_cast<uint8>(EIGIVectorIndexType::HNSW);
+        Writer << Magic << Version << SavedDimension << SavedType;
+
+        TArray<int64> Ids{ 1 };
+        TBitArray<> Deleted(false, 1);
+        TArray<float, TAlignedHeapAllocator<16>> Vectors;
+        Vectors.Init(0.5f, Dimension);
+        Writer << Ids << Deleted << Vectors;
+
+        int32 MaxLevel = 0;
+        TArray<TArray<int32>> NodeLinks;
+        NodeLinks.AddDefaulted();
+        if (Link != INDEX_NONE)
+        {
+            NodeLinks[0].Add(Link);
+        }
+        Writer << EntryPoint << MaxLevel << NodeLinks;
+        return Bytes;
+    }
+
+    bool CheckRejected(const TArray<uint8>& Bytes, const FString& Path, const TCHAR* What)
+    {
+        FIGIVectorIndex Loaded;
+        if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI vector index test: unable to write %s"), *Path);
+            return false;
+        }
+        if (Loaded.LoadFromFile(Path) || Loaded.Num() != 0)
+        {
+            UE_LOG(LogIGISDK, Error, TEXT("IGI vector index test: loaded a file with %s"), What);
+            return false;
+        }
+
+        UE_LOG(LogIGISDK, Display, TEXT("IGI vector index test: rejected a file with %s"), What);
+        return true;
+    }
+}
+
+UIGIVectorIndexTestCommandlet::UIGIVectorIndexTestCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UIGIVectorIndexTestCommandlet::Main(const FString& Params)
+{
+    int32 NumVectors = 5000;
+    int32 Dimension = 384;
+    int32 NumQueries = 200;
+    int32 K = 10;
+    float MinRecall = 0.9f;
+    FParse::Value(*Params, TEXT("Num="), NumVectors);
+    FParse::Value(*Params, TEXT("Dimension="), Dimension);
+    FParse::Value(*Params, TEXT("Queries="), NumQueries);
+    FParse::Value(*Params, TEXT("K="), K);
+    FParse::Value(*Params, TEXT("MinRecall="), MinRecall);
+    NumVectors = FMath::Max(NumVectors, 1);
+    Dimension = FMath::Max(Dimension, 1);
+    NumQueries = FMath::Max(NumQueries, 1);
+    K = FMath::Clamp(K, 1, NumVectors);
+
+    FRandomStream Random(0x1D3A7E57);
+    FIGIVectorIndex Flat(Dimension, EIGIVectorIndexType::Flat);
+    FIGIVectorIndex Graph(Dimension, EIGIVectorIndexType::HNSW);
+
+    const double BuildStartTime = FPlatformTime::Seconds();
+    for (int32 Id = 0; Id < NumVectors; ++Id)
+    {
+        const TArray<float> Vector = RandomUnitVector(Random, Dimension);
+        Flat.Add(Id, Vector);
+        Graph.Add(Id, Vector);
+    }
+
+    // Every tenth vector goes again: the flat index compacts, the graph keeps tombstones
+    for (int32 Id = 0; Id < NumVectors; Id += 10)
+    {
+        Flat.Remove(Id);
+        Graph.Remove(Id);
+    }
+    UE_LOG(LogIGISDK, Display, TEXT("IGI vector index test: %d vectors of %d floats indexed in %.1f ms"), Flat.Num(), Dimension, (FPlatformTime::Seconds() - BuildStartTime) * 1000.0);
+
+    TArray<TArray<float>> Queries;
+    for (int32 Query = 0; Query < NumQueries; ++Query)
+    {
+        Queries.Add(RandomUnitVector(Random, Dimension));
+    }
+
+    bool bPassed = true;
+
+    // Recall@K of the graph against the exact answer
+    int32 Hits = 0;
+    int32 Expected = 0;
+    for (const TArray<float>& Query : Queries)
+    {
+        const TArray<FIGIVectorSearchResult> Exact = Flat.Search(Query, K);
+        const TArray<FIGIVectorSearchResult> Approximate = Graph.Search(Query, K);
+
+        TSet<int64> ExactIds;
+        for (const FIGIVectorSearchResult& Result : Exact)
+        {
+            ExactIds.Add(Result.Id);
+        }
+        for (const FIGIVectorSearchResult& Result : Approximate)
+        {
+            if (Result.Id % 10 == 0)
+            {
+                UE_LOG(LogIGISDK, Error, TEXT("IGI vector index test: HNSW returned removed id %lld"), Result.Id);
+                bPassed = false;
+            }
+            Hits += ExactIds.Contains(Result.Id) ? 1 : 0;
+        }
+        Expected += Exact.Num();
+    }
+
+    const float Recall = Expected > 0 ? static_cast<float>(Hits) / Expected : 1.f;
+    UE_LOG(LogIGISDK, Display, TEXT("IGI vector index test: HNSW recall@%d %.3f over %d queries (minimum %.3f)"), K, Recall, NumQueries, MinRecall);
+    if (Recall < MinRecall)
+    {
+        bPassed = false;
+    }
+
+    const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("IGI"), TEXT("VectorIndexTest"));
+    bPassed &= CheckRoundTrip(Flat, Queries, K, FPaths::Combine(Directory, TEXT("Flat.igvx")));
+    bPassed &= CheckRoundTrip(Graph, Queries, K, FPaths::Combine(Directory, TEXT("Graph.igvx")));
+
+    // Loading must refuse graphs a search would follow out of bounds
+    const FString CorruptPath = FPaths::Combine(Directory, TEXT("Corrupt.igvx"));
+    bPassed &= CheckRejected(MakeCorruptGraph(1, INDEX_NONE), CorruptPath, TEXT("an entry point past the last node"));
+    bPassed &= CheckRejected(MakeCorruptGraph(0, 7), CorruptPath, TEXT("a link past the last node"));
+    bPassed &= CheckRejected(MakeCorruptGraph(0, -2), CorruptPath, TEXT("a negative link"));
+
+    TArray<uint8> Truncated;
+    FFileHelper::LoadFileToArray(Truncated, *FPaths::Combine(Directory, TEXT("Graph.igvx")));
+    Truncated.SetNum(Truncated.Num() / 2);
+    bPassed &= CheckRejected(Truncated, CorruptPath, TEXT("its second half missing"));
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+    UE_LOG(LogIGISDK, Display, TEXT("IGI vector index test: %s"), bPassed ? TEXT("passed") : TEXT("FAILED"));
+    return bPassed ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "IGIVectorIndexTestCommandlet.generated.h"
+
+/**
+ * Checks FIGIVectorIndex headless: HNSW recall against the exact flat index, save/load round trips
+ * of both index types, and rejection of corrupt files. Returns non-zero on any failure.
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=IGIVectorIndexTest
+ *        [-Num=<vectors>] [-Dimension=<floats>] [-Queries=<count>] [-K=<results>] [-MinRecall=<0..1>]
+ *
+ * Vectors are random unit vectors from a fixed seed, so runs are repeatable. A share of them is
+ * removed before searching, so tombstoned graph nodes are covered too.
+ */
+UCLASS()
+class UIGIVectorIndexTestCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UIGIVectorIndexTestCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
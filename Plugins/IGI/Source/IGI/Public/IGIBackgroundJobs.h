@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIGPT.h"
+#include "IGITypes.h"
+
+class FIGIModule;
+
+enum class EIGIBackgroundJobStatus : uint8
+{
+    Completed,
+    /** Replaced by a job with the same key, cancelled, preempted too often or dropped at shutdown */
+    Cancelled,
+    /** No model could serve the job */
+    Failed,
+};
+
+/**
+ * Called exactly once per accepted job, with the generated text when Completed and an empty string
+ * otherwise. Runs on the worker thread, or on whichever thread cancelled or replaced the job.
+ */
+DECLARE_DELEGATE_TwoParams(FIGIBackgroundJobComplete, EIGIBackgroundJobStatus /*Status*/, const FString& /*Response*/);
+
+/** A low-priority GPT request that only runs while the backend is otherwise idle */
+struct FIGIBackgroundJob
+{
+    /** Request.Priority should be Ambient or Maintenance; anything more urgent is treated as Ambient */
+    FIGIGPTRequest Request;
+    EIGIModelTier Tier = EIGIModelTier::Small;
+    FIGIBackgroundJobComplete OnComplete;
+
+    /** Jobs with the same key replace each other in the queue (e.g. one pending job per NPC) */
+    FName DedupKey;
+};
+
+/**
+ * Bounded queue of background GPT jobs drained by a single lowest-priority worker thread.
+ *
+ * The worker only starts a job when no other request is in flight, and the job runs preemptible,
+ * so an interactive request cancels it at the next token boundary. Preempted jobs go back to the
+ * front of the queue and retry once the backend is idle again. Ambient jobs run before Maintenance
+ * ones, and queued jobs age per UIGISettings::PriorityAgingSeconds.
+ */
+class IGI_API FIGIBackgroundJobs
+{
+public:
+    FIGIBackgroundJobs(FIGIModule* IGIModule);
+    virtual ~FIGIBackgroundJobs();
+
+    /** Returns false if the queue is full; the job's OnComplete is not called then */
+    bool Enqueue(FIGIBackgroundJob&& Job);
+
+    /** Drop all pending jobs with the given key; each completes as Cancelled. A running job is not interrupted. */
+    void Cancel(FName DedupKey);
+
+    int32 GetNumPending() const;
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -6,8 +6,9 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
 
-#include <atomic>
+#include "IGITypes.h"
 #include "IGIBlueprintLibrary.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FIGIGPTEvaluateAsyncOutputPin, FString, Response);
@@ -18,12 +19,16 @@ class IGI_API UIGIGPTEvaluateAsync : public UBlueprintAsyncActionBase
     GENERATED_BODY()
 public:
 
-    UFUNCTION(BlueprintCallable, Category = "IGI|GPT", meta = (DisplayName = "Send text to GPT (Async)", BlueprintInternalUseOnly = "true"))
-    static UIGIGPTEvaluateAsync* GPTEvaluateAsync(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt);
+    UFUNCTION(BlueprintCallable, Category = "IGI|GPT", meta = (DisplayName = "Send text to GPT (Async)", BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "LogitBias"))
+    static UIGIGPTEvaluateAsync* GPTEvaluateAsync(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt, EIGIModelTier Tier = EIGIModelTier::Auto, const FString& SessionId = TEXT(""), EIGIRequestPriority Priority = EIGIRequestPriority::Interactive, const TMap<FString, float>& LogitBias = TMap<FString, float>());
 
     UPROPERTY(BlueprintAssignable)
     FIGIGPTEvaluateAsyncOutputPin OnResponse;
 
+    /** Fires with newly decoded text as the response streams in; Interactive requests only */
+    UPROPERTY(BlueprintAssignable)
+    FIGIGPTEvaluateAsyncOutputPin OnChunk;
+
     UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
     FString SystemPrompt;
 
@@ -33,8 +38,83 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
     FString AssistantPrompt;
 
+    UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
+    EIGIModelTier Tier = EIGIModelTier::Auto;
+
+    /** Conversation whose KV state is kept warm between requests (typically the NPC name); empty runs cold */
+    UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
+    FString SessionId;
+
+    /** Scheduling class; anything below Interactive can be preempted by more important requests */
+    UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
+    EIGIRequestPriority Priority = EIGIRequestPriority::Interactive;
+
+    /** Bias added to words' first tokens, e.g. names the reply should spell right; see FIGIGPTSamplingParams::LogitBias */
+    UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
+    TMap<FString, float> LogitBias;
+
 private:
     virtual void Activate() override;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FIGIEmbedAsyncOutputPin, const TArray<float>&, Embedding);
+
+UCLASS(BlueprintType, meta = (ExposedAsyncProxy = AsyncAction))
+class IGI_API UIGIEmbedAsync : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+public:
+
+    /** Embed text with the project's embedding model. The vector is empty if the model isn't available. */
+    UFUNCTION(BlueprintCallable, Category = "IGI|Embed", meta = (DisplayName = "Embed text (Async)", BlueprintInternalUseOnly = "true"))
+    static UIGIEmbedAsync* EmbedAsync(const FString& Text);
+
+    UPROPERTY(BlueprintAssignable)
+    FIGIEmbedAsyncOutputPin OnEmbedding;
+
+    UPROPERTY(BlueprintReadOnly, Category = "IGI|Embed", meta = (BBlueprintInternalUseOnly = "true"))
+    FString Text;
+
+private:
+    virtual void Activate() override;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FIGISaveGPTSessionsAsyncOutputPin, bool, bSaved);
+
+UCLASS(BlueprintType, meta = (ExposedAsyncProxy = AsyncAction))
+class IGI_API UIGISaveGPTSessionsAsync : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+public:
+
+    /**
+     * Save every NPC conversation's KV state next to the given save game slot. Call alongside SaveGameToSlot.
+     * Sessions are captured when the node runs; compressing and writing them happens in the background.
+     */
+    UFUNCTION(BlueprintCallable, Category = "IGI|GPT", meta = (DisplayName = "Save GPT sessions (Async)", BlueprintInternalUseOnly = "true"))
+    static UIGISaveGPTSessionsAsync* SaveGPTSessionsAsync(const FString& SlotName);
+
+    UPROPERTY(BlueprintAssignable)
+    FIGISaveGPTSessionsAsyncOutputPin OnSaved;
+
+    UPROPERTY(BlueprintReadOnly, Category = "IGI|GPT", meta = (BBlueprintInternalUseOnly = "true"))
+    FString SlotName;
+
+private:
+    virtual void Activate() override;
+};
+
+UCLASS()
+class IGI_API UIGIBlueprintLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+public:
+
+    /** Replace NPC conversation state with what was saved for the slot. Call alongside LoadGameFromSlot. */
+    UFUNCTION(BlueprintCallable, Category = "IGI|GPT")
+    static bool LoadGPTSessions(const FString& SlotName);
 
-    static std::atomic<bool> IsRunning;
+    /** Cosine similarity of two embeddings from Embed text; 0 if their sizes differ */
+    UFUNCTION(BlueprintPure, Category = "IGI|Embed")
+    static float EmbeddingSimilarity(const TArray<float>& A, const TArray<float>& B);
 };
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIModule.h"
+#include "IGITypes.h"
+
+/** Creation parameters for one embedding model instance */
+struct FIGIEmbedModelDesc
+{
+    FString ModelGUID;
+
+    /** Embedding models share the GPT backends; CPU keeps them off the GPU the game renders on */
+    EIGIGPTBackend Backend = EIGIGPTBackend::CPU;
+    int32 VRAMBudgetMB = 1024;
+    int32 NumThreads = 4;
+};
+
+/**
+ * Text embedding model, the embedding counterpart of FIGIGPT.
+ *
+ * Embed takes a batch of texts and evaluates them in as few backend calls as the batch limit
+ * allows. Vectors are L2-normalized, so a dot product between two of them is their cosine
+ * similarity, which is what FIGIVectorIndex expects.
+ */
+class IGI_API FIGIEmbed
+{
+public:
+    FIGIEmbed(FIGIModule* IGIModule, const FIGIEmbedModelDesc& ModelDesc);
+    virtual ~FIGIEmbed();
+
+    /** False if the backend feature or model instance failed to load */
+    bool IsValid() const;
+
+    const FIGIEmbedModelDesc& GetModelDesc() const;
+
+    /** Floats per embedding vector */
+    int32 GetDimension() const;
+
+    /** One vector per text, in order. Empty on failure. Thread safe; calls are serialized per instance. */
+    TArray<TArray<float>> Embed(const TArray<FString>& Texts);
+
+    TArray<float> Embed(const FString& Text);
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
+
+/** Shared reference to an embedding instance; the instance stays loaded while any reference is held */
+using FIGIEmbedPtr = TSharedPtr<FIGIEmbed, ESPMode::ThreadSafe>;
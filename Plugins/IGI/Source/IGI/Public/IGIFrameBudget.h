@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGITypes.h"
+
+/**
+ * Per-frame time budget for inference work that competes with rendering (CiG or CPU backends).
+ *
+ * Ticked once per frame on the game thread. The budget shrinks when frames run over the target
+ * frame time and slowly grows back when they don't. Workers call WaitForSlice before each unit of
+ * sliceable work (e.g. a prefill chunk) and ConsumeSlice after it. A slice is only granted while
+ * no more important request is in flight, so interactive decode interleaves between the chunks
+ * of a lower-priority prefill.
+ *
+ * Queued requests are tracked as well, so a running request yields to a more important one still
+ * waiting for a worker rather than holding the worker until it finishes.
+ */
+class IGI_API FIGIFrameBudget
+{
+public:
+    FIGIFrameBudget();
+    virtual ~FIGIFrameBudget();
+
+    /** Game thread, once per frame */
+    void Tick(float DeltaSeconds);
+
+    /** Register an in-flight request for the duration of its evaluation */
+    void BeginRequest(EIGIRequestPriority Priority);
+    void EndRequest(EIGIRequestPriority Priority);
+
+    /**
+     * Register a request waiting in a queue since EnqueueTime; it preempts work less important than its
+     * aged class but doesn't hold slices back. Remove it with the same arguments.
+     */
+    void AddQueued(EIGIRequestPriority Priority, double EnqueueTime);
+    void RemoveQueued(EIGIRequestPriority Priority, double EnqueueTime);
+
+    /** Class a request queued since EnqueueTime is scheduled at, after aging */
+    EIGIRequestPriority GetAgedPriority(EIGIRequestPriority Priority, double EnqueueTime) const;
+
+    /** Block until the current frame has budget left for this priority */
+    void WaitForSlice(EIGIRequestPriority Priority);
+
+    /** True while a more important request is in flight or queued; preemptible work should stop */
+    bool ShouldYield(EIGIRequestPriority Priority) const;
+
+    /** True when no request of any priority is in flight or queued */
+    bool IsIdle() const;
+
+    /** Charge work done after WaitForSlice against the current frame */
+    void ConsumeSlice(double Milliseconds);
+
+    double GetSliceBudgetMs() const;
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -8,16 +8,115 @@
 #include "Templates/PimplPtr.h"
 
 #include "IGIModule.h"
+#include "IGITypes.h"
+
+/** Creation parameters for one GGUF model instance */
+struct FIGIGPTModelDesc
+{
+    FString ModelGUID;
+    EIGIGPTBackend Backend = EIGIGPTBackend::CUDA;
+    int32 VRAMBudgetMB = 1024 * 24;
+    int32 NumThreads = 1;
+    int32 ContextSize = 4096;
+};
+
+/**
+ * Per-request sampling settings; the defaults match the backend's. The nvigi GPT backend applies
+ * Temperature, TopP and TopK only; MinP, the penalties and LogitBias apply on a llama.cpp Remote backend.
+ */
+struct FIGIGPTSamplingParams
+{
+    /** 0 is greedy */
+    float Temperature = 0.8f;
+    float TopP = 0.95f;
+    int32 TopK = 40;
+
+    /** Drop tokens less likely than MinP times the most likely one */
+    float MinP = 0.05f;
+
+    /** Divides the logit of recently used tokens; 1 is off */
+    float RepeatPenalty = 1.f;
+
+    /** Tokens the penalties look back over; -1 is the whole sequence */
+    int32 RepeatLastN = 64;
+
+    /** Subtracted from a recent token's logit once per occurrence (frequency) or once if present at all (presence) */
+    float FrequencyPenalty = 0.f;
+    float PresencePenalty = 0.f;
+
+    /**
+     * Added to the logit of the first token of each word or phrase, with and without a leading space.
+     * Positive values steer toward spelling case names correctly; -100 effectively bans a word. Much
+     * cheaper than the prompt text it replaces.
+     */
+    TMap<FString, float> LogitBias;
+
+    /** -1 picks a random seed */
+    int32 Seed = -1;
+};
+
+/** A single GPT evaluation */
+struct FIGIGPTRequest
+{
+    FString SystemPrompt;
+    FString UserPrompt;
+    FString AssistantPrompt;
+
+    /** Session cache file to restore and persist KV state through; empty runs cold */
+    FString SessionCachePath;
+
+    int32 TokensToPredict = 200;
+
+    FIGIGPTSamplingParams Sampling;
+
+    EIGIRequestPriority Priority = EIGIRequestPriority::Interactive;
+
+    /** Cancel at the next token or prefill chunk boundary when a more important request arrives */
+    bool bPreemptible = false;
+
+    /**
+     * Called on the evaluating thread with each piece of the response as it is decoded. Not called for
+     * preemptible requests: a preempted request is rerun from the start, which would repeat the text.
+     */
+    TFunction<void(const FString& /*Chunk*/)> OnChunk;
+
+    /** Polled at each token boundary; returning true stops the evaluation as if it were preempted */
+    TFunction<bool()> ShouldCancel;
+};
+
+/** Wall-clock timings of a single evaluation */
+struct FIGIGPTTimings
+{
+    double TimeToFirstTokenMs = 0.0;
+    double TotalMs = 0.0;
+    int32 NumTokens = 0;
+
+    /** The evaluation was cancelled in favour of a more important request; the response is partial */
+    bool bPreempted = false;
+};
 
 class IGI_API FIGIGPT
 {
 public:
     FIGIGPT(FIGIModule* IGIModule);
+    FIGIGPT(FIGIModule* IGIModule, const FIGIGPTModelDesc& ModelDesc);
     virtual ~FIGIGPT();
 
+    /** False if the backend feature or model instance failed to load */
+    bool IsValid() const;
+
+    const FIGIGPTModelDesc& GetModelDesc() const;
+
     FString Evaluate(const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt);
+    FString Evaluate(const FIGIGPTRequest& Request, FIGIGPTTimings* OutTimings = nullptr);
+
+    /** Decode a short fixed prompt and return the steady-state decode rate, excluding prefill */
+    float MeasureDecodeTokensPerSecond(int32 NumTokens);
 
 private:
     class Impl;
     TPimplPtr<class Impl> Pimpl;
 };
+
+/** Shared reference to a model instance; the instance stays loaded while any reference is held */
+using FIGIGPTPtr = TSharedPtr<FIGIGPT, ESPMode::ThreadSafe>;
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "IGISettings.h"
+#include "IGITypes.h"
+#include "IGIHardwareProbe.generated.h"
+
+class FIGIModule;
+
+namespace nvigi
+{
+    struct alignas(8) PluginAndSystemInformation;
+}
+
+/** One model build (model + quantization + backend) listed in the model manifest */
+USTRUCT()
+struct IGI_API FIGIModelVariant
+{
+    GENERATED_BODY()
+
+    /** Unique name, used as the cache key in the user config */
+    UPROPERTY()
+    FString Name;
+
+    UPROPERTY()
+    FString ModelGUID;
+
+    /** Informational, e.g. "q4_0" or "q8_0" */
+    UPROPERTY()
+    FString Quantization;
+
+    UPROPERTY()
+    EIGIGPTBackend Backend = EIGIGPTBackend::CUDA;
+
+    /** Tier this variant can serve; Auto means either */
+    UPROPERTY()
+    EIGIModelTier Tier = EIGIModelTier::Auto;
+
+    /** Higher is better; variants are tried best first */
+    UPROPERTY()
+    int32 Quality = 0;
+
+    UPROPERTY()
+    int32 MinVRAMMB = 0;
+
+    UPROPERTY()
+    int32 MinRAMMB = 0;
+
+    UPROPERTY()
+    bool bRequiresAVX2 = false;
+
+    UPROPERTY()
+    int32 VRAMBudgetMB = 1024 * 4;
+
+    UPROPERTY()
+    int32 ContextSize = 4096;
+};
+
+USTRUCT()
+struct IGI_API FIGIModelManifest
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FIGIModelVariant> Variants;
+};
+
+/** Snapshot of the machine's inference-relevant capabilities */
+struct IGI_API FIGIHardwareInfo
+{
+    int64 TotalRAMMB = 0;
+    int64 AvailableRAMMB = 0;
+    int64 VRAMMB = 0;
+    int32 NumCores = 0;
+    bool bHasNVIDIAAdapter = false;
+    bool bAVX2 = false;
+    bool bAVX512 = false;
+    FString CPUBrand;
+    FString GPUBrand;
+
+    /** Stable across runs on the same machine; changes when hardware or drivers change */
+    FString GetFingerprint() const;
+};
+
+/** Tier settings chosen by the probe; unset tiers keep their UIGISettings values */
+struct IGI_API FIGIHardwareSelection
+{
+    TOptional<FIGIModelTierSettings> SmallTier;
+    TOptional<FIGIModelTierSettings> LargeTier;
+
+    /** Manifest variants behind the tiers; empty for an unset tier */
+    FString SmallVariant;
+    FString LargeVariant;
+
+    /** Hardware and manifest the selection was made for */
+    FString Fingerprint;
+
+    /** Picked by what fits, without a benchmark; the benchmarked selection replaces it */
+    bool bProvisional = false;
+};
+
+/** Everything the background benchmark needs, measured on the game thread */
+struct IGI_API FIGIHardwareBenchmarkJob
+{
+    FIGIModelManifest Manifest;
+    FIGIHardwareInfo Info;
+    FString Fingerprint;
+};
+
+/**
+ * Startup probe that measures the machine, filters the model manifest by what fits and
+ * benchmarks candidates until one decodes at a playable rate. The choice is cached in
+ * GameUserSettings.ini and only recomputed when the hardware fingerprint or manifest change.
+ */
+class IGI_API FIGIHardwareProbe
+{
+public:
+    static FIGIHardwareInfo Measure(const nvigi::PluginAndSystemInformation* SystemInfo);
+
+    static bool LoadManifest(const FString& Path, FIGIModelManifest& OutManifest, FString& OutHash);
+
+    /**
+     * Cached selection if the hardware is unchanged. Otherwise a provisional one built from the best
+     * variant that fits, with OutBenchmark set to the job that finds the real one. Never loads a model.
+     */
+    static FIGIHardwareSelection Run(const nvigi::PluginAndSystemInformation* SystemInfo, TOptional<FIGIHardwareBenchmarkJob>& OutBenchmark);
+
+    /** Load and time candidates, each variant at most once. Takes seconds per variant: run it off the game thread. */
+    static FIGIHardwareSelection Benchmark(FIGIModule* IGIModule, const FIGIHardwareBenchmarkJob& Job);
+
+    /** Remember a benchmarked selection in GameUserSettings.ini; game thread only */
+    static void CacheSelection(const FIGIHardwareSelection& Selection);
+};
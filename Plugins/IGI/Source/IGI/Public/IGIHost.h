@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIGPT.h"
+
+class FIGIModule;
+
+/**
+ * Game side of out-of-process inference (UIGISettings::bOutOfProcessInference).
+ *
+ * Launches the game executable as a headless host with -IGIHost, which loads the GPT models and
+ * evaluates requests sent over a shared-memory channel. FIGIGPT forwards to it transparently, so
+ * the registry, inference server and Blueprint nodes work unchanged. The host boots in the
+ * background; models created before it attaches run in-process and move over afterwards.
+ *
+ * The host runs with -nullrhi, so it has no D3D12 queue to share with the game and CUDA models
+ * can't use CiG: their kernels time-slice with the game's frames. The game-side frame budget
+ * (prefill slices and preemption sent as cancels) is the only thing holding them back.
+ *
+ * A watchdog thread reads the replies and checks that the host is alive: if the process exits,
+ * its heartbeat stops, or a request makes no progress for UIGISettings::HostStallTimeoutSeconds,
+ * in-flight requests return empty and the host is restarted with backoff. Models are reloaded
+ * lazily by the FIGIGPT instances that owned them.
+ */
+class IGI_API FIGIHostClient
+{
+public:
+    FIGIHostClient(FIGIModule* IGIModule);
+    virtual ~FIGIHostClient();
+
+    /** Launch the host without waiting for it to attach; the watchdog connects it, and retries on failure */
+    bool Start();
+
+    /** False once the host has failed more than UIGISettings::MaxHostRestarts times */
+    bool IsAvailable() const;
+
+    /** True while a host is attached and serving; false while it boots or restarts */
+    bool IsConnected() const;
+
+    /** Bumped by every restart; models loaded under an earlier generation are gone */
+    uint32 GetGeneration() const;
+
+    int32 GetNumRestarts() const;
+
+    /** Load a model in the host; returns its handle, or 0 if it failed */
+    uint64 LoadModel(const FIGIGPTModelDesc& Desc);
+
+    void UnloadModel(uint64 Model);
+
+    /**
+     * Evaluate on a model loaded in the host, blocking like FIGIGPT::Evaluate. Preemptible requests
+     * are cancelled in the host when the frame budget says to yield. Empty if the host went away.
+     */
+    FString Evaluate(uint64 Model, const FIGIGPTRequest& Request, FIGIGPTTimings& OutTimings);
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIGPT.h"
+#include "IGITypes.h"
+
+class FIGIModule;
+
+/** Called on a server thread when a sequence finishes; the response is empty if it never ran, e.g. because no slot could load the model */
+using FIGIInferenceCallback = TUniqueFunction<void(const FString& /*Response*/, const FIGIGPTTimings& /*Timings*/)>;
+
+/** Snapshot of server throughput and load */
+struct FIGIInferenceServerMetrics
+{
+    int32 NumSlots = 0;
+    int32 ActiveSequences = 0;
+    int32 QueuedSequences = 0;
+    int64 CompletedSequences = 0;
+
+    /** Times a running sequence gave way to a more important one and went back to the queue */
+    int64 PreemptedSequences = 0;
+    int64 GeneratedTokens = 0;
+
+    /** Aggregate decode rate across all slots over the last few seconds */
+    double TokensPerSecond = 0.0;
+
+    /** Mean time sequences spent queued before a slot picked them up */
+    double MeanQueueWaitMs = 0.0;
+};
+
+/**
+ * In-process inference server: a pool of model instances fed from one priority queue.
+ *
+ * Each model gets UIGISettings::InferenceSlotsPerModel slots. A slot is a whole model instance with
+ * its own worker, so every slot past the first costs another copy of the weights and KV cache. This is
+ * not batching: each instance decodes one sequence per forward pass, and sequences on different slots
+ * share nothing on the GPU. Batching several sequences through one instance needs the backend to
+ * accept more than one sequence per evaluation, which nvigi's GPT interface does not.
+ *
+ * A queued sequence takes the first slot that frees up. Admission is by priority, then by the session
+ * that was served least recently, so one talkative NPC can't starve the others. A session never runs
+ * on two slots at once, because its KV state lives in a single cache file.
+ *
+ * Anything below Interactive is preemptible: when a more important request is queued or running, it
+ * stops at the next token boundary and goes back to the queue. The tokens it generated are discarded
+ * and it runs again from the start when readmitted; only the part of the prompt already in its session
+ * file is reused. Queued sequences age one class up every UIGISettings::PriorityAgingSeconds, but never
+ * into Interactive.
+ */
+class IGI_API FIGIInferenceServer
+{
+public:
+    FIGIInferenceServer(FIGIModule* IGIModule);
+    virtual ~FIGIInferenceServer();
+
+    /**
+     * Queue a sequence on the model serving Tier. SessionId, if set, is acquired from the KV cache
+     * manager around the evaluation and doubles as the fairness key.
+     */
+    void Submit(EIGIModelTier Tier, const FIGIGPTRequest& Request, const FString& SessionId, FIGIInferenceCallback&& OnComplete);
+
+    FIGIInferenceServerMetrics GetMetrics() const;
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGITypes.h"
+
+/**
+ * Tracks KV memory for loaded models and per-NPC sessions within a global budget.
+ *
+ * A session's KV state lives in the backend while it is being evaluated and in the backend's session
+ * cache file in between; nvigi offers no other way to move it, so idle sessions cost disk, not VRAM.
+ * The manager owns those files: it hands out their paths, drops state that outgrew its context
+ * budget or belongs to another model, and never does file I/O while holding its lock.
+ *
+ * Sessions can be saved compressed next to a save game. Loading one only registers the snapshots;
+ * each is decompressed and checked against its model the first time its NPC talks.
+ */
+class IGI_API FIGIKVCacheManager
+{
+public:
+    FIGIKVCacheManager();
+    virtual ~FIGIKVCacheManager();
+
+    /** Estimated KV bytes for a context of the given size at f16 */
+    int64 EstimateKVBytes(int32 ContextSize) const;
+
+    /**
+     * Reserve resident KV memory for a model instance from the global budget.
+     * Returns the context size that fits, which may be smaller than requested.
+     * Reservations are counted per key; each one needs its own ReleaseModelContext.
+     */
+    int32 ReserveModelContext(const FString& ModelKey, int32 RequestedContextSize);
+    void ReleaseModelContext(const FString& ModelKey);
+
+    /** Context tokens a session may occupy; 0 resets to the default */
+    void SetSessionContextSize(const FString& SessionId, int32 ContextSize);
+    int32 GetSessionContextSize(const FString& SessionId) const;
+
+    /**
+     * Restore a session's state to its cache file and return the path the backend should use.
+     * State produced by a different model is discarded and the session starts cold.
+     */
+    FString AcquireSession(const FString& SessionId, const FString& ModelGUID);
+
+    /** Mark the session idle after evaluation; state larger than its context budget is dropped */
+    void ReleaseSession(const FString& SessionId);
+
+    /** Forget a session's state; its file is deleted before the session is next used */
+    void DropSession(const FString& SessionId);
+
+    /**
+     * Write every idle session's KV state, compressed, to a side file. The sessions are copied before
+     * this returns; compression and the write happen on a worker, which then calls OnSaved with the result.
+     */
+    void SaveSessions(const FString& Path, TUniqueFunction<void(bool /*bSaved*/)>&& OnSaved = nullptr);
+
+    /** Replace all idle sessions with those in a side file; they are restored lazily on first use. Waits for saves in flight. */
+    bool LoadSessions(const FString& Path);
+
+    /** Side file path for a save game slot */
+    static FString GetSaveGameSessionsPath(const FString& SlotName);
+
+    int64 GetResidentModelBytes() const;
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
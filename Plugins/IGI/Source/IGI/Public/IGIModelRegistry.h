@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIGPT.h"
+#include "IGITypes.h"
+
+class FIGIModule;
+struct FIGIModelTierSettings;
+
+/**
+ * Owns every loaded GGUF model and routes GPT requests between them.
+ *
+ * Each tier has its own model, VRAM budget and bounded queue (see UIGISettings). Tiers that
+ * resolve to the same model GUID share a single instance. Instances are created once, on a
+ * dedicated thread and with no lock held, so querying the registry never waits on a model load.
+ *
+ * Instances are handed out as shared references. SwapModel loads a replacement while the current
+ * model keeps serving, then switches the tier over atomically. The old instance is freed when the
+ * last in-flight request lets go of it.
+ */
+class IGI_API FIGIModelRegistry
+{
+public:
+    FIGIModelRegistry(FIGIModule* IGIModule);
+    virtual ~FIGIModelRegistry();
+
+    /** Resolve the tier a request should run on without reserving a queue slot */
+    EIGIModelTier SelectTier(EIGIModelTier RequestedTier, int32 PromptLength) const;
+
+    /**
+     * Route a request with SelectTier and reserve a slot in that tier's queue. Interactive requests may
+     * also take the tier's InteractiveQueueReserve slots, which nothing else can fill.
+     * Returns false when the selected tier is full; no other tier is tried and the request should be dropped.
+     * Every successful call must be paired with EndRequest(OutTier).
+     */
+    bool TryBeginRequest(EIGIModelTier RequestedTier, int32 PromptLength, EIGIRequestPriority Priority, EIGIModelTier& OutTier);
+    void EndRequest(EIGIModelTier Tier);
+
+    /** Model instance serving a tier, created on first use. Blocks until the instance is loaded. */
+    FIGIGPTPtr GetGPT(EIGIModelTier Tier);
+
+    /** Model instance serving a tier if it has finished loading, otherwise starts the load and returns nullptr */
+    FIGIGPTPtr TryGetGPT(EIGIModelTier Tier);
+
+    /** Completes once the tier's instance is loaded; starts the load if needed */
+    TSharedFuture<FIGIGPTPtr> GetGPTFuture(EIGIModelTier Tier);
+
+    /**
+     * Load another model for a tier in the background and switch new requests to it once it is ready.
+     * Swapping to the model the tier already serves reuses that instance unless bReload, which loads a
+     * fresh one (e.g. after the weights on disk changed) and swaps to it the same way.
+     * Completes with false, leaving the tier unchanged, if the model fails to load. Also available as IGI.SwapModel.
+     */
+    TSharedFuture<bool> SwapModel(EIGIModelTier Tier, const FString& ModelGUID, EIGIGPTBackend Backend = EIGIGPTBackend::CUDA, bool bReload = false);
+
+    /** As above, replacing the tier's budgets as well as its model; a tier with nothing loaded switches at once */
+    TSharedFuture<bool> SwapModel(EIGIModelTier Tier, const FIGIModelTierSettings& Settings, bool bReload = false);
+
+    /** Requests currently reserved on a tier (running or waiting) */
+    int32 GetQueueDepth(EIGIModelTier Tier) const;
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -5,7 +5,17 @@
 #include "Modules/ModuleManager.h"
 #include "Templates/PimplPtr.h"
 
+class FIGIBackgroundJobs;
+class FIGIEmbed;
+class FIGIFrameBudget;
 class FIGIGPT;
+class FIGIHostClient;
+class FIGIInferenceServer;
+class FIGIKVCacheManager;
+class FIGIModelRegistry;
+class FIGIResultDispatcher;
+class FIGITraceRecorder;
+struct FIGIHardwareSelection;
 
 // These replicate some of the types defined in nvigi.h
 namespace nvigi
@@ -37,7 +47,44 @@ public:
 
     const FString GetModelsPath() const;
 
-    FIGIGPT* GetGPT();
+    /** Model serving the large tier; blocks until it is loaded */
+    TSharedPtr<FIGIGPT, ESPMode::ThreadSafe> GetGPT();
+
+    /** Model serving the large tier, or nullptr while it is still loading (the load is started if needed) */
+    TSharedPtr<FIGIGPT, ESPMode::ThreadSafe> TryGetGPT();
+
+    /** Embedding model from UIGISettings; blocks while it loads the first time, nullptr if it fails */
+    TSharedPtr<FIGIEmbed, ESPMode::ThreadSafe> GetEmbed();
+
+    /** Registry that loads every configured model and routes requests between tiers */
+    FIGIModelRegistry* GetModelRegistry();
+
+    /** Schedules GPT sequences across parallel model slots */
+    FIGIInferenceServer* GetInferenceServer();
+
+    /** Idle-time queue for low-priority generation */
+    FIGIBackgroundJobs* GetBackgroundJobs();
+
+    /** Per-frame time budget for sliceable inference work */
+    FIGIFrameBudget* GetFrameBudget();
+
+    /** Delivers inference results to the game thread once per frame */
+    FIGIResultDispatcher* GetResultDispatcher();
+
+    /** KV memory budget and per-NPC session paging */
+    FIGIKVCacheManager* GetKVCacheManager();
+
+    /** Capture of GPT requests for offline replay */
+    FIGITraceRecorder* GetTraceRecorder();
+
+    /** Link to the out-of-process inference host, or nullptr when GPT models run in this process */
+    FIGIHostClient* GetHostClient();
+
+    /** True in the headless process started with -IGIHost to run GPT models for the game */
+    bool IsInferenceHost() const;
+
+    /** Tier models picked by the startup hardware probe; provisional until its background benchmark finishes */
+    FIGIHardwareSelection GetHardwareSelection() const;
 
     void Test();
 
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include <atomic>
+
+/** Coalescing buffer for one streamed response; chunks appended between drains are delivered together */
+class IGI_API FIGIChunkStream
+{
+public:
+    /** OnChunks runs on the game thread with the text appended since its previous run */
+    explicit FIGIChunkStream(TUniqueFunction<void(const FString& /*Chunks*/)>&& InOnChunks)
+        : OnChunks(MoveTemp(InOnChunks))
+    {
+    }
+
+private:
+    friend class FIGIResultDispatcher;
+
+    TUniqueFunction<void(const FString&)> OnChunks;
+    FCriticalSection CS;
+    FString Buffer;
+
+    /** A delivery is already queued; further chunks just join the buffer */
+    std::atomic<bool> bScheduled{ false };
+};
+
+using FIGIChunkStreamRef = TSharedRef<FIGIChunkStream, ESPMode::ThreadSafe>;
+
+/**
+ * Single place where inference results reach the game thread.
+ *
+ * Workers queue results, streamed chunks and object releases from any thread onto a lock-free
+ * queue. It is drained once per frame for at most UIGISettings::ResultDispatchBudgetMs: by a tick
+ * function in TG_PrePhysics of each game world, so gameplay sees results at the same point of every
+ * frame, or by the module's core ticker when no game world is ticking (editor, commandlets, loading).
+ * Whatever is left waits for the next frame, so a burst of completions can't cause a hitch. Work runs
+ * in the order it was queued, so a request's final result always follows its chunks.
+ */
+class IGI_API FIGIResultDispatcher
+{
+public:
+    FIGIResultDispatcher();
+    virtual ~FIGIResultDispatcher();
+
+    /** Any thread. Work runs on the game thread during a later drain. */
+    void Enqueue(TUniqueFunction<void()>&& Work);
+
+    /** Any thread. Append a chunk to a stream; at most one delivery per stream is queued at a time. */
+    void EnqueueChunk(const FIGIChunkStreamRef& Stream, const FString& Chunk);
+
+    /** Game thread. Runs queued work until the queue is empty or this frame's budget is used up; later calls in the same frame do nothing. */
+    void Drain();
+
+    int32 GetNumPending() const;
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
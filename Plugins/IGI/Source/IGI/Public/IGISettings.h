@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "IGITypes.h"
+#include "IGISettings.generated.h"
+
+/** GGUF model and budgets used for one routing tier */
+USTRUCT(BlueprintType)
+struct IGI_API FIGIModelTierSettings
+{
+    GENERATED_BODY()
+
+    /** nvigi model GUID, e.g. {8E31808B-C182-4016-9ED8-64804FF5B40D}. Empty means the tier falls back to the large tier. */
+    UPROPERTY(EditAnywhere, Config, Category = "Model")
+    FString ModelGUID;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Model")
+    EIGIGPTBackend Backend = EIGIGPTBackend::CUDA;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Model", meta = (ClampMin = "256"))
+    int32 VRAMBudgetMB = 1024 * 24;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Model", meta = (ClampMin = "1"))
+    int32 NumThreads = 1;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Model", meta = (ClampMin = "512"))
+    int32 ContextSize = 4096;
+
+    /** Requests allowed in flight (running or waiting) on this tier before new ones are rejected */
+    UPROPERTY(EditAnywhere, Config, Category = "Model", meta = (ClampMin = "1"))
+    int32 MaxQueueDepth = 1;
+
+    /** Extra queue slots only Interactive requests may take, so a reply the player waits on is never turned away by background work */
+    UPROPERTY(EditAnywhere, Config, Category = "Model", meta = (ClampMin = "0"))
+    int32 InteractiveQueueReserve = 1;
+};
+
+/**
+ * Project settings for the IGI plugin (Project Settings > Plugins > IGI).
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "IGI"))
+class IGI_API UIGISettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UIGISettings();
+
+    virtual FName GetCategoryName() const override { return FName(TEXT("Plugins")); }
+
+    /** Cheap tier for greetings and ambient barks */
+    UPROPERTY(EditAnywhere, Config, Category = "Routing")
+    FIGIModelTierSettings SmallTier;
+
+    /** Full model used for interrogation turns */
+    UPROPERTY(EditAnywhere, Config, Category = "Routing")
+    FIGIModelTierSettings LargeTier;
+
+    /** Auto-routed requests whose combined prompt is at most this many characters go to the small tier */
+    UPROPERTY(EditAnywhere, Config, Category = "Routing", meta = (ClampMin = "0"))
+    int32 AutoSmallPromptMaxChars = 512;
+
+    /** Let auto-routed requests overflow from a full small tier onto an idle large tier */
+    UPROPERTY(EditAnywhere, Config, Category = "Routing")
+    bool bAllowOverflowToLarge = true;
+
+    /**
+     * Probe RAM/VRAM/CPU at startup and pick tier models from the manifest instead of the fixed tiers above.
+     * On new hardware the benchmark runs in the background while the best variant that fits serves.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Hardware Probe")
+    bool bRunHardwareProbe = true;
+
+    /** Model variant manifest, relative to the IGI plugin directory */
+    UPROPERTY(EditAnywhere, Config, Category = "Hardware Probe")
+    FString ModelManifestPath = TEXT("Config/ModelManifest.json");
+
+    /** Decode rate below which a variant is considered unplayable and the next smaller one is tried */
+    UPROPERTY(EditAnywhere, Config, Category = "Hardware Probe", meta = (ClampMin = "0.0"))
+    float MinPlayableTokensPerSecond = 12.f;
+
+    /** Tokens decoded by the startup micro-benchmark */
+    UPROPERTY(EditAnywhere, Config, Category = "Hardware Probe", meta = (ClampMin = "4"))
+    int32 BenchmarkTokens = 32;
+
+    /** KV bytes per context token at f16 (2 * layers * kv_heads * head_dim * 2). Default matches Nemotron-4 Mini 4B. */
+    UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = "1"))
+    int32 KVBytesPerTokenF16 = 2 * 32 * 8 * 128 * 2;
+
+    /** Global budget for resident KV caches across all loaded models (the backend allocates f16); tier context sizes are clamped to fit */
+    UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = "64"))
+    int32 KVMemoryBudgetMB = 1024;
+
+    /** Context tokens a session may occupy unless the NPC overrides it */
+    UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = "256"))
+    int32 DefaultSessionContextSize = 2048;
+
+    /** Prefill long system prompts in chunks with a yield point between them instead of one call */
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget")
+    bool bChunkedPrefill = true;
+
+    /** Approximate tokens per prefill chunk */
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget", meta = (ClampMin = "16", EditCondition = "bChunkedPrefill"))
+    int32 PrefillChunkTokens = 128;
+
+    /** Used to convert token counts to prompt characters without a tokenizer */
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget", meta = (ClampMin = "1.0"))
+    float ApproxCharsPerToken = 4.f;
+
+    /** Frame time the budget controller tries to protect */
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget", meta = (ClampMin = "1.0"))
+    float TargetFrameTimeMs = 16.6f;
+
+    /** Bounds of the per-frame inference time slice */
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget", meta = (ClampMin = "0.1"))
+    float MinInferenceSliceMs = 1.f;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget", meta = (ClampMin = "0.1"))
+    float MaxInferenceSliceMs = 8.f;
+
+    /** Game-thread time per frame spent delivering finished and streamed GPT results; the rest waits a frame */
+    UPROPERTY(EditAnywhere, Config, Category = "Frame Budget", meta = (ClampMin = "0.1"))
+    float ResultDispatchBudgetMs = 1.f;
+
+    /**
+     * Model instances per loaded model that the inference server runs sequences on side by side. Each one
+     * beyond the first loads another full copy of the model, so budget VRAM accordingly. This is a pool of
+     * instances, not batching: nvigi evaluates one sequence per instance.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Server", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 InferenceSlotsPerModel = 1;
+
+    /** Seconds a queued request waits before it is scheduled one priority class higher. Requests never age into Interactive. 0 disables aging. */
+    UPROPERTY(EditAnywhere, Config, Category = "Server", meta = (ClampMin = "0.0"))
+    float PriorityAgingSeconds = 4.f;
+
+    /** Pending idle-time background jobs (ambient lines etc.) before new ones are rejected */
+    UPROPERTY(EditAnywhere, Config, Category = "Background", meta = (ClampMin = "1"))
+    int32 MaxBackgroundJobs = 16;
+
+    /** Times a background job is retried after being preempted before it is dropped */
+    UPROPERTY(EditAnywhere, Config, Category = "Background", meta = (ClampMin = "0"))
+    int32 MaxBackgroundJobPreemptions = 3;
+
+    /** nvigi embedding model GUID; the default is e5-large-unsupervised from the nvigi model pack */
+    UPROPERTY(EditAnywhere, Config, Category = "Embedding")
+    FString EmbedModelGUID = TEXT("{5D458A64-C62E-4A9C-9086-2ADBF6B241C7}");
+
+    UPROPERTY(EditAnywhere, Config, Category = "Embedding")
+    EIGIGPTBackend EmbedBackend = EIGIGPTBackend::CPU;
+
+    UPROPERTY(EditAnywhere, Config, Category = "Embedding", meta = (ClampMin = "1"))
+    int32 EmbedNumThreads = 4;
+
+    /** Texts evaluated per backend call; larger batches are split */
+    UPROPERTY(EditAnywhere, Config, Category = "Embedding", meta = (ClampMin = "1"))
+    int32 EmbedMaxBatchSize = 32;
+
+    /**
+     * Logit bias added to every GPT request, under each request's own: suspect names, places and other
+     * case vocabulary NPCs must spell right. Only a llama.cpp Remote backend applies it, since it tokenizes
+     * the text itself. It does nothing on the default nvigi backend, which has no sampling hook, nor on
+     * OpenAI servers, which only take token ids.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Sampling")
+    TMap<FString, float> LogitBias;
+
+    /** Base URL of an OpenAI-compatible server for the Remote backend, e.g. http://192.168.1.20:8080/v1. Empty disables it. */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote")
+    FString RemoteEndpoint;
+
+    /** Which server RemoteEndpoint points at; OpenAI servers reject llama.cpp's extra fields */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote")
+    EIGIRemoteServer RemoteServer = EIGIRemoteServer::LlamaCpp;
+
+    /** Model name sent to the server; empty sends the tier's ModelGUID */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote")
+    FString RemoteModelName;
+
+    /** Sent as a bearer token when set */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote")
+    FString RemoteAPIKey;
+
+    /** Longest a whole remote request may take */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote", meta = (ClampMin = "1"))
+    float RemoteTimeoutSeconds = 30.f;
+
+    /** A remote request that receives nothing for this long has failed; also bounds the background reachability check */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote", meta = (ClampMin = "0.1"))
+    float RemoteActivityTimeoutSeconds = 3.f;
+
+    /** After a remote failure, requests go straight to the local fallback for this long before the server is tried again */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote", meta = (ClampMin = "0"))
+    float RemoteRetrySeconds = 15.f;
+
+    /** Local model used while the server is unreachable; loaded on the first failure. Defaults to the large tier's model. Empty disables the fallback. */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote")
+    FString RemoteFallbackModelGUID;
+
+    /** Backend of the local fallback; Remote here disables it */
+    UPROPERTY(EditAnywhere, Config, Category = "Remote")
+    EIGIGPTBackend RemoteFallbackBackend = EIGIGPTBackend::CPU;
+
+    /**
+     * Run GPT models in a separate host process (the game executable started with -IGIHost) so a
+     * backend crash or hang costs a few replies instead of the game. Requests cross a shared-memory
+     * channel; the host is restarted when it dies or stops responding. Embedding stays in-process.
+     * The host has no RHI, so CUDA models lose CiG and compete with the game's frames; prefer the
+     * CPU backend where frame time matters more than reply latency.
+     */
+    UPROPERTY(EditAnywhere, Config, Category = "Out-of-Process")
+    bool bOutOfProcessInference = false;
+
+    /** Size of each direction of the shared-memory channel; a request or response must fit in half of it */
+    UPROPERTY(EditAnywhere, Config, Category = "Out-of-Process", meta = (ClampMin = "64", EditCondition = "bOutOfProcessInference"))
+    int32 HostChannelKB = 4096;
+
+    /** How long the host gets to start and attach to the channel, and to load each model */
+    UPROPERTY(EditAnywhere, Config, Category = "Out-of-Process", meta = (ClampMin = "1", EditCondition = "bOutOfProcessInference"))
+    float HostStartTimeoutSeconds = 60.f;
+
+    /** The host is considered hung once its heartbeat, or an in-flight request, makes no progress for this long */
+    UPROPERTY(EditAnywhere, Config, Category = "Out-of-Process", meta = (ClampMin = "1", EditCondition = "bOutOfProcessInference"))
+    float HostStallTimeoutSeconds = 30.f;
+
+    /** Restarts after which a failing host is given up on and GPT requests return empty */
+    UPROPERTY(EditAnywhere, Config, Category = "Out-of-Process", meta = (ClampMin = "0", EditCondition = "bOutOfProcessInference"))
+    int32 MaxHostRestarts = 3;
+
+    /** Record every GPT request to a binary trace under Saved/IGI/Traces; IGI.Trace.Start/Stop toggle it at runtime */
+    UPROPERTY(EditAnywhere, Config, Category = "Capture")
+    bool bCaptureTraces = false;
+
+    /** Lowest severity of nvigi backend messages that reach the log. Messages are filtered before they are queued. */
+    UPROPERTY(EditAnywhere, Config, Category = "Logging")
+    EIGILogLevel BackendLogLevel = EIGILogLevel::Log;
+
+    /** Lowest severity of per-request messages (prompts, responses) that reach the log */
+    UPROPERTY(EditAnywhere, Config, Category = "Logging")
+    EIGILogLevel RequestLogLevel = EIGILogLevel::Log;
+
+    /** Log only the length of prompts and responses, never their text */
+    UPROPERTY(EditAnywhere, Config, Category = "Logging")
+    bool bRedactPrompts = false;
+
+    /** Prompts and responses longer than this are truncated in the log; 0 logs them whole */
+    UPROPERTY(EditAnywhere, Config, Category = "Logging", meta = (ClampMin = "0", EditCondition = "!bRedactPrompts"))
+    int32 MaxLoggedPromptChars = 256;
+};
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+#include "IGIGPT.h"
+#include "IGITypes.h"
+
+/** One captured GPT evaluation */
+struct FIGITraceEntry
+{
+    /** Seconds since the capture started */
+    double StartSeconds = 0.0;
+
+    FString ModelGUID;
+    EIGIGPTBackend Backend = EIGIGPTBackend::CUDA;
+
+    FString SystemPrompt;
+    FString UserPrompt;
+    FString AssistantPrompt;
+    int32 TokensToPredict = 0;
+    EIGIRequestPriority Priority = EIGIRequestPriority::Interactive;
+
+    /** The request ran against a session cache, so its prefill may have been partly reused */
+    bool bHadSession = false;
+
+    FIGIGPTTimings Timings;
+
+    /** Wall time from entering Evaluate to returning, including waits for the frame budget and the instance */
+    double WallMs = 0.0;
+};
+
+/**
+ * Captures every GPT evaluation to a compact binary trace for offline replay (see UIGIReplayCommandlet).
+ *
+ * Prompts and model GUIDs are interned, so a repeated NPC background costs an index rather than
+ * its full text. Entries are flushed as they are written, so a trace survives a crash.
+ */
+class IGI_API FIGITraceRecorder
+{
+public:
+    FIGITraceRecorder();
+    virtual ~FIGITraceRecorder();
+
+    /** Start a new capture, closing any current one. An empty path picks a timestamped file under Saved/IGI/Traces. */
+    bool Start(const FString& Path = FString());
+    void Stop();
+
+    bool IsRecording() const;
+    FString GetPath() const;
+
+    void Record(const FIGIGPTModelDesc& Model, const FIGIGPTRequest& Request, const FIGIGPTTimings& Timings, double StartTime, double EndTime);
+
+    /** Read every entry of a trace file */
+    static bool Load(const FString& Path, TArray<FIGITraceEntry>& OutEntries);
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
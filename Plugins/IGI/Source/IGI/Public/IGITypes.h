@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "IGITypes.generated.h"
+
+/** Model tier a GPT request is routed to. Auto lets the router pick from prompt length and current load. */
+UENUM(BlueprintType)
+enum class EIGIModelTier : uint8
+{
+    Auto,
+    Small,
+    Large,
+};
+
+/** nvigi GPT backend plugin a model instance runs on */
+UENUM(BlueprintType)
+enum class EIGIGPTBackend : uint8
+{
+    CUDA,
+    CPU,
+
+    /** OpenAI-compatible server at UIGISettings::RemoteEndpoint; GPT models only */
+    Remote,
+
+    /**
+     * No model: deterministic replies built from the prompt's words, for headless benchmarks and CI.
+     * Hidden from settings; outside a commandlet a Mock model never becomes valid.
+     */
+    Mock UMETA(Hidden),
+};
+
+/** Server behind UIGISettings::RemoteEndpoint; decides which request fields beyond the OpenAI API are sent */
+UENUM(BlueprintType)
+enum class EIGIRemoteServer : uint8
+{
+    /** OpenAI chat completions fields only */
+    OpenAI,
+    /** llama.cpp server: also top-k, min-p, repetition penalties, prompt caching and logit bias by text */
+    LlamaCpp,
+};
+
+/**
+ * Scheduling class of a GPT request; lower values are more important. A request is preempted at the
+ * next token boundary when a more important one arrives, and queued requests age toward higher
+ * classes so they can't starve. Nothing ages into Interactive, so the player's conversation always wins.
+ */
+UENUM(BlueprintType)
+enum class EIGIRequestPriority : uint8
+{
+    /** A reply the player is waiting on */
+    Interactive,
+    /** Work the player will likely need soon, e.g. warming the next suspect's session */
+    ForegroundPrefetch,
+    /** Barks and ambient lines nobody is waiting on */
+    Ambient,
+    /** Summaries, cache upkeep and anything else that can wait indefinitely */
+    Maintenance,
+};
+
+/** Lowest severity the plugin logs for a given source */
+UENUM(BlueprintType)
+enum class EIGILogLevel : uint8
+{
+    Off,
+    Error,
+    Warning,
+    Log,
+    Verbose,
+};
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+
+/** Search structure behind an FIGIVectorIndex */
+enum class EIGIVectorIndexType : uint8
+{
+    /** Exact: every query scores every vector with SIMD dot products. Best up to a few thousand vectors. */
+    Flat,
+    /** Approximate: a hierarchical navigable small world graph, for larger collections */
+    HNSW,
+};
+
+struct FIGIVectorSearchResult
+{
+    int64 Id = 0;
+
+    /** Dot product with the query; cosine similarity for normalized vectors */
+    float Score = 0.f;
+};
+
+/**
+ * Maximum inner product index over fixed-size float vectors, keyed by caller-chosen ids.
+ *
+ * Shared by anything that needs semantic lookup (evidence search, response caching, NPC memory)
+ * rather than each system scanning strings. Store normalized vectors, as FIGIEmbed produces, and
+ * scores are cosine similarities. Readers run concurrently; writers are exclusive.
+ */
+class IGI_API FIGIVectorIndex
+{
+public:
+    FIGIVectorIndex(int32 Dimension = 0, EIGIVectorIndexType Type = EIGIVectorIndexType::Flat);
+    virtual ~FIGIVectorIndex();
+
+    /** Add a vector, replacing any stored under the same id. Ignored if its size doesn't match the index. */
+    void Add(int64 Id, TConstArrayView<float> Vector);
+
+    bool Remove(int64 Id);
+    bool Contains(int64 Id) const;
+    void Reset();
+
+    int32 Num() const;
+    int32 GetDimension() const;
+    EIGIVectorIndexType GetType() const;
+
+    /** Up to K stored vectors with the highest score against Query, best first */
+    TArray<FIGIVectorSearchResult> Search(TConstArrayView<float> Query, int32 K) const;
+
+    /** Save or load the whole index, including the HNSW graph, so it needn't be rebuilt */
+    void Serialize(FArchive& Ar);
+
+    bool SaveToFile(const FString& Path) const;
+    bool LoadFromFile(const FString& Path);
+
+private:
+    class Impl;
+    TPimplPtr<class Impl> Pimpl;
+};
@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMAmbientDialogueSubsystem.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "UMFactMemoryComponent.h"
+#include "UMInteractiveNPCBase.h"
+#include "UMSettings.h"
+#include "IGIModule.h"
+#include "IGIResultDispatcher.h"
+
+void UUMAmbientDialogueSubsystem::SetCaseState(const FString& InCaseState)
+{
+	if (CaseState == InCaseState) return;
+
+	CaseState = InCaseState;
+	++CaseStateSerial;
+
+	// lines generated from the old case state are stale, and so is anything still being generated from it
+	for (TActorIterator<AUMInteractiveNPCBase> It(GetWorld()); It; ++It)
+	{
+		It->ClearAmbientLines();
+	}
+
+	FIGIModule* IGIModulePtr = FModuleManager::GetModulePtr<FIGIModule>(FName("IGI"));
+	if (!IGIModulePtr) return;
+
+	for (const TPair<TWeakObjectPtr<AUMInteractiveNPCBase>, uint32>& Pending : PendingNPCs)
+	{
+		if (const AUMInteractiveNPCBase* NPC = Pending.Key.Get())
+		{
+			IGIModulePtr->GetBackgroundJobs()->Cancel(FName(*NPC->CharacterName));
+		}
+	}
+}
+
+bool UUMAmbientDialogueSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UUMAmbientDialogueSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UUMSettings* Settings = GetDefault<UUMSettings>();
+
+	TimeSinceScan += DeltaTime;
+	if (TimeSinceScan < Settings->AmbientScanInterval) return;
+	TimeSinceScan = 0.0f;
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (!PlayerPawn) return;
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+	const float RadiusSquared = Settings->AmbientRadius * Settings->AmbientRadius;
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (auto It = Retries.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (TActorIterator<AUMInteractiveNPCBase> It(GetWorld()); It; ++It)
+	{
+		AUMInteractiveNPCBase* NPC = *It;
+		const FRetry* Retry = Retries.Find(NPC);
+		if (NPC->NeedsAmbientLines()
+			&& !PendingNPCs.Contains(NPC)
+			&& (!Retry || Now >= Retry->RetryTime)
+			&& FVector::DistSquared(NPC->GetActorLocation(), PlayerLocation) <= RadiusSquared)
+		{
+			RequestAmbientLine(NPC);
+		}
+	}
+}
+
+TStatId UUMAmbientDialogueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUMAmbientDialogueSubsystem, STATGROUP_Tickables);
+}
+
+void UUMAmbientDialogueSubsystem::RequestAmbientLine(AUMInteractiveNPCBase* NPC)
+{
+	FIGIModule* IGIModulePtr = FModuleManager::GetModulePtr<FIGIModule>(FName("IGI"));
+	if (!IGIModulePtr) return;
+
+	FIGIBackgroundJob Job;
+	Job.Tier = EIGIModelTier::Small;
+	Job.DedupKey = FName(*NPC->CharacterName);
+	Job.Request.SystemPrompt = NPC->CharacterBackgroundPrompt;
+	Job.Request.Sampling.LogitBias = NPC->VocabularyBias;
+	if (!CaseState.IsEmpty())
+	{
+		Job.Request.SystemPrompt += TEXT("\n\nWhat has happened in the case so far: ") + CaseState;
+	}
+	// A few of the strongest memories keep muttered lines consistent with what the NPC has been told
+	if (NPC->FactMemory)
+	{
+		const FString Memories = NPC->FactMemory->CompileMemoryPrompt(FString(), GetDefault<UUMSettings>()->AmbientMemoryTokenBudget);
+		if (!Memories.IsEmpty())
+		{
+			Job.Request.SystemPrompt += TEXT("\n\n") + Memories;
+		}
+	}
+	Job.Request.UserPrompt = TEXT("Say one short line, under 20 words, that you might mutter to yourself right now. Reply with the line only.");
+	Job.Request.TokensToPredict = 40;
+	Job.Request.Priority = NPC->AmbientPriority;
+
+	TWeakObjectPtr<AUMInteractiveNPCBase> WeakNPC = NPC;
+	TWeakObjectPtr<UUMAmbientDialogueSubsystem> WeakThis = this;
+	FIGIResultDispatcher* Dispatcher = IGIModulePtr->GetResultDispatcher();
+	const uint32 RequestSerial = ++NextRequestSerial;
+	const uint32 RequestCaseSerial = CaseStateSerial;
+	Job.OnComplete.BindLambda([WeakNPC, WeakThis, Dispatcher, RequestSerial, RequestCaseSerial](EIGIBackgroundJobStatus Status, const FString& Response)
+		{
+			// runs on the IGI background worker, or wherever the job was cancelled; always once per job
+			Dispatcher->Enqueue([WeakNPC, WeakThis, RequestSerial, RequestCaseSerial, Status, Line = Response.TrimStartAndEnd().TrimQuotes()]()
+				{
+					if (UUMAmbientDialogueSubsystem* Subsystem = WeakThis.Get())
+					{
+						Subsystem->OnAmbientLine(WeakNPC, RequestSerial, RequestCaseSerial, Status, Line);
+					}
+				});
+		});
+
+	// added first: a job replaced by this one completes as cancelled and must find its successor pending
+	PendingNPCs.Add(NPC, RequestSerial);
+	if (!IGIModulePtr->GetBackgroundJobs()->Enqueue(MoveTemp(Job)))
+	{
+		PendingNPCs.Remove(NPC);
+		BackOff(WeakNPC);
+	}
+}
+
+void UUMAmbientDialogueSubsystem::OnAmbientLine(TWeakObjectPtr<AUMInteractiveNPCBase> NPC, uint32 RequestSerial, uint32 RequestCaseSerial, EIGIBackgroundJobStatus Status, const FString& Line)
+{
+	const uint32* PendingSerial = PendingNPCs.Find(NPC);
+	const bool bCurrent = PendingSerial && *PendingSerial == RequestSerial;
+	if (bCurrent)
+	{
+		PendingNPCs.Remove(NPC);
+	}
+
+	// jobs this subsystem replaced or cancelled itself say nothing about the backend, so only the current job's outcome counts
+	if (Status == EIGIBackgroundJobStatus::Completed && !Line.IsEmpty())
+	{
+		Retries.Remove(NPC);
+	}
+	else if (bCurrent && RequestCaseSerial == CaseStateSerial)
+	{
+		BackOff(NPC);
+	}
+
+	if (Status != EIGIBackgroundJobStatus::Completed || RequestCaseSerial != CaseStateSerial) return;
+
+	if (AUMInteractiveNPCBase* Speaker = NPC.Get())
+	{
+		Speaker->PushAmbientLine(Line);
+	}
+}
+
+void UUMAmbientDialogueSubsystem::BackOff(const TWeakObjectPtr<AUMInteractiveNPCBase>& NPC)
+{
+	const UUMSettings* Settings = GetDefault<UUMSettings>();
+
+	FRetry& Retry = Retries.FindOrAdd(NPC);
+	const float Delay = FMath::Min(Settings->AmbientRetryDelay * FMath::Pow(2.0f, static_cast<float>(FMath::Min(Retry.NumFailures, 16))), Settings->AmbientMaxRetryDelay);
+	++Retry.NumFailures;
+	Retry.RetryTime = GetWorld()->GetTimeSeconds() + Delay;
+}
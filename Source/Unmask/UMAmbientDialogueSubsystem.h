@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "IGIBackgroundJobs.h"
+#include "UMAmbientDialogueSubsystem.generated.h"
+
+class AUMInteractiveNPCBase;
+
+/**
+ *  Uses idle inference capacity to pre-generate short ambient lines for NPCs near the player.
+ *  Jobs run through the IGI background queue, so they are cancelled the moment the player
+ *  starts a real conversation and never add latency to it. An NPC whose job fails waits before
+ *  asking again, longer after each failure in a row. Tuning lives in UUMSettings.
+ */
+UCLASS()
+class UNMASK_API UUMAmbientDialogueSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Short summary of the case so far, folded into every ambient prompt */
+	UFUNCTION(BlueprintCallable, Category = "Ambient")
+	void SetCaseState(const FString& InCaseState);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	void RequestAmbientLine(AUMInteractiveNPCBase* NPC);
+
+	void OnAmbientLine(TWeakObjectPtr<AUMInteractiveNPCBase> NPC, uint32 RequestSerial, uint32 RequestCaseSerial, EIGIBackgroundJobStatus Status, const FString& Line);
+
+	/** Hold the NPC back from ambient jobs for a while after one could not be queued or failed */
+	void BackOff(const TWeakObjectPtr<AUMInteractiveNPCBase>& NPC);
+
+	FString CaseState;
+
+	/** Bumped by SetCaseState; lines requested before the bump arrive stale and are dropped */
+	uint32 CaseStateSerial = 0;
+
+	float TimeSinceScan = 0.0f;
+
+	/** NPCs with a job queued or running, and that job's serial, so a replaced job's completion doesn't clear its successor */
+	TMap<TWeakObjectPtr<AUMInteractiveNPCBase>, uint32> PendingNPCs;
+	uint32 NextRequestSerial = 0;
+
+	struct FRetry
+	{
+		/** World time before which the NPC is skipped */
+		double RetryTime = 0.0;
+		int32 NumFailures = 0;
+	};
+
+	/** NPCs whose last ambient job failed */
+	TMap<TWeakObjectPtr<AUMInteractiveNPCBase>, FRetry> Retries;
+};
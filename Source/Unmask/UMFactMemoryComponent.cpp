@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMFactMemoryComponent.h"
+#include "IGISettings.h"
+
+namespace
+{
+	// Words shorter than this carry too little meaning to match on
+	constexpr int32 MIN_WORD_LEN = 4;
+
+	uint32 HashWord(const TCHAR* Start, int32 Len)
+	{
+		// FNV-1a over lowercased characters, so no temporary strings are built
+		uint32 Hash = 2166136261u;
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			Hash = (Hash ^ static_cast<uint32>(FChar::ToLower(Start[Index]))) * 16777619u;
+		}
+		return Hash;
+	}
+
+	bool IsStopWord(uint32 Hash)
+	{
+		static const TSet<uint32> StopWords = []()
+		{
+			TSet<uint32> Hashes;
+			for (const TCHAR* Word : { TEXT("that"), TEXT("this"), TEXT("with"), TEXT("have"), TEXT("what"), TEXT("about"), TEXT("they"), TEXT("them"), TEXT("your"), TEXT("there"), TEXT("were"), TEXT("been"), TEXT("would"), TEXT("from"), TEXT("when"), TEXT("where"), TEXT("which"), TEXT("just") })
+			{
+				Hashes.Add(HashWord(Word, FCString::Strlen(Word)));
+			}
+			return Hashes;
+		}();
+		return StopWords.Contains(Hash);
+	}
+
+	// Lies must stay consistent for the whole interrogation; shown evidence is hard to forget
+	float GetDecayRate(EUMFactKind Kind)
+	{
+		switch (Kind)
+		{
+		case EUMFactKind::OwnLie:
+			return 0.25f;
+		case EUMFactKind::EvidenceShown:
+			return 0.5f;
+		default:
+			return 1.f;
+		}
+	}
+
+	const TCHAR* GetFactPrefix(EUMFactKind Kind)
+	{
+		switch (Kind)
+		{
+		case EUMFactKind::PlayerStatement:
+			return TEXT("The player told you: ");
+		case EUMFactKind::EvidenceShown:
+			return TEXT("The player showed you ");
+		case EUMFactKind::OwnLie:
+			return TEXT("You lied to the player, and must stick to it: ");
+		default:
+			return TEXT("You noticed: ");
+		}
+	}
+
+	const TCHAR* MEMORY_HEADER = TEXT("What you remember from earlier:\n");
+}
+
+UUMFactMemoryComponent::UUMFactMemoryComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UUMFactMemoryComponent::RememberFact(EUMFactKind Kind, const FString& Text, float Importance, FName Key)
+{
+	FString Fact = Text.TrimStartAndEnd();
+	if (Fact.IsEmpty()) return;
+
+	EnsureWordMasks();
+
+	int32 Index = Key.IsNone() ? INDEX_NONE : Keys.IndexOfByKey(Key);
+	if (Index == INDEX_NONE)
+	{
+		while (Texts.Num() >= FMath::Max(1, MaxFacts))
+		{
+			int32 Weakest = 0;
+			for (int32 Candidate = 1; Candidate < Texts.Num(); ++Candidate)
+			{
+				if (GetRetention(Candidate) < GetRetention(Weakest))
+				{
+					Weakest = Candidate;
+				}
+			}
+			RemoveFactAt(Weakest);
+		}
+
+		Index = Texts.Num();
+		Texts.AddDefaulted();
+		Keys.Add(Key);
+		Kinds.AddDefaulted();
+		Importances.Add(0.f);
+		LastTurns.AddDefaulted();
+		WordMasks.AddDefaulted();
+	}
+
+	WordMasks[Index] = MakeWordMask(Fact);
+	Texts[Index] = MoveTemp(Fact);
+	Kinds[Index] = Kind;
+	Importances[Index] = FMath::Max(Importances[Index], Importance);
+	LastTurns[Index] = CurrentTurn;
+}
+
+void UUMFactMemoryComponent::ForgetFact(FName Key)
+{
+	const int32 Index = Key.IsNone() ? INDEX_NONE : Keys.IndexOfByKey(Key);
+	if (Index != INDEX_NONE)
+	{
+		EnsureWordMasks();
+		RemoveFactAt(Index);
+	}
+}
+
+void UUMFactMemoryComponent::ForgetAll()
+{
+	Texts.Reset();
+	Keys.Reset();
+	Kinds.Reset();
+	Importances.Reset();
+	LastTurns.Reset();
+	WordMasks.Reset();
+}
+
+void UUMFactMemoryComponent::BeginTurn(const FString& PlayerMessage)
+{
+	EnsureWordMasks();
+	++CurrentTurn;
+
+	const FWordMask MessageMask = MakeWordMask(PlayerMessage);
+	if (CountBits(MessageMask) == 0) return;
+
+	// A fact the player brings up again is fresh again; one shared word is too weak a signal for long facts
+	for (int32 Index = 0; Index < Texts.Num(); ++Index)
+	{
+		const int32 Overlap = CountOverlap(MessageMask, WordMasks[Index]);
+		if (Overlap > 0 && Overlap >= FMath::Min(2, CountBits(WordMasks[Index])))
+		{
+			LastTurns[Index] = CurrentTurn;
+		}
+	}
+}
+
+FString UUMFactMemoryComponent::CompileMemoryPrompt(const FString& Query, int32 TokenBudget)
+{
+	if (Texts.IsEmpty()) return FString();
+
+	EnsureWordMasks();
+
+	const float CharsPerToken = GetDefault<UIGISettings>()->ApproxCharsPerToken;
+	const int32 BudgetChars = FMath::RoundToInt((TokenBudget < 0 ? DefaultTokenBudget : TokenBudget) * CharsPerToken);
+
+	const FWordMask QueryMask = MakeWordMask(Query);
+	const int32 QueryBits = CountBits(QueryMask);
+
+	const int32 NumFacts = Texts.Num();
+	Scores.SetNumUninitialized(NumFacts, EAllowShrinking::No);
+	Order.SetNumUninitialized(NumFacts, EAllowShrinking::No);
+	for (int32 Index = 0; Index < NumFacts; ++Index)
+	{
+		const float Relevance = QueryBits > 0 ? static_cast<float>(CountOverlap(QueryMask, WordMasks[Index])) / QueryBits : 0.f;
+		Scores[Index] = GetRetention(Index) + RelevanceWeight * Importances[Index] * Relevance;
+		Order[Index] = Index;
+	}
+	Order.Sort([this](int32 A, int32 B) { return Scores[A] > Scores[B]; });
+
+	// Best first until the budget is spent; a long fact that doesn't fit leaves room for shorter ones
+	int32 UsedChars = FCString::Strlen(MEMORY_HEADER);
+	TArray<int32, TInlineAllocator<32>> Selected;
+	for (const int32 Index : Order)
+	{
+		const int32 LineChars = 3 + FCString::Strlen(GetFactPrefix(Kinds[Index])) + Texts[Index].Len();
+		if (UsedChars + LineChars <= BudgetChars)
+		{
+			Selected.Add(Index);
+			UsedChars += LineChars;
+		}
+	}
+	if (Selected.IsEmpty()) return FString();
+
+	// Learned order rather than score order, so consecutive turns share a prompt prefix
+	Selected.Sort();
+
+	FString Block;
+	Block.Reserve(UsedChars);
+	Block += MEMORY_HEADER;
+	for (const int32 Index : Selected)
+	{
+		Block += TEXT("- ");
+		Block += GetFactPrefix(Kinds[Index]);
+		Block += Texts[Index];
+		Block += TEXT("\n");
+	}
+	return Block;
+}
+
+void UUMFactMemoryComponent::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// a load can replace the facts with the same number of different ones, so a count check can't tell
+	if (Ar.IsLoading())
+	{
+		WordMasks.Reset();
+	}
+}
+
+UUMFactMemoryComponent::FWordMask UUMFactMemoryComponent::MakeWordMask(const FString& Text)
+{
+	FWordMask Mask;
+	const TCHAR* Chars = *Text;
+	const int32 Len = Text.Len();
+
+	int32 WordStart = 0;
+	for (int32 Index = 0; Index <= Len; ++Index)
+	{
+		if (Index < Len && FChar::IsAlnum(Chars[Index]))
+		{
+			continue;
+		}
+
+		const int32 WordLen = Index - WordStart;
+		if (WordLen >= MIN_WORD_LEN)
+		{
+			const uint32 Hash = HashWord(Chars + WordStart, WordLen);
+			if (!IsStopWord(Hash))
+			{
+				Mask.Bits[(Hash >> 6) & 3] |= 1ull << (Hash & 63);
+			}
+		}
+		WordStart = Index + 1;
+	}
+	return Mask;
+}
+
+int32 UUMFactMemoryComponent::CountOverlap(const FWordMask& A, const FWordMask& B)
+{
+	int32 Count = 0;
+	for (int32 Word = 0; Word < 4; ++Word)
+	{
+		Count += FPlatformMath::CountBits(A.Bits[Word] & B.Bits[Word]);
+	}
+	return Count;
+}
+
+int32 UUMFactMemoryComponent::CountBits(const FWordMask& Mask)
+{
+	return CountOverlap(Mask, Mask);
+}
+
+float UUMFactMemoryComponent::GetRetention(int32 Index) const
+{
+	const float TurnsUnmentioned = static_cast<float>(CurrentTurn - LastTurns[Index]);
+	return Importances[Index] * FMath::Exp2(-TurnsUnmentioned * GetDecayRate(Kinds[Index]) / FMath::Max(1.f, DecayHalfLifeTurns));
+}
+
+void UUMFactMemoryComponent::RemoveFactAt(int32 Index)
+{
+	// Order-preserving, so compiled blocks stay in learned order
+	Texts.RemoveAt(Index);
+	Keys.RemoveAt(Index);
+	Kinds.RemoveAt(Index);
+	Importances.RemoveAt(Index);
+	LastTurns.RemoveAt(Index);
+	WordMasks.RemoveAt(Index);
+}
+
+void UUMFactMemoryComponent::EnsureWordMasks()
+{
+	if (WordMasks.Num() == Texts.Num()) return;
+
+	WordMasks.Reset(Texts.Num());
+	for (const FString& Text : Texts)
+	{
+		WordMasks.Add(MakeWordMask(Text));
+	}
+}
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UMFactMemoryComponent.generated.h"
+
+/** What kind of thing an NPC remembers; decides how it is phrased and how fast it fades */
+UENUM(BlueprintType)
+enum class EUMFactKind : uint8
+{
+	/** Something the player told the NPC */
+	PlayerStatement,
+	/** Evidence the player showed the NPC */
+	EvidenceShown,
+	/** A lie the NPC told; fades slowest, so the NPC keeps its story straight */
+	OwnLie,
+	/** Anything else the NPC noticed */
+	Observation,
+};
+
+/**
+ *  Discrete facts an NPC remembers about its conversations, compiled each turn into a short prompt
+ *  block instead of replaying the transcript. Facts are kept as parallel arrays so scoring a turn
+ *  walks a few flat arrays. Each fact's score combines its importance, how recently it was last
+ *  brought up (counted in conversation turns, so it survives save games), and how many words it
+ *  shares with the player's message. Only the best facts that fit the token budget go in the prompt.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class UNMASK_API UUMFactMemoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UUMFactMemoryComponent();
+
+	/** Facts kept; the least relevant one is forgotten to make room */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory", meta = (ClampMin = "1"))
+	int32 MaxFacts = 64;
+
+	/** Prompt tokens the compiled block may use unless the caller passes its own budget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory", meta = (ClampMin = "16"))
+	int32 DefaultTokenBudget = 120;
+
+	/** Turns after which a fact nobody mentions counts half as much; lies and evidence fade slower */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory", meta = (ClampMin = "1.0"))
+	float DecayHalfLifeTurns = 8.f;
+
+	/** Weight of word overlap with the player's message against importance and recency */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Memory", meta = (ClampMin = "0.0"))
+	float RelevanceWeight = 2.f;
+
+	/**
+	 * Remember a fact. A fact with the same non-None Key (e.g. an evidence id) is updated and
+	 * refreshed instead of added twice.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Memory")
+	void RememberFact(EUMFactKind Kind, const FString& Text, float Importance = 1.f, FName Key = NAME_None);
+
+	UFUNCTION(BlueprintCallable, Category = "Memory")
+	void ForgetFact(FName Key);
+
+	UFUNCTION(BlueprintCallable, Category = "Memory")
+	void ForgetAll();
+
+	/** Start a conversation turn: ages every fact by one turn and refreshes those the player's message brings up */
+	UFUNCTION(BlueprintCallable, Category = "Memory")
+	void BeginTurn(const FString& PlayerMessage);
+
+	/**
+	 * The facts most worth remembering for a reply to Query, as a prompt block within TokenBudget
+	 * (-1 uses DefaultTokenBudget). Facts keep the order they were learned in, so the block only
+	 * changes where the selection does. Empty if nothing is remembered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Memory")
+	FString CompileMemoryPrompt(const FString& Query, int32 TokenBudget = -1);
+
+	UFUNCTION(BlueprintPure, Category = "Memory")
+	int32 GetNumFacts() const { return Texts.Num(); }
+
+	virtual void Serialize(FArchive& Ar) override;
+
+protected:
+
+	/** 256-bit set of hashed words, for overlap tests without tokenizing twice */
+	struct FWordMask
+	{
+		uint64 Bits[4] = { 0, 0, 0, 0 };
+	};
+
+	static FWordMask MakeWordMask(const FString& Text);
+	static int32 CountOverlap(const FWordMask& A, const FWordMask& B);
+	static int32 CountBits(const FWordMask& Mask);
+
+	/** Importance scaled by how long the fact has gone unmentioned */
+	float GetRetention(int32 Index) const;
+
+	void RemoveFactAt(int32 Index);
+
+	/** Rebuild the word masks if Serialize dropped them, or if they are out of step with the facts */
+	void EnsureWordMasks();
+
+	// One entry per fact in each array
+
+	UPROPERTY(SaveGame)
+	TArray<FString> Texts;
+
+	UPROPERTY(SaveGame)
+	TArray<FName> Keys;
+
+	UPROPERTY(SaveGame)
+	TArray<EUMFactKind> Kinds;
+
+	UPROPERTY(SaveGame)
+	TArray<float> Importances;
+
+	/** Turn the fact was learned or last brought up */
+	UPROPERTY(SaveGame)
+	TArray<int32> LastTurns;
+
+	UPROPERTY(SaveGame)
+	int32 CurrentTurn = 0;
+
+	/** Derived from Texts; dropped whenever the facts are loaded */
+	TArray<FWordMask> WordMasks;
+
+	// Scratch for CompileMemoryPrompt, kept to avoid reallocating every turn
+	TArray<float> Scores;
+	TArray<int32> Order;
+};
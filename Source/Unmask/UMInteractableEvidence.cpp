@@ -2,6 +2,7 @@
 
 
 #include "UMInteractableEvidence.h"
+#include "UMInteractableRegistry.h"
 #include "UnmaskPlayerController.h"
 
 // Sets default values
@@ -17,7 +18,21 @@ AUMInteractableEvidence::AUMInteractableEvidence()
 void AUMInteractableEvidence::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	if (UUMInteractableRegistry* Registry = GetWorld()->GetSubsystem<UUMInteractableRegistry>())
+	{
+		Registry->Register(this);
+	}
+}
+
+void AUMInteractableEvidence::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UUMInteractableRegistry* Registry = GetWorld()->GetSubsystem<UUMInteractableRegistry>())
+	{
+		Registry->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AUMInteractableEvidence::Interact_Implementation(APawn* InstigatorPawn)
@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMInteractableRegistry.h"
+#include "Components/SceneComponent.h"
+#include "GameplayInterface.h"
+#include "Math/VectorRegister.h"
+#include "UMSettings.h"
+
+void UUMInteractableRegistry::Register(AActor* Actor)
+{
+	if (!Actor || !Actor->Implements<UGameplayInterface>() || EntryIndices.Contains(Actor)) return;
+
+	USceneComponent* Root = Actor->GetRootComponent();
+	if (!Root) return;
+
+	FVector Origin;
+	FVector Extent;
+	Actor->GetActorBounds(true, Origin, Extent);
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.LocalCenter = Root->GetComponentTransform().InverseTransformPosition(Origin);
+	Entry.Center = Origin;
+	Entry.Radius = Extent.Size();
+
+	EntryIndices.Add(Actor, Entries.Num() - 1);
+	EntryIndicesByRoot.Add(Root, Entries.Num() - 1);
+	Root->TransformUpdated.AddUObject(this, &UUMInteractableRegistry::OnTransformUpdated);
+	bDirty = true;
+}
+
+void UUMInteractableRegistry::Unregister(AActor* Actor)
+{
+	int32 Index = INDEX_NONE;
+	if (!EntryIndices.RemoveAndCopyValue(Actor, Index)) return;
+
+	if (USceneComponent* Root = Actor->GetRootComponent())
+	{
+		Root->TransformUpdated.RemoveAll(this);
+		EntryIndicesByRoot.Remove(Root);
+	}
+
+	// keep the arrays dense; the last entry takes the removed one's place
+	Entries.RemoveAtSwap(Index);
+	if (Entries.IsValidIndex(Index))
+	{
+		if (AActor* Moved = Entries[Index].Actor.Get())
+		{
+			EntryIndices.Add(Moved, Index);
+			EntryIndicesByRoot.Add(Moved->GetRootComponent(), Index);
+		}
+	}
+	bDirty = true;
+}
+
+bool UUMInteractableRegistry::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UUMInteractableRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(50.0f, GetDefault<UUMSettings>()->InteractableCellSize);
+}
+
+void UUMInteractableRegistry::OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	const int32* Index = EntryIndicesByRoot.Find(UpdatedComponent);
+	if (!Index) return;
+
+	FEntry& Entry = Entries[*Index];
+	Entry.Center = UpdatedComponent->GetComponentTransform().TransformPosition(Entry.LocalCenter);
+	if (bDirty) return;
+
+	// a move within the cell rewrites the entry's slot in place; only a full destination cell re-packs the grid
+	const FIntPoint NewCell = GetCell(Entry.Center);
+	if (NewCell == Entry.Cell)
+	{
+		PackSlot(Entry.Slot, *Index);
+	}
+	else if (!MoveToCell(*Index, NewCell))
+	{
+		bDirty = true;
+	}
+}
+
+FIntPoint UUMInteractableRegistry::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UUMInteractableRegistry::PackSlot(int32 Slot, int32 EntryIndex)
+{
+	// padding has a negative radius, which every query rejects
+	if (EntryIndex == INDEX_NONE)
+	{
+		PackedX[Slot] = 0.0f;
+		PackedY[Slot] = 0.0f;
+		PackedZ[Slot] = 0.0f;
+		PackedRadii[Slot] = -1.0f;
+		PackedEntries[Slot] = INDEX_NONE;
+		return;
+	}
+
+	const FEntry& Entry = Entries[EntryIndex];
+	PackedX[Slot] = Entry.Center.X;
+	PackedY[Slot] = Entry.Center.Y;
+	PackedZ[Slot] = Entry.Center.Z;
+	PackedRadii[Slot] = Entry.Radius;
+	PackedEntries[Slot] = EntryIndex;
+}
+
+bool UUMInteractableRegistry::MoveToCell(int32 EntryIndex, const FIntPoint& NewCell)
+{
+	FCell* To = Cells.Find(NewCell);
+	if (!To || To->Used == To->Num) return false;
+
+	// the old cell's last filled slot takes the vacated one, so filled slots stay ahead of the padding
+	FEntry& Entry = Entries[EntryIndex];
+	FCell& From = Cells[Entry.Cell];
+	const int32 Last = From.Start + --From.Used;
+	if (Last != Entry.Slot)
+	{
+		const int32 Moved = PackedEntries[Last];
+		Entries[Moved].Slot = Entry.Slot;
+		PackSlot(Entry.Slot, Moved);
+	}
+	PackSlot(Last, INDEX_NONE);
+
+	Entry.Cell = NewCell;
+	Entry.Slot = To->Start + To->Used++;
+	PackSlot(Entry.Slot, EntryIndex);
+	return true;
+}
+
+void UUMInteractableRegistry::Rebuild()
+{
+	bDirty = false;
+	Cells.Reset();
+	MaxRadius = 0.0f;
+
+	for (FEntry& Entry : Entries)
+	{
+		Entry.Cell = GetCell(Entry.Center);
+		++Cells.FindOrAdd(Entry.Cell).Used;
+		MaxRadius = FMath::Max(MaxRadius, Entry.Radius);
+	}
+
+	// lay cells out back to back, each starting on a SIMD lane boundary, with at least one spare slot
+	// so an interactable walking in doesn't force a re-pack
+	int32 NumSlots = 0;
+	for (TPair<FIntPoint, FCell>& Pair : Cells)
+	{
+		Pair.Value.Start = NumSlots;
+		Pair.Value.Num = Align(Pair.Value.Used + 1, 4);
+		Pair.Value.Used = 0;
+		NumSlots += Pair.Value.Num;
+	}
+
+	PackedX.SetNumZeroed(NumSlots);
+	PackedY.SetNumZeroed(NumSlots);
+	PackedZ.SetNumZeroed(NumSlots);
+	PackedRadii.Init(-1.0f, NumSlots);
+	PackedEntries.Init(INDEX_NONE, NumSlots);
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		FCell& Cell = Cells[Entries[Index].Cell];
+		Entries[Index].Slot = Cell.Start + Cell.Used++;
+		PackSlot(Entries[Index].Slot, Index);
+	}
+}
+
+void UUMInteractableRegistry::FindFocusCandidates(const FVector& EyeLocation, const FVector& ViewDirection, float MaxDistance, float ConeHalfAngleDegrees, float DistanceWeight, int32 MaxCandidates, TArray<FUMFocusCandidate>& OutCandidates)
+{
+	OutCandidates.Reset();
+	if (bDirty)
+	{
+		Rebuild();
+	}
+	if (Entries.IsEmpty() || MaxCandidates <= 0) return;
+
+	const FVector End = EyeLocation + ViewDirection * MaxDistance;
+	const FIntPoint MinCell = GetCell(EyeLocation.ComponentMin(End) - FVector(MaxRadius));
+	const FIntPoint MaxCell = GetCell(EyeLocation.ComponentMax(End) + FVector(MaxRadius));
+
+	const VectorRegister4Float EyeX = VectorSetFloat1(EyeLocation.X);
+	const VectorRegister4Float EyeY = VectorSetFloat1(EyeLocation.Y);
+	const VectorRegister4Float EyeZ = VectorSetFloat1(EyeLocation.Z);
+	const VectorRegister4Float DirX = VectorSetFloat1(ViewDirection.X);
+	const VectorRegister4Float DirY = VectorSetFloat1(ViewDirection.Y);
+	const VectorRegister4Float DirZ = VectorSetFloat1(ViewDirection.Z);
+	const VectorRegister4Float CosHalfAngle = VectorSetFloat1(FMath::Cos(FMath::DegreesToRadians(ConeHalfAngleDegrees)));
+	const VectorRegister4Float Reach = VectorSetFloat1(MaxDistance);
+	const VectorRegister4Float DistanceScale = VectorSetFloat1(DistanceWeight / FMath::Max(MaxDistance, 1.0f));
+	const VectorRegister4Float MinDistance = VectorSetFloat1(1.0f);
+	const VectorRegister4Float Rejected = VectorSetFloat1(-MAX_FLT);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const FCell* Cell = Cells.Find(FIntPoint(CellX, CellY));
+			if (!Cell) continue;
+
+			for (int32 Slot = Cell->Start; Slot < Cell->Start + Cell->Num; Slot += 4)
+			{
+				const VectorRegister4Float Radius = VectorLoadAligned(&PackedRadii[Slot]);
+				const VectorRegister4Float DX = VectorSubtract(VectorLoadAligned(&PackedX[Slot]), EyeX);
+				const VectorRegister4Float DY = VectorSubtract(VectorLoadAligned(&PackedY[Slot]), EyeY);
+				const VectorRegister4Float DZ = VectorSubtract(VectorLoadAligned(&PackedZ[Slot]), EyeZ);
+
+				const VectorRegister4Float Distance = VectorMax(VectorSqrt(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)))), MinDistance);
+				const VectorRegister4Float Along = VectorMultiplyAdd(DX, DirX, VectorMultiplyAdd(DY, DirY, VectorMultiply(DZ, DirZ)));
+
+				// the bounding sphere reaches into the cone and within reach; padding fails the radius test
+				VectorRegister4Float Mask = VectorCompareGE(Radius, Zero);
+				Mask = VectorBitwiseAnd(Mask, VectorCompareGE(VectorAdd(Along, Radius), VectorMultiply(CosHalfAngle, Distance)));
+				Mask = VectorBitwiseAnd(Mask, VectorCompareLE(VectorSubtract(Distance, Radius), Reach));
+				if (!VectorMaskBits(Mask)) continue;
+
+				const VectorRegister4Float Score = VectorSubtract(VectorDivide(Along, Distance), VectorMultiply(Distance, DistanceScale));
+
+				alignas(16) float Lanes[4];
+				VectorStoreAligned(VectorSelect(Mask, Score, Rejected), Lanes);
+				for (int32 Lane = 0; Lane < 4; ++Lane)
+				{
+					// kept best first; a handful at most, so insertion beats sorting afterwards
+					const float Worst = OutCandidates.Num() < MaxCandidates ? -MAX_FLT : OutCandidates.Last().Score;
+					if (Lanes[Lane] <= Worst) continue;
+
+					int32 Position = OutCandidates.Num();
+					while (Position > 0 && OutCandidates[Position - 1].Score < Lanes[Lane])
+					{
+						--Position;
+					}
+					if (OutCandidates.Num() == MaxCandidates)
+					{
+						OutCandidates.Pop(EAllowShrinking::No);
+					}
+
+					const FEntry& Entry = Entries[PackedEntries[Slot + Lane]];
+					OutCandidates.Insert({ Entry.Actor, Entry.Center, Lanes[Lane] }, Position);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UMInteractableRegistry.generated.h"
+
+enum class EUpdateTransformFlags : int32;
+enum class ETeleportType : uint8;
+
+/** An interactable inside the view cone and reach, scored by alignment with the view and distance */
+struct FUMFocusCandidate
+{
+	TWeakObjectPtr<AActor> Actor;
+	FVector Center = FVector::ZeroVector;
+	float Score = 0.0f;
+};
+
+/**
+ *  Every interactable in the world, bucketed in a spatial hash grid so focus queries touch only the
+ *  cells around the view instead of sweeping physics. Positions and radii are packed per cell as
+ *  structure-of-arrays and tested four at a time; only the best candidates need a visibility trace.
+ *  Interactables register themselves on BeginPlay and follow their root component when it moves: a
+ *  move within its cell rewrites the entry's packed slot, and a move to another cell takes a spare
+ *  slot there, so only registration changes and crowded cells re-pack the grid. The cell size is
+ *  UUMSettings::InteractableCellSize.
+ */
+UCLASS()
+class UNMASK_API UUMInteractableRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Track an actor implementing IGameplayInterface; its bounds decide how easy it is to focus. Blueprint-only interactables call this from BeginPlay. */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void Register(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void Unregister(AActor* Actor);
+
+	/**
+	 *  Up to MaxCandidates interactables whose bounds fall within the view cone and reach, best first,
+	 *  by alignment with the view and then distance. Nothing checks the line of sight: trace to each
+	 *  candidate's Center before trusting it, and fall through to the next when the trace is blocked.
+	 */
+	void FindFocusCandidates(const FVector& EyeLocation, const FVector& ViewDirection, float MaxDistance, float ConeHalfAngleDegrees, float DistanceWeight, int32 MaxCandidates, TArray<FUMFocusCandidate>& OutCandidates);
+
+	int32 GetNumInteractables() const { return Entries.Num(); }
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+protected:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Bounds centre in the root component's space, so it follows rotation too */
+		FVector LocalCenter = FVector::ZeroVector;
+		FVector Center = FVector::ZeroVector;
+		float Radius = 0.0f;
+
+		/** Where the entry was last packed; valid while the grid isn't dirty */
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 Slot = INDEX_NONE;
+	};
+
+	/** A cell's slots in the packed arrays, padded to a whole number of SIMD lanes; Used are filled, the rest is padding */
+	struct FCell
+	{
+		int32 Start = 0;
+		int32 Num = 0;
+		int32 Used = 0;
+	};
+
+	void OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Write an entry into a packed slot, or clear the slot to padding with INDEX_NONE */
+	void PackSlot(int32 Slot, int32 EntryIndex);
+
+	/** Move a packed entry to another cell; false if that cell has no spare slot and the grid must re-pack */
+	bool MoveToCell(int32 EntryIndex, const FIntPoint& NewCell);
+
+	/** Re-pack the grid after interactables were added, removed or moved */
+	void Rebuild();
+
+	TArray<FEntry> Entries;
+	TMap<TObjectKey<AActor>, int32> EntryIndices;
+	TMap<TObjectKey<USceneComponent>, int32> EntryIndicesByRoot;
+
+	TMap<FIntPoint, FCell> Cells;
+	TArray<float, TAlignedHeapAllocator<16>> PackedX;
+	TArray<float, TAlignedHeapAllocator<16>> PackedY;
+	TArray<float, TAlignedHeapAllocator<16>> PackedZ;
+	TArray<float, TAlignedHeapAllocator<16>> PackedRadii;
+
+	/** Entry behind each packed slot; INDEX_NONE for padding */
+	TArray<int32> PackedEntries;
+
+	/** UUMSettings::InteractableCellSize, read once at Initialize since every packed cell depends on it */
+	float CellSize = 400.0f;
+
+	float MaxRadius = 0.0f;
+	bool bDirty = false;
+};
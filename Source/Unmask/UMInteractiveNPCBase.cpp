@@ -1,7 +1,11 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "UMInteractiveNPCBase.h"
+#include "UMFactMemoryComponent.h"
+#include "UMInteractableRegistry.h"
 #include "UnmaskPlayerController.h"
+#include "IGIKVCacheManager.h"
+#include "IGIModule.h"
 
 // Sets default values
 AUMInteractiveNPCBase::AUMInteractiveNPCBase()
@@ -9,13 +13,36 @@ AUMInteractiveNPCBase::AUMInteractiveNPCBase()
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = false;
 
+	FactMemory = CreateDefaultSubobject<UUMFactMemoryComponent>(TEXT("FactMemory"));
 }
 
 // Called when the game starts or when spawned
 void AUMInteractiveNPCBase::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	if (UUMInteractableRegistry* Registry = GetWorld()->GetSubsystem<UUMInteractableRegistry>())
+	{
+		Registry->Register(this);
+	}
+
+	if (SessionContextSize > 0)
+	{
+		if (FIGIModule* IGIModulePtr = FModuleManager::GetModulePtr<FIGIModule>(FName("IGI")))
+		{
+			IGIModulePtr->GetKVCacheManager()->SetSessionContextSize(GetGPTSessionId(), SessionContextSize);
+		}
+	}
+}
+
+void AUMInteractiveNPCBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UUMInteractableRegistry* Registry = GetWorld()->GetSubsystem<UUMInteractableRegistry>())
+	{
+		Registry->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -42,3 +69,26 @@ void AUMInteractiveNPCBase::Interact_Implementation(APawn* InstigatorPawn)
 	}
 };
 
+bool AUMInteractiveNPCBase::PopAmbientLine(FString& OutLine)
+{
+	if (AmbientLines.IsEmpty())
+	{
+		return false;
+	}
+
+	OutLine = AmbientLines[0];
+	AmbientLines.RemoveAt(0);
+	return true;
+}
+
+void AUMInteractiveNPCBase::PushAmbientLine(const FString& Line)
+{
+	if (Line.IsEmpty()) return;
+
+	// Bounded buffer: the oldest line makes room for the newest
+	while (AmbientLines.Num() >= AmbientLineBufferSize)
+	{
+		AmbientLines.RemoveAt(0);
+	}
+	AmbientLines.Add(Line);
+}
@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameplayInterface.h"
 #include "GameFramework/Character.h"
+#include "IGITypes.h"
 #include "UMInteractiveNPCBase.generated.h"
 
+class UUMFactMemoryComponent;
+
 UCLASS()
 class UNMASK_API AUMInteractiveNPCBase : public ACharacter, public IGameplayInterface
 {
@@ -22,6 +25,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -38,4 +43,58 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPT", meta = (MultiLine = true))
 	FString CharacterBackgroundPrompt;
 
+	/**
+	 *  Logit bias for this NPC's replies, on top of the project's case vocabulary: positive for names they should say right,
+	 *  negative for topics they never bring up. Only a llama.cpp Remote backend applies it; the default nvigi backend has
+	 *  no sampling hook and ignores it, so don't rely on it to keep secrets.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPT|Persona")
+	TMap<FString, float> VocabularyBias;
+
+	/** Facts this NPC has learned in conversation; compile them into each turn's prompt instead of the transcript */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GPT|Memory")
+	TObjectPtr<UUMFactMemoryComponent> FactMemory;
+
+	/** Model tier this NPC's conversations run on. Auto routes short exchanges to the small model. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPT")
+	EIGIModelTier ModelTier = EIGIModelTier::Auto;
+
+	/** Context tokens this NPC's warm session may occupy. 0 uses the project default. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GPT", meta = (ClampMin = "0"))
+	int32 SessionContextSize = 0;
+
+	/** Scheduling class of this NPC's replies to the player, as sent by Send text to NPC. Lower it for NPCs the player only overhears. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPT")
+	EIGIRequestPriority ConversationPriority = EIGIRequestPriority::Interactive;
+
+	/** Session id passed to GPT requests so this NPC's conversation stays warm */
+	UFUNCTION(BlueprintPure, Category = "GPT")
+	FString GetGPTSessionId() const { return CharacterName; }
+
+	/** Pre-generate ambient lines for this NPC while the backend is idle and the player is nearby */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPT|Ambient")
+	bool bGenerateAmbientLines = true;
+
+	/** Maximum number of pre-generated ambient lines kept for this NPC */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GPT|Ambient", meta = (ClampMin = "1"))
+	int32 AmbientLineBufferSize = 3;
+
+	/** Scheduling class of this NPC's ambient lines; Maintenance lets other NPCs' lines go first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPT|Ambient")
+	EIGIRequestPriority AmbientPriority = EIGIRequestPriority::Ambient;
+
+	/** Take the oldest pre-generated ambient line. Returns false if none is ready. */
+	UFUNCTION(BlueprintCallable, Category = "GPT|Ambient")
+	bool PopAmbientLine(FString& OutLine);
+
+	void PushAmbientLine(const FString& Line);
+
+	bool NeedsAmbientLines() const { return bGenerateAmbientLines && AmbientLines.Num() < AmbientLineBufferSize; }
+
+	/** Drop buffered lines, e.g. when the case state they were generated from is stale */
+	UFUNCTION(BlueprintCallable, Category = "GPT|Ambient")
+	void ClearAmbientLines() { AmbientLines.Reset(); }
+
+private:
+	TArray<FString> AmbientLines;
 };
@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMLookAtSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "UMInteractableRegistry.h"
+#include "UMSettings.h"
+#include "UMTraceQueryService.h"
+#include "UnmaskCharacter.h"
+
+AActor* UUMLookAtSubsystem::GetFocus(const APawn* Viewer) const
+{
+	for (const FViewer& Entry : Viewers)
+	{
+		if (Entry.Character.Get() == Viewer)
+		{
+			return Entry.Focus.Get();
+		}
+	}
+	return nullptr;
+}
+
+bool UUMLookAtSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UUMLookAtSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// drop viewers whose controller went away or stopped possessing their character
+	for (int32 Index = Viewers.Num() - 1; Index >= 0; --Index)
+	{
+		FViewer& Viewer = Viewers[Index];
+		const APlayerController* Controller = Viewer.Controller.Get();
+		if (!Controller || !Viewer.Character.IsValid() || Controller->GetPawn() != Viewer.Character.Get())
+		{
+			SetFocus(Viewer, nullptr);
+			Viewers.RemoveAtSwap(Index);
+		}
+	}
+
+	// only local players look at things; remote and AI characters never query
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* Controller = It->Get();
+		if (!Controller || !Controller->IsLocalController()) continue;
+
+		AUnmaskCharacter* Character = Cast<AUnmaskCharacter>(Controller->GetPawn());
+		if (!Character) continue;
+
+		FViewer* Viewer = Viewers.FindByPredicate([Controller](const FViewer& Entry) { return Entry.Controller.Get() == Controller; });
+		if (!Viewer)
+		{
+			Viewer = &Viewers.AddDefaulted_GetRef();
+			Viewer->Controller = Controller;
+			Viewer->Character = Character;
+		}
+
+		UpdateViewer(*Viewer, DeltaTime);
+	}
+}
+
+TStatId UUMLookAtSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUMLookAtSubsystem, STATGROUP_Tickables);
+}
+
+void UUMLookAtSubsystem::UpdateViewer(FViewer& Viewer, float DeltaTime)
+{
+	AUnmaskCharacter* Character = Viewer.Character.Get();
+	if (Character->ShouldSkipLookAtTrace())
+	{
+		SetFocus(Viewer, nullptr);
+		Viewer.bQueried = false;
+		++Viewer.QuerySerial;
+		return;
+	}
+
+	const UUMSettings* Settings = GetDefault<UUMSettings>();
+	Viewer.TimeSinceQuery += DeltaTime;
+	if (Viewer.bQueried && Viewer.TimeSinceQuery < Settings->LookAtQueryInterval) return;
+
+	FVector EyeLocation;
+	FRotator EyeRotation;
+	Viewer.Controller->GetPlayerViewPoint(EyeLocation, EyeRotation);
+	const FQuat EyeQuat = EyeRotation.Quaternion();
+
+	const bool bMoved = FVector::DistSquared(EyeLocation, Viewer.LastLocation) > FMath::Square(Settings->LookAtMoveThreshold);
+	const bool bTurned = FMath::RadiansToDegrees(EyeQuat.AngularDistance(Viewer.LastRotation)) > Settings->LookAtRotationThresholdDegrees;
+	const bool bStale = Viewer.TimeSinceQuery >= Settings->LookAtMaxFocusAge || Viewer.Focus.IsStale();
+	if (Viewer.bQueried && !bMoved && !bTurned && !bStale) return;
+
+	Viewer.LastLocation = EyeLocation;
+	Viewer.LastRotation = EyeQuat;
+	Viewer.TimeSinceQuery = 0.0f;
+	Viewer.bQueried = true;
+	++Viewer.QuerySerial;
+
+	UUMInteractableRegistry* Registry = GetWorld()->GetSubsystem<UUMInteractableRegistry>();
+	if (Registry)
+	{
+		Registry->FindFocusCandidates(EyeLocation, EyeQuat.GetForwardVector(), Character->GetInteractDistance(), Settings->LookAtConeHalfAngleDegrees, Settings->LookAtDistanceWeight, Settings->LookAtMaxCandidates, Viewer.Candidates);
+	}
+	else
+	{
+		Viewer.Candidates.Reset();
+	}
+	if (Viewer.Candidates.IsEmpty() || !GetWorld()->GetSubsystem<UUMTraceQueryService>())
+	{
+		SetFocus(Viewer, nullptr);
+		return;
+	}
+
+	TraceCandidate(Viewer, 0);
+}
+
+void UUMLookAtSubsystem::TraceCandidate(FViewer& Viewer, int32 CandidateIndex)
+{
+	// a candidate only becomes the focus once the player can be shown to see it
+	UUMTraceQueryService* TraceService = GetWorld()->GetSubsystem<UUMTraceQueryService>();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(UMLookAtVisibility), false, Viewer.Character.Get());
+	TraceService->LineTraceDeferred(EUMTraceQuery::Focus, Viewer.LastLocation, Viewer.Candidates[CandidateIndex].Center, ECC_Visibility, QueryParams,
+		[this, Controller = Viewer.Controller, QuerySerial = Viewer.QuerySerial, CandidateIndex](const FHitResult& Hit)
+		{
+			OnVisibilityResult(Controller, QuerySerial, CandidateIndex, Hit);
+		});
+}
+
+void UUMLookAtSubsystem::OnVisibilityResult(TWeakObjectPtr<APlayerController> Controller, uint32 QuerySerial, int32 CandidateIndex, const FHitResult& Hit)
+{
+	FViewer* Viewer = Viewers.FindByPredicate([&Controller](const FViewer& Entry) { return Entry.Controller == Controller; });
+	if (!Viewer || Viewer->QuerySerial != QuerySerial) return;
+
+	AActor* CandidateActor = Viewer->Candidates[CandidateIndex].Actor.Get();
+	if (CandidateActor && (!Hit.bBlockingHit || Hit.GetActor() == CandidateActor))
+	{
+		SetFocus(*Viewer, CandidateActor);
+		return;
+	}
+
+	// the best candidate is behind something; the next best may still be in plain view
+	if (Viewer->Candidates.IsValidIndex(CandidateIndex + 1))
+	{
+		TraceCandidate(*Viewer, CandidateIndex + 1);
+		return;
+	}
+	SetFocus(*Viewer, nullptr);
+}
+
+void UUMLookAtSubsystem::SetFocus(FViewer& Viewer, AActor* NewFocus)
+{
+	// a destroyed focus still counts as a change, so listeners can drop their highlight
+	AActor* OldFocus = Viewer.Focus.Get();
+	if (OldFocus == NewFocus && !Viewer.Focus.IsStale()) return;
+
+	Viewer.Focus = NewFocus;
+	OnFocusChanged.Broadcast(Viewer.Character.Get(), NewFocus, OldFocus);
+}
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UMInteractableRegistry.h"
+#include "UMLookAtSubsystem.generated.h"
+
+class AUnmaskCharacter;
+class APlayerController;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FUMOnFocusChanged, APawn*, Viewer, AActor*, NewFocus, AActor*, OldFocus);
+
+/**
+ *  Tracks what each locally controlled character is looking at. Queries run at a fixed rate and only
+ *  once the camera has moved or turned past a threshold (or the result has gone stale), so remote
+ *  and AI characters cost nothing and a still camera costs a vector compare per frame. Candidates
+ *  come from UUMInteractableRegistry rather than physics sweeps, and the best candidate's visibility
+ *  trace runs asynchronously, so focus lands a frame after the query; a hidden candidate hands over
+ *  to the next best, a frame later each. Tuning lives in UUMSettings.
+ */
+UCLASS()
+class UNMASK_API UUMLookAtSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Fires when a viewer's focus changes, including to nothing */
+	UPROPERTY(BlueprintAssignable, Category = "LookAt")
+	FUMOnFocusChanged OnFocusChanged;
+
+	/** What the viewer is currently focused on; nullptr if nothing or if the viewer isn't a local player */
+	UFUNCTION(BlueprintPure, Category = "LookAt")
+	AActor* GetFocus(const APawn* Viewer) const;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	struct FViewer
+	{
+		TWeakObjectPtr<APlayerController> Controller;
+		TWeakObjectPtr<AUnmaskCharacter> Character;
+		TWeakObjectPtr<AActor> Focus;
+		FVector LastLocation = FVector::ZeroVector;
+		FQuat LastRotation = FQuat::Identity;
+		float TimeSinceQuery = 0.0f;
+		bool bQueried = false;
+
+		/** Bumped per query and on suspension, so late visibility results don't override newer ones */
+		uint32 QuerySerial = 0;
+
+		/** The current query's candidates, best first, traced one after another until one is visible */
+		TArray<FUMFocusCandidate> Candidates;
+	};
+
+	void UpdateViewer(FViewer& Viewer, float DeltaTime);
+
+	void SetFocus(FViewer& Viewer, AActor* NewFocus);
+
+	/** Trace from the viewer's eye to one of its candidates */
+	void TraceCandidate(FViewer& Viewer, int32 CandidateIndex);
+
+	void OnVisibilityResult(TWeakObjectPtr<APlayerController> Controller, uint32 QuerySerial, int32 CandidateIndex, const FHitResult& Hit);
+
+	TArray<FViewer> Viewers;
+};
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMNPCConversationAsync.h"
+#include "Engine/GameInstance.h"
+#include "IGIBlueprintLibrary.h"
+#include "UMFactMemoryComponent.h"
+#include "UMInteractiveNPCBase.h"
+#include "UMTranscriptSubsystem.h"
+
+UUMNPCConversationAsync* UUMNPCConversationAsync::SendToNPCAsync(AUMInteractiveNPCBase* NPC, const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt)
+{
+	UUMNPCConversationAsync* BlueprintNode = NewObject<UUMNPCConversationAsync>();
+	BlueprintNode->NPC = NPC;
+	BlueprintNode->SystemPrompt = SystemPrompt;
+	BlueprintNode->UserPrompt = UserPrompt;
+	BlueprintNode->AssistantPrompt = AssistantPrompt;
+	BlueprintNode->AddToRoot();
+
+	return BlueprintNode;
+}
+
+void UUMNPCConversationAsync::Activate()
+{
+	AUMInteractiveNPCBase* Target = NPC.Get();
+	if (!Target)
+	{
+		HandleResponse(FString());
+		return;
+	}
+
+	if (const UGameInstance* GameInstance = Target->GetGameInstance())
+	{
+		Transcript = GameInstance->GetSubsystem<UUMTranscriptSubsystem>();
+		CharacterName = Target->CharacterName;
+		if (Transcript.IsValid())
+		{
+			Transcript->AppendTurn(CharacterName, EUMTranscriptRole::Player, UserPrompt, TArray<FName>());
+		}
+	}
+
+	// The facts worth remembering for this message, within the component's default budget
+	FString FullSystemPrompt = SystemPrompt;
+	if (Target->FactMemory)
+	{
+		Target->FactMemory->BeginTurn(UserPrompt);
+		const FString Memories = Target->FactMemory->CompileMemoryPrompt(UserPrompt);
+		if (!Memories.IsEmpty())
+		{
+			FullSystemPrompt += TEXT("\n\n") + Memories;
+		}
+	}
+
+	Request = UIGIGPTEvaluateAsync::GPTEvaluateAsync(FullSystemPrompt, UserPrompt, AssistantPrompt, Target->ModelTier, Target->GetGPTSessionId(),
+		Target->ConversationPriority, Target->VocabularyBias);
+	Request->OnResponse.AddDynamic(this, &UUMNPCConversationAsync::HandleResponse);
+	Request->OnChunk.AddDynamic(this, &UUMNPCConversationAsync::HandleChunk);
+	// Activate is private on the IGI node; it is the async action's public entry point
+	static_cast<UBlueprintAsyncActionBase*>(Request.Get())->Activate();
+
+	// a rejected request unroots itself without a response
+	if (!Request->IsRooted())
+	{
+		HandleResponse(FString());
+	}
+}
+
+void UUMNPCConversationAsync::HandleResponse(FString Response)
+{
+	if (UUMTranscriptSubsystem* TranscriptSubsystem = Transcript.Get(); TranscriptSubsystem && !Response.IsEmpty())
+	{
+		TranscriptSubsystem->AppendTurn(CharacterName, EUMTranscriptRole::NPC, Response, TArray<FName>());
+	}
+
+	OnResponse.Broadcast(Response);
+	Request = nullptr;
+	SetReadyToDestroy();
+	RemoveFromRoot();
+}
+
+void UUMNPCConversationAsync::HandleChunk(FString Chunk)
+{
+	OnChunk.Broadcast(Chunk);
+}
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "UMNPCConversationAsync.generated.h"
+
+class AUMInteractiveNPCBase;
+class UIGIGPTEvaluateAsync;
+class UUMTranscriptSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUMNPCConversationOutputPin, FString, Response);
+
+/**
+ *  One conversation turn with an NPC. Sends the prompt to GPT the way the NPC is set up to be
+ *  talked to: its model tier, warm session, vocabulary bias and ConversationPriority.
+ *  The turn is counted in the NPC's fact memory, and the facts relevant to the player's message are
+ *  appended to the system prompt. The player's message and the NPC's reply go into its transcript.
+ */
+UCLASS(BlueprintType, meta = (ExposedAsyncProxy = AsyncAction))
+class UNMASK_API UUMNPCConversationAsync : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	/** SystemPrompt is built by the caller, typically the NPC's background; its memory is added here, so don't compile it in again */
+	UFUNCTION(BlueprintCallable, Category = "GPT", meta = (DisplayName = "Send text to NPC (Async)", BlueprintInternalUseOnly = "true"))
+	static UUMNPCConversationAsync* SendToNPCAsync(AUMInteractiveNPCBase* NPC, const FString& SystemPrompt, const FString& UserPrompt, const FString& AssistantPrompt);
+
+	UPROPERTY(BlueprintAssignable)
+	FUMNPCConversationOutputPin OnResponse;
+
+	/** Fires with newly decoded text as the reply streams in */
+	UPROPERTY(BlueprintAssignable)
+	FUMNPCConversationOutputPin OnChunk;
+
+	virtual void Activate() override;
+
+private:
+
+	UFUNCTION()
+	void HandleResponse(FString Response);
+
+	UFUNCTION()
+	void HandleChunk(FString Chunk);
+
+	UPROPERTY()
+	TWeakObjectPtr<AUMInteractiveNPCBase> NPC;
+
+	FString SystemPrompt;
+	FString UserPrompt;
+	FString AssistantPrompt;
+
+	/** Where the reply is recorded; the NPC may be gone by the time it arrives */
+	UPROPERTY()
+	TWeakObjectPtr<UUMTranscriptSubsystem> Transcript;
+	FString CharacterName;
+
+	UPROPERTY()
+	TObjectPtr<UIGIGPTEvaluateAsync> Request;
+};
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "UMSettings.generated.h"
+
+/**
+ *  Project settings for Unmask's own systems (Project Settings > Game > Unmask). Subsystems have no
+ *  details panel to tune them in, so their knobs live here.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Unmask"))
+class UNMASK_API UUMSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Turns buffered per NPC before they are compressed and appended to its transcript file */
+	UPROPERTY(EditAnywhere, Config, Category = "Transcript", meta = (ClampMin = "1"))
+	int32 TranscriptTurnsPerBlock = 16;
+
+	/** Half angle of the view cone an interactable's bounds must reach into to be focused */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	float LookAtConeHalfAngleDegrees = 10.0f;
+
+	/** Shortest time between two focus queries for the same viewer */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt", meta = (ClampMin = "0.0"))
+	float LookAtQueryInterval = 0.1f;
+
+	/** Camera movement that triggers a new focus query */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt", meta = (ClampMin = "0.0"))
+	float LookAtMoveThreshold = 5.0f;
+
+	/** Camera rotation, in degrees, that triggers a new focus query */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt", meta = (ClampMin = "0.0"))
+	float LookAtRotationThresholdDegrees = 1.0f;
+
+	/** Query again after this long even with a still camera, for targets that walk in or out of view */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt", meta = (ClampMin = "0.0"))
+	float LookAtMaxFocusAge = 0.5f;
+
+	/** Score lost per full interact distance between the camera and a focus candidate */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt")
+	float LookAtDistanceWeight = 0.5f;
+
+	/** Candidates tried in turn, best first, when the better ones turn out to be hidden; each costs a trace and a frame */
+	UPROPERTY(EditAnywhere, Config, Category = "LookAt", meta = (ClampMin = "1"))
+	int32 LookAtMaxCandidates = 3;
+
+	/** Only NPCs within this distance of the player get ambient lines */
+	UPROPERTY(EditAnywhere, Config, Category = "Ambient", meta = (ClampMin = "0.0"))
+	float AmbientRadius = 1500.0f;
+
+	/** Seconds between scans for NPCs that need ambient lines */
+	UPROPERTY(EditAnywhere, Config, Category = "Ambient", meta = (ClampMin = "0.0"))
+	float AmbientScanInterval = 2.0f;
+
+	/** Prompt tokens of NPC memories folded into each ambient prompt; 0 leaves them out */
+	UPROPERTY(EditAnywhere, Config, Category = "Ambient", meta = (ClampMin = "0"))
+	int32 AmbientMemoryTokenBudget = 48;
+
+	/** Seconds an NPC waits before asking again after its ambient job failed; doubles with each failure in a row */
+	UPROPERTY(EditAnywhere, Config, Category = "Ambient", meta = (ClampMin = "0.0"))
+	float AmbientRetryDelay = 10.0f;
+
+	/** Longest wait between ambient retries for an NPC that keeps failing */
+	UPROPERTY(EditAnywhere, Config, Category = "Ambient", meta = (ClampMin = "0.0"))
+	float AmbientMaxRetryDelay = 120.0f;
+
+	/** Edge length of an interactable registry grid cell; about the size of a room works well */
+	UPROPERTY(EditAnywhere, Config, Category = "Interaction", meta = (ClampMin = "50.0"))
+	float InteractableCellSize = 400.0f;
+
+	virtual FName GetCategoryName() const override { return TEXT("Game"); }
+};
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMTraceQueryService.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Unmask.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorld TraceStatsCommand(
+		TEXT("Unmask.TraceStats"),
+		TEXT("Print how many gameplay traces ran asynchronously and the game-thread time that saved."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+			{
+				if (const UUMTraceQueryService* Service = World ? World->GetSubsystem<UUMTraceQueryService>() : nullptr)
+				{
+					Service->LogStats();
+				}
+			}));
+}
+
+bool UUMTraceQueryService::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UUMTraceQueryService::LineTraceDeferred(EUMTraceQuery Query, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, TFunction<void(const FHitResult&)> OnResult)
+{
+	++Stats[static_cast<int32>(Query)].NumAsync;
+
+	FTraceDelegate Delegate = FTraceDelegate::CreateWeakLambda(this, [OnResult = MoveTemp(OnResult)](const FTraceHandle& Handle, FTraceDatum& Datum)
+		{
+			OnResult(Datum.OutHits.IsEmpty() ? FHitResult(Datum.Start, Datum.End) : Datum.OutHits[0]);
+		});
+	GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Channel, Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+}
+
+FHitResult UUMTraceQueryService::LineTraceTolerant(EUMTraceQuery Query, const UObject* Caller, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, const FUMTraceTolerance& Tolerance)
+{
+	FUMTraceQueryStats& QueryStats = Stats[static_cast<int32>(Query)];
+	const FStandingKey Key(Caller, Query);
+	if (!StandingQueries.Contains(Key))
+	{
+		// a new caller is a good moment to forget the ones that were destroyed
+		for (auto It = StandingQueries.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().Key.ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	FStandingQuery& Standing = StandingQueries.FindOrAdd(Key);
+
+	if (Standing.bHasResult && IsWithinTolerance(Standing, Start, End, Tolerance))
+	{
+		++QueryStats.NumReused;
+
+		// the cached hit answers how far this ray gets, not where: the impact moves onto the new ray, so
+		// small spreads and drift still land where they were aimed
+		FHitResult Hit = Standing.Hit;
+		Hit.TraceStart = Start;
+		Hit.TraceEnd = End;
+		if (Hit.bBlockingHit)
+		{
+			const FVector Delta = End - Start;
+			const float Length = Delta.Size();
+			if (Hit.Distance > Length)
+			{
+				Hit = FHitResult(Start, End);
+			}
+			else
+			{
+				Hit.ImpactPoint = Start + Delta.GetSafeNormal() * Hit.Distance;
+				Hit.Location = Hit.ImpactPoint;
+				Hit.Time = Length > UE_KINDA_SMALL_NUMBER ? Hit.Distance / Length : 0.0f;
+			}
+		}
+
+		// the answer is getting old; have a fresh one ready for the next call
+		if (!Standing.bPending)
+		{
+			Standing.bPending = true;
+			++QueryStats.NumAsync;
+
+			FTraceDelegate Delegate = FTraceDelegate::CreateWeakLambda(this, [this, Key](const FTraceHandle& Handle, FTraceDatum& Datum)
+				{
+					if (FStandingQuery* Completed = StandingQueries.Find(Key))
+					{
+						Completed->Hit = Datum.OutHits.IsEmpty() ? FHitResult(Datum.Start, Datum.End) : Datum.OutHits[0];
+						Completed->TraceTime = GetWorld()->GetTimeSeconds();
+						Completed->bPending = false;
+					}
+				});
+			GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Channel, Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+		}
+		return Hit;
+	}
+
+	// nothing close enough in hand, so pay for it now; the result serves the next calls too
+	const double StartTime = FPlatformTime::Seconds();
+	FHitResult Hit;
+	if (!GetWorld()->LineTraceSingleByChannel(Hit, Start, End, Channel, Params))
+	{
+		Hit = FHitResult(Start, End);
+	}
+	++QueryStats.NumSync;
+	QueryStats.SyncSeconds += FPlatformTime::Seconds() - StartTime;
+
+	Standing.Hit = Hit;
+	Standing.TraceTime = GetWorld()->GetTimeSeconds();
+	Standing.bHasResult = true;
+	return Hit;
+}
+
+bool UUMTraceQueryService::IsWithinTolerance(const FStandingQuery& Standing, const FVector& Start, const FVector& End, const FUMTraceTolerance& Tolerance) const
+{
+	if (GetWorld()->GetTimeSeconds() - Standing.TraceTime > Tolerance.MaxAgeSeconds) return false;
+	if (FVector::DistSquared(Standing.Hit.TraceStart, Start) > FMath::Square(Tolerance.MaxStartOffset)) return false;
+
+	const FVector TracedDirection = (Standing.Hit.TraceEnd - Standing.Hit.TraceStart).GetSafeNormal();
+	const FVector Direction = (End - Start).GetSafeNormal();
+	if (FVector::DotProduct(TracedDirection, Direction) < FMath::Cos(FMath::DegreesToRadians(Tolerance.MaxAngleDegrees))) return false;
+
+	// a longer ray could hit something the traced one stopped short of
+	return Standing.Hit.bBlockingHit || FVector::DistSquared(Start, End) <= FVector::DistSquared(Standing.Hit.TraceStart, Standing.Hit.TraceEnd) + 1.0;
+}
+
+void UUMTraceQueryService::LogStats() const
+{
+	const UEnum* QueryEnum = StaticEnum<EUMTraceQuery>();
+	for (int32 Index = 0; Index < static_cast<int32>(EUMTraceQuery::MAX); ++Index)
+	{
+		const FUMTraceQueryStats& QueryStats = Stats[Index];
+		UE_LOG(LogUnmask, Display, TEXT("%-10s %8lld async  %8lld reused  %8lld sync (%.3f ms mean)  %.2f ms moved off the game thread"),
+			*QueryEnum->GetNameStringByIndex(Index), QueryStats.NumAsync, QueryStats.NumReused, QueryStats.NumSync, QueryStats.GetMeanSyncMs(), QueryStats.GetSavedMs());
+	}
+}
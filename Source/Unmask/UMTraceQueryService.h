@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UMTraceQueryService.generated.h"
+
+/** What a trace is for; stats are kept per type */
+UENUM(BlueprintType)
+enum class EUMTraceQuery : uint8
+{
+	Focus,
+	PlayerAim,
+	NPCAim,
+
+	MAX UMETA(Hidden)
+};
+
+/** How far a ray may be from the one last traced before its result stops counting for it */
+USTRUCT(BlueprintType)
+struct UNMASK_API FUMTraceTolerance
+{
+	GENERATED_BODY()
+
+	FUMTraceTolerance() = default;
+	FUMTraceTolerance(float InMaxStartOffset, float InMaxAngleDegrees, float InMaxAgeSeconds)
+		: MaxStartOffset(InMaxStartOffset), MaxAngleDegrees(InMaxAngleDegrees), MaxAgeSeconds(InMaxAgeSeconds) {}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trace", meta = (ClampMin = "0.0", Units = "cm"))
+	float MaxStartOffset = 5.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trace", meta = (ClampMin = "0.0"))
+	float MaxAngleDegrees = 0.5f;
+
+	/** The world moves too; older results are traced again even for the same ray */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trace", meta = (ClampMin = "0.0", Units = "s"))
+	float MaxAgeSeconds = 0.1f;
+};
+
+/** Where one query type's traces ran */
+struct FUMTraceQueryStats
+{
+	/** Traces issued asynchronously */
+	int64 NumAsync = 0;
+
+	/** Latency-tolerant queries answered from an async result */
+	int64 NumReused = 0;
+
+	/** Latency-tolerant queries that had to trace on the game thread */
+	int64 NumSync = 0;
+	double SyncSeconds = 0.0;
+
+	double GetMeanSyncMs() const { return NumSync > 0 ? SyncSeconds * 1000.0 / NumSync : 0.0; }
+
+	/** Game-thread time the reused results would have cost as synchronous traces */
+	double GetSavedMs() const { return NumReused * GetMeanSyncMs(); }
+};
+
+/**
+ *  Runs gameplay traces through the physics scene's async queue instead of blocking the game thread.
+ *  Deferred queries deliver their result next frame. Latency-tolerant queries answer immediately
+ *  from the last async result for the same caller when the ray is close enough to the one it was
+ *  traced for, fall back to a synchronous trace when it isn't, and keep a fresh trace in flight.
+ */
+UCLASS()
+class UNMASK_API UUMTraceQueryService : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Trace on the async queue; OnResult runs on the game thread next frame unless this world is torn down first */
+	void LineTraceDeferred(EUMTraceQuery Query, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, TFunction<void(const FHitResult&)> OnResult);
+
+	/**
+	 *  Answer now, from Caller's last async result for this query type when it is within Tolerance of
+	 *  the requested ray, otherwise with a synchronous trace. Without a blocking hit, TraceEnd is End.
+	 */
+	FHitResult LineTraceTolerant(EUMTraceQuery Query, const UObject* Caller, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, const FUMTraceTolerance& Tolerance);
+
+	const FUMTraceQueryStats& GetStats(EUMTraceQuery Query) const { return Stats[static_cast<int32>(Query)]; }
+
+	/** Print every query type's stats to the log */
+	void LogStats() const;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+protected:
+
+	/** Last ray a caller traced for one query type and what it hit */
+	struct FStandingQuery
+	{
+		FHitResult Hit;
+		double TraceTime = 0.0;
+		bool bHasResult = false;
+		bool bPending = false;
+	};
+
+	using FStandingKey = TPair<TObjectKey<UObject>, EUMTraceQuery>;
+
+	bool IsWithinTolerance(const FStandingQuery& Standing, const FVector& Start, const FVector& End, const FUMTraceTolerance& Tolerance) const;
+
+	TMap<FStandingKey, FStandingQuery> StandingQueries;
+
+	FUMTraceQueryStats Stats[static_cast<int32>(EUMTraceQuery::MAX)];
+};
@@ -0,0 +1,462 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UMTranscriptSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Unmask.h"
+#include "UMSettings.h"
+
+namespace
+{
+	constexpr uint32 TRANSCRIPT_MAGIC = 'U' | ('M' << 8) | ('T' << 16) | ('X' << 24);
+	constexpr uint32 TRANSCRIPT_VERSION = 1;
+
+	// Magic and version
+	constexpr int64 FILE_HEADER_SIZE = 8;
+
+	// Turn count, uncompressed size and compressed size ahead of each block's payload
+	constexpr int64 BLOCK_HEADER_SIZE = 12;
+
+	// Far more than a block of turns ever takes; a larger size in a header means the file is corrupt
+	constexpr int32 MAX_BLOCK_UNCOMPRESSED_SIZE = 64 * 1024 * 1024;
+
+	const TCHAR* TRANSCRIPT_EXTENSION = TEXT(".umtx");
+
+	void SerializeTurn(FArchive& Ar, FUMTranscriptTurn& Turn)
+	{
+		uint8 Role = static_cast<uint8>(Turn.Role);
+		Ar << Role << Turn.Timestamp << Turn.Text << Turn.EvidenceIds;
+		Turn.Role = static_cast<EUMTranscriptRole>(Role);
+	}
+
+	FString GetSlotDirectory(const FString& SlotName)
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".transcripts"));
+	}
+
+	/** Replace everything in Dest with the transcript files in Source */
+	bool CopyTranscripts(const FString& Source, const FString& Dest)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		FileManager.DeleteDirectory(*Dest, false, true);
+		FileManager.MakeDirectory(*Dest, true);
+
+		TArray<FString> Files;
+		FileManager.FindFiles(Files, *FPaths::Combine(Source, FString(TEXT("*")) + TRANSCRIPT_EXTENSION), true, false);
+
+		bool bSuccess = true;
+		for (const FString& File : Files)
+		{
+			bSuccess &= FileManager.Copy(*FPaths::Combine(Dest, File), *FPaths::Combine(Source, File)) == COPY_OK;
+		}
+		return bSuccess;
+	}
+}
+
+/**
+ *  One NPC's transcript file: a header followed by independently compressed blocks of turns.
+ *  Turns not yet written sit in Pending and are served from memory.
+ */
+class FUMTranscript
+{
+public:
+	explicit FUMTranscript(const FString& InPath)
+		: Path(InPath)
+	{
+		IndexFile();
+	}
+
+	~FUMTranscript()
+	{
+		Flush();
+		Unmap();
+	}
+
+	int32 Num() const { return NumStored + Pending.Num(); }
+
+	void Append(FUMTranscriptTurn&& Turn, int32 TurnsPerBlock)
+	{
+		Pending.Add(MoveTemp(Turn));
+		if (Pending.Num() >= TurnsPerBlock)
+		{
+			Flush();
+		}
+	}
+
+	bool Flush()
+	{
+		if (Pending.IsEmpty())
+		{
+			return true;
+		}
+
+		TArray<uint8> Raw;
+		FMemoryWriter RawWriter(Raw);
+		for (FUMTranscriptTurn& Turn : Pending)
+		{
+			SerializeTurn(RawWriter, Turn);
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Raw.Num());
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (!FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Raw.GetData(), Raw.Num()))
+		{
+			UE_LOG(LogUnmask, Warning, TEXT("Failed to compress transcript block for %s"), *Path);
+			return false;
+		}
+
+		// Not every platform can grow a file while it is mapped; it is remapped on the next read
+		Unmap();
+
+		IFileManager& FileManager = IFileManager::Get();
+		const int64 ExistingSize = FMath::Max<int64>(0, FileManager.FileSize(*Path));
+		const bool bNewFile = ExistingSize < FILE_HEADER_SIZE;
+		TUniquePtr<FArchive> File(FileManager.CreateFileWriter(*Path, bNewFile ? 0 : FILEWRITE_Append));
+		if (!File.IsValid())
+		{
+			UE_LOG(LogUnmask, Warning, TEXT("Failed to open transcript %s for writing"), *Path);
+			return false;
+		}
+
+		if (bNewFile)
+		{
+			uint32 Magic = TRANSCRIPT_MAGIC;
+			uint32 Version = TRANSCRIPT_VERSION;
+			*File << Magic << Version;
+		}
+
+		FBlock Block;
+		Block.Offset = bNewFile ? FILE_HEADER_SIZE : ExistingSize;
+		Block.FirstTurn = NumStored;
+		Block.NumTurns = Pending.Num();
+		Block.UncompressedSize = Raw.Num();
+		Block.CompressedSize = CompressedSize;
+
+		*File << Block.NumTurns << Block.UncompressedSize << Block.CompressedSize;
+		File->Serialize(Compressed.GetData(), CompressedSize);
+
+		if (!File->Close())
+		{
+			UE_LOG(LogUnmask, Warning, TEXT("Failed to append to transcript %s"), *Path);
+			return false;
+		}
+
+		Blocks.Add(Block);
+		NumStored += Block.NumTurns;
+		Pending.Reset();
+		return true;
+	}
+
+	void GetTurns(int32 FirstTurn, int32 Count, TArray<FUMTranscriptTurn>& OutTurns)
+	{
+		const int32 End = FMath::Min(FirstTurn + Count, Num());
+		int32 TurnIndex = FMath::Max(0, FirstTurn);
+		while (TurnIndex < End)
+		{
+			if (TurnIndex >= NumStored)
+			{
+				OutTurns.Add(Pending[TurnIndex - NumStored]);
+				++TurnIndex;
+				continue;
+			}
+
+			const int32 BlockIndex = Algo::UpperBoundBy(Blocks, TurnIndex, &FBlock::FirstTurn) - 1;
+			const FBlock& Block = Blocks[BlockIndex];
+			if (!DecodeBlock(BlockIndex))
+			{
+				// Skip what can't be read rather than showing the rest out of place
+				TurnIndex = Block.FirstTurn + Block.NumTurns;
+				continue;
+			}
+
+			const int32 BlockEnd = FMath::Min(End, Block.FirstTurn + Block.NumTurns);
+			for (; TurnIndex < BlockEnd; ++TurnIndex)
+			{
+				OutTurns.Add(CachedTurns[TurnIndex - Block.FirstTurn]);
+			}
+		}
+	}
+
+private:
+	struct FBlock
+	{
+		int64 Offset = 0;
+		int32 FirstTurn = 0;
+		int32 NumTurns = 0;
+		int32 UncompressedSize = 0;
+		int32 CompressedSize = 0;
+	};
+
+	bool Map()
+	{
+		if (MappedRegion.IsValid())
+		{
+			return true;
+		}
+
+		FOpenMappedResult Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+		if (Result.HasError())
+		{
+			return false;
+		}
+
+		MappedFile = Result.StealValue();
+		if (!MappedFile.IsValid() || MappedFile->GetFileSize() <= 0)
+		{
+			MappedFile.Reset();
+			return false;
+		}
+
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (!MappedRegion.IsValid())
+		{
+			MappedFile.Reset();
+			return false;
+		}
+		return true;
+	}
+
+	void Unmap()
+	{
+		MappedRegion.Reset();
+		MappedFile.Reset();
+	}
+
+	/** Read the block headers of an existing file; a torn block at the end (crash mid-append) is cut off */
+	void IndexFile()
+	{
+		if (!Map())
+		{
+			return;
+		}
+
+		const TArrayView<const uint8> Bytes(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+		FMemoryReaderView Reader(Bytes);
+
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		Reader << Magic << Version;
+		if (Reader.IsError() || Magic != TRANSCRIPT_MAGIC || Version != TRANSCRIPT_VERSION)
+		{
+			UE_LOG(LogUnmask, Warning, TEXT("%s is not a version %u transcript; starting it over"), *Path, TRANSCRIPT_VERSION);
+			Unmap();
+			IFileManager::Get().Delete(*Path);
+			return;
+		}
+
+		int64 ValidSize = FILE_HEADER_SIZE;
+		while (ValidSize + BLOCK_HEADER_SIZE <= Bytes.Num())
+		{
+			FBlock Block;
+			Block.Offset = ValidSize;
+			Block.FirstTurn = NumStored;
+			Reader.Seek(ValidSize);
+			Reader << Block.NumTurns << Block.UncompressedSize << Block.CompressedSize;
+			if (Block.NumTurns <= 0 || Block.CompressedSize <= 0 || ValidSize + BLOCK_HEADER_SIZE + Block.CompressedSize > Bytes.Num()
+				|| Block.UncompressedSize <= 0 || Block.UncompressedSize > MAX_BLOCK_UNCOMPRESSED_SIZE)
+			{
+				break;
+			}
+
+			Blocks.Add(Block);
+			NumStored += Block.NumTurns;
+			ValidSize += BLOCK_HEADER_SIZE + Block.CompressedSize;
+		}
+
+		if (ValidSize < Bytes.Num())
+		{
+			UE_LOG(LogUnmask, Warning, TEXT("Transcript %s has a torn last block; keeping %d turns"), *Path, NumStored);
+			TArray<uint8> Valid(Bytes.GetData(), static_cast<int32>(ValidSize));
+			Unmap();
+			FFileHelper::SaveArrayToFile(Valid, *Path);
+		}
+	}
+
+	/** Decompress a block into CachedTurns; the last block read is kept, as pages usually fall inside one */
+	bool DecodeBlock(int32 BlockIndex)
+	{
+		if (CachedBlock == BlockIndex)
+		{
+			return true;
+		}
+		if (!Map())
+		{
+			return false;
+		}
+
+		const FBlock& Block = Blocks[BlockIndex];
+		if (Block.Offset + BLOCK_HEADER_SIZE + Block.CompressedSize > MappedRegion->GetMappedSize()
+			|| Block.UncompressedSize <= 0 || Block.UncompressedSize > MAX_BLOCK_UNCOMPRESSED_SIZE)
+		{
+			return false;
+		}
+
+		TArray<uint8> Raw;
+		Raw.SetNumUninitialized(Block.UncompressedSize);
+		const uint8* Payload = MappedRegion->GetMappedPtr() + Block.Offset + BLOCK_HEADER_SIZE;
+		if (!FCompression::UncompressMemory(NAME_Oodle, Raw.GetData(), Raw.Num(), Payload, Block.CompressedSize))
+		{
+			UE_LOG(LogUnmask, Warning, TEXT("Transcript %s has a corrupt block at turn %d"), *Path, Block.FirstTurn);
+			return false;
+		}
+
+		CachedTurns.Reset(Block.NumTurns);
+		FMemoryReader Reader(Raw);
+		for (int32 Index = 0; Index < Block.NumTurns && !Reader.IsError(); ++Index)
+		{
+			SerializeTurn(Reader, CachedTurns.AddDefaulted_GetRef());
+		}
+		if (Reader.IsError())
+		{
+			CachedTurns.Reset();
+			CachedBlock = INDEX_NONE;
+			return false;
+		}
+
+		CachedBlock = BlockIndex;
+		return true;
+	}
+
+	FString Path;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	TArray<FBlock> Blocks;
+	int32 NumStored = 0;
+	TArray<FUMTranscriptTurn> Pending;
+
+	int32 CachedBlock = INDEX_NONE;
+	TArray<FUMTranscriptTurn> CachedTurns;
+};
+
+void UUMTranscriptSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Transcripts of a previous run only come back through LoadTranscripts
+	ActiveDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Transcripts"), TEXT("Active"));
+	IFileManager::Get().DeleteDirectory(*ActiveDirectory, false, true);
+	IFileManager::Get().MakeDirectory(*ActiveDirectory, true);
+
+	TurnsPerBlock = FMath::Max(1, GetDefault<UUMSettings>()->TranscriptTurnsPerBlock);
+}
+
+void UUMTranscriptSubsystem::Deinitialize()
+{
+	CloseAll();
+
+	Super::Deinitialize();
+}
+
+void UUMTranscriptSubsystem::AppendTurn(const FString& CharacterName, EUMTranscriptRole Role, const FString& Text, const TArray<FName>& EvidenceIds)
+{
+	FUMTranscriptTurn Turn;
+	Turn.Role = Role;
+	Turn.Text = Text;
+	Turn.Timestamp = FDateTime::UtcNow();
+	Turn.EvidenceIds = EvidenceIds;
+
+	FindOrOpen(CharacterName).Append(MoveTemp(Turn), TurnsPerBlock);
+}
+
+int32 UUMTranscriptSubsystem::GetNumTurns(const FString& CharacterName)
+{
+	return FindOrOpen(CharacterName).Num();
+}
+
+void UUMTranscriptSubsystem::GetTurns(const FString& CharacterName, int32 FirstTurn, int32 Count, TArray<FUMTranscriptTurn>& OutTurns)
+{
+	OutTurns.Reset();
+	FindOrOpen(CharacterName).GetTurns(FirstTurn, Count, OutTurns);
+}
+
+FString UUMTranscriptSubsystem::BuildConversationHistory(const FString& CharacterName, int32 MaxChars)
+{
+	FUMTranscript& Transcript = FindOrOpen(CharacterName);
+	const int32 PageSize = TurnsPerBlock;
+
+	// Walk back from the newest turn a page at a time until the budget is used up
+	TArray<FString> Lines;
+	TArray<FUMTranscriptTurn> Page;
+	int32 Chars = 0;
+	for (int32 End = Transcript.Num(); End > 0 && Chars < MaxChars; )
+	{
+		const int32 Start = FMath::Max(0, End - PageSize);
+		Page.Reset();
+		Transcript.GetTurns(Start, End - Start, Page);
+
+		for (int32 Index = Page.Num() - 1; Index >= 0; --Index)
+		{
+			const FUMTranscriptTurn& Turn = Page[Index];
+			const TCHAR* Speaker = Turn.Role == EUMTranscriptRole::Player ? TEXT("Detective")
+				: Turn.Role == EUMTranscriptRole::NPC ? *CharacterName : TEXT("Note");
+			FString Line = FString::Printf(TEXT("%s: %s"), Speaker, *Turn.Text);
+
+			if (Chars + Line.Len() + 1 > MaxChars)
+			{
+				Chars = MaxChars;
+				break;
+			}
+			Chars += Line.Len() + 1;
+			Lines.Add(MoveTemp(Line));
+		}
+		End = Start;
+	}
+
+	Algo::Reverse(Lines);
+	return FString::Join(Lines, TEXT("\n"));
+}
+
+void UUMTranscriptSubsystem::FlushTranscripts()
+{
+	for (TPair<FString, TSharedPtr<FUMTranscript>>& Pair : Transcripts)
+	{
+		Pair.Value->Flush();
+	}
+}
+
+bool UUMTranscriptSubsystem::SaveTranscripts(const FString& SlotName)
+{
+	FlushTranscripts();
+	return CopyTranscripts(ActiveDirectory, GetSlotDirectory(SlotName));
+}
+
+bool UUMTranscriptSubsystem::LoadTranscripts(const FString& SlotName)
+{
+	const FString SlotDirectory = GetSlotDirectory(SlotName);
+	if (!IFileManager::Get().DirectoryExists(*SlotDirectory))
+	{
+		return false;
+	}
+
+	// The game in progress is replaced wholesale
+	CloseAll();
+	return CopyTranscripts(SlotDirectory, ActiveDirectory);
+}
+
+FUMTranscript& UUMTranscriptSubsystem::FindOrOpen(const FString& CharacterName)
+{
+	TSharedPtr<FUMTranscript>& Transcript = Transcripts.FindOrAdd(CharacterName);
+	if (!Transcript.IsValid())
+	{
+		const FString Path = FPaths::Combine(ActiveDirectory, FPaths::MakeValidFileName(CharacterName) + TRANSCRIPT_EXTENSION);
+		Transcript = MakeShared<FUMTranscript>(Path);
+	}
+	return *Transcript;
+}
+
+void UUMTranscriptSubsystem::CloseAll()
+{
+	// Each transcript writes its pending turns as it closes
+	Transcripts.Empty();
+}
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UMTranscriptSubsystem.generated.h"
+
+class FUMTranscript;
+
+UENUM(BlueprintType)
+enum class EUMTranscriptRole : uint8
+{
+	Player,
+	NPC,
+	System,
+};
+
+/** One turn of an interrogation */
+USTRUCT(BlueprintType)
+struct UNMASK_API FUMTranscriptTurn
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Transcript")
+	EUMTranscriptRole Role = EUMTranscriptRole::Player;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Transcript")
+	FString Text;
+
+	/** UTC time the turn was recorded */
+	UPROPERTY(BlueprintReadOnly, Category = "Transcript")
+	FDateTime Timestamp;
+
+	/** Evidence presented or referred to during the turn */
+	UPROPERTY(BlueprintReadOnly, Category = "Transcript")
+	TArray<FName> EvidenceIds;
+};
+
+/**
+ *  Per-NPC conversation transcripts that survive level changes and go into save games.
+ *  Each NPC's transcript is an append-only file of compressed blocks. New turns are buffered and
+ *  written out a block at a time. Reads memory-map the file and decompress only the blocks a page
+ *  of the case file UI needs, so hours of interrogation stay small on disk and quick to show.
+ *  The block size is UUMSettings::TranscriptTurnsPerBlock. Turns hold text, not token ids: the nvigi
+ *  GPT interface neither exposes a tokenizer nor accepts tokens. Send text to NPC (Async) records
+ *  both sides of each conversation turn.
+ */
+UCLASS()
+class UNMASK_API UUMTranscriptSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "Transcript")
+	void AppendTurn(const FString& CharacterName, EUMTranscriptRole Role, const FString& Text, const TArray<FName>& EvidenceIds);
+
+	UFUNCTION(BlueprintPure, Category = "Transcript")
+	int32 GetNumTurns(const FString& CharacterName);
+
+	/** Read Count turns starting at FirstTurn, e.g. one page of the case file */
+	UFUNCTION(BlueprintCallable, Category = "Transcript")
+	void GetTurns(const FString& CharacterName, int32 FirstTurn, int32 Count, TArray<FUMTranscriptTurn>& OutTurns);
+
+	/** The most recent turns as prompt text, newest last, within MaxChars */
+	UFUNCTION(BlueprintCallable, Category = "Transcript")
+	FString BuildConversationHistory(const FString& CharacterName, int32 MaxChars = 2000);
+
+	/** Write out buffered turns of every NPC */
+	UFUNCTION(BlueprintCallable, Category = "Transcript")
+	void FlushTranscripts();
+
+	/** Copy every transcript next to the given save game slot. Call alongside SaveGameToSlot. */
+	UFUNCTION(BlueprintCallable, Category = "Transcript")
+	bool SaveTranscripts(const FString& SlotName);
+
+	/** Replace every transcript with those saved for the slot. Call alongside LoadGameFromSlot. */
+	UFUNCTION(BlueprintCallable, Category = "Transcript")
+	bool LoadTranscripts(const FString& SlotName);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+protected:
+
+	FUMTranscript& FindOrOpen(const FString& CharacterName);
+
+	/** Drop every open transcript, releasing its file mapping */
+	void CloseAll();
+
+	/** Transcripts of the game in progress */
+	FString ActiveDirectory;
+
+	/** UUMSettings::TranscriptTurnsPerBlock, read once at Initialize */
+	int32 TurnsPerBlock = 16;
+
+	TMap<FString, TSharedPtr<FUMTranscript>> Transcripts;
+};
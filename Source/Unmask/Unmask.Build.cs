@@ -19,6 +19,7 @@ public class Unmask : ModuleRules
 			"GameplayStateTreeModule",
 			"UMG",
 			"Slate",
+			"DeveloperSettings",
 			"IGI"
 		});
 
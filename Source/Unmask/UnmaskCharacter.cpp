@@ -10,6 +10,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Unmask.h"
 #include "UMInteractionComponent.h"
+#include "UMLookAtSubsystem.h"
 
 AUnmaskCharacter::AUnmaskCharacter()
 {
@@ -47,38 +48,10 @@ AUnmaskCharacter::AUnmaskCharacter()
 	GetCharacterMovement()->AirControl = 0.5f;
 }
 
-void AUnmaskCharacter::Tick(float DeltaSeconds)
+AActor* AUnmaskCharacter::GetCurrentLookAtActor() const
 {
-	Super::Tick(DeltaSeconds);
-
-	CurrentLookAtActor = nullptr;
-	if (!bSkipLookTrace)
-	{
-		FCollisionObjectQueryParams ObjectQueryParams;
-		ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
-		ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-
-		AActor* MyOwner = GetOwner();
-
-		FVector EyeLocation;
-		FRotator EyeRotation;
-		MyOwner->GetActorEyesViewPoint(EyeLocation, EyeRotation);
-
-		const FVector End = EyeLocation + (EyeRotation.Vector() * InteractDistance);
-		TArray<FHitResult> Hits;
-
-		const float Radius = 30.0f;
-		FCollisionShape Shape;
-		Shape.SetSphere(Radius);
-		const bool bBlockinghit = GetWorld()->SweepMultiByObjectType(Hits, EyeLocation, End, FQuat::Identity, ObjectQueryParams, Shape);
-
-		//const FColor LineColor = bBlockinghit ? FColor::Green : FColor::Red;
-		for (const FHitResult& Hit : Hits)
-		{
-			CurrentLookAtActor = Hit.GetActor();
-		}
-	}
-
+	const UUMLookAtSubsystem* LookAt = GetWorld() ? GetWorld()->GetSubsystem<UUMLookAtSubsystem>() : nullptr;
+	return LookAt ? LookAt->GetFocus(this) : nullptr;
 }
 
 void AUnmaskCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -53,22 +53,24 @@ protected:
 	UPROPERTY(VisibleAnywhere)
 	UUMInteractionComponent* InteractionComp;
 
-	/** Mouse Look Input Action */
+	/** How far ahead of the camera the look-at subsystem searches for a focus */
 	UPROPERTY(EditAnywhere)
 	float InteractDistance = 200.f;
 	
 public:
 	AUnmaskCharacter();
 
-	void Tick(float DeltaSeconds) override;
-	
-	/** Set if we should skip the look at trace on tick for this frame. */
+	/** Suspend the look-at trace, clearing the current focus, until called again with false. */
 	UFUNCTION(BlueprintCallable)
 	virtual void SetSkipLookAtTraceThisFrame(bool bShouldSkip) { bSkipLookTrace = bShouldSkip; }
 
-	/** Set if we should skip the look at trace on tick for this frame. */
+	bool ShouldSkipLookAtTrace() const { return bSkipLookTrace; }
+
+	float GetInteractDistance() const { return InteractDistance; }
+
+	/** Actor this character is focused on, as last found by UUMLookAtSubsystem; local players only. */
 	UFUNCTION(BlueprintCallable)
-	AActor* GetCurrentLookAtActor() const { return CurrentLookAtActor.Get(); }
+	AActor* GetCurrentLookAtActor() const;
 
 protected:
 
@@ -112,6 +114,5 @@ public:
 
 private:
 	bool bSkipLookTrace = false;
-	TWeakObjectPtr<AActor> CurrentLookAtActor;
 };
 
@@ -117,7 +117,14 @@ FVector AShooterNPC::GetWeaponTargetLocation()
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
 
-	GetWorld()->LineTraceSingleByChannel(OutHit, AimSource, AimTarget, ECC_Visibility, QueryParams);
+	if (UUMTraceQueryService* TraceService = GetWorld()->GetSubsystem<UUMTraceQueryService>())
+	{
+		OutHit = TraceService->LineTraceTolerant(EUMTraceQuery::NPCAim, this, AimSource, AimTarget, ECC_Visibility, QueryParams, AimTraceTolerance);
+	}
+	else if (!GetWorld()->LineTraceSingleByChannel(OutHit, AimSource, AimTarget, ECC_Visibility, QueryParams))
+	{
+		OutHit = FHitResult(AimSource, AimTarget);
+	}
 
 	// return either the impact point or the trace end
 	return OutHit.bBlockingHit ? OutHit.ImpactPoint : OutHit.TraceEnd;
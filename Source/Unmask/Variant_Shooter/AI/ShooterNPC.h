@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UnmaskCharacter.h"
 #include "ShooterWeaponHolder.h"
+#include "UMTraceQueryService.h"
 #include "ShooterNPC.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPawnDeathDelegate);
@@ -64,6 +65,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Aim")
 	float AimVarianceHalfAngle = 10.0f;
 
+	/**
+	 *  How far a shot may stray from the last async aim trace and still reuse its hit distance. Kept well
+	 *  inside AimVarianceHalfAngle: one degree is about 17 cm of error at 1000 cm, so the spread survives
+	 */
+	UPROPERTY(EditAnywhere, Category="Aim")
+	FUMTraceTolerance AimTraceTolerance = FUMTraceTolerance(10.0f, 1.0f, 0.2f);
+
 	/** Minimum vertical offset from the target center to apply when aiming */
 	UPROPERTY(EditAnywhere, Category="Aim")
 	float MinAimOffsetZ = -35.0f;
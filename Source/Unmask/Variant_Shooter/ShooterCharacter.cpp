@@ -170,7 +170,15 @@ FVector AShooterCharacter::GetWeaponTargetLocation()
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
 
-	GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
+	// a steady aim reuses last frame's async trace; a moving one traces now
+	if (UUMTraceQueryService* TraceService = GetWorld()->GetSubsystem<UUMTraceQueryService>())
+	{
+		OutHit = TraceService->LineTraceTolerant(EUMTraceQuery::PlayerAim, this, Start, End, ECC_Visibility, QueryParams, AimTraceTolerance);
+	}
+	else if (!GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams))
+	{
+		OutHit = FHitResult(Start, End);
+	}
 
 	// return either the impact point or the trace end
 	return OutHit.bBlockingHit ? OutHit.ImpactPoint : OutHit.TraceEnd;
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UnmaskCharacter.h"
 #include "ShooterWeaponHolder.h"
+#include "UMTraceQueryService.h"
 #include "ShooterCharacter.generated.h"
 
 class AShooterWeapon;
@@ -51,6 +52,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category ="Aim", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
 	float MaxAimDistance = 10000.0f;
 
+	/** How far the view may drift from the last async aim trace before a shot traces synchronously; 0.05 degrees is about 9 cm at MaxAimDistance */
+	UPROPERTY(EditAnywhere, Category ="Aim")
+	FUMTraceTolerance AimTraceTolerance = FUMTraceTolerance(2.0f, 0.05f, 0.1f);
+
 	/** Max HP this character can have */
 	UPROPERTY(EditAnywhere, Category="Health")
 	float MaxHP = 500.0f;